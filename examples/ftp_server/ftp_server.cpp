@@ -10,11 +10,15 @@
 #include <mavsdk/mavsdk.h>
 #include <mavsdk/plugins/ftp/ftp.h>
 
+#include <atomic>
 #include <chrono>
+#include <filesystem>
+#include <future>
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <thread>
+#include <vector>
 
 #define ERROR_CONSOLE_TEXT "\033[31m" // Turn text on console red
 #define NORMAL_CONSOLE_TEXT "\033[0m" // Restore normal console colour
@@ -27,11 +31,134 @@ void usage(const std::string& bin_name)
         << NORMAL_CONSOLE_TEXT << "Usage : " << bin_name << " <remote_ip> <remote_port> <root_dir>"
         << std::endl
         << "Start mavlink FTP server on <root_dir> sending heartbeats to <remote_ip>:<remote_port>"
-        << std::endl;
+        << std::endl
+        << std::endl
+        << "Usage : " << bin_name << " stress <root_dir> <file> [<parallel>]" << std::endl
+        << "Serve <root_dir> to a client in the same process, which downloads <file> <parallel>"
+        << " times at once while listing <root_dir>, and report the throughput" << std::endl;
+}
+
+int stress(const std::string& root_dir, const std::string& file, unsigned parallel)
+{
+    constexpr int port = 14599;
+
+    Mavsdk mavsdk_server;
+    Mavsdk::Configuration configuration(Mavsdk::Configuration::UsageType::CompanionComputer);
+    mavsdk_server.set_configuration(configuration);
+    if (mavsdk_server.setup_udp_remote("127.0.0.1", port) != ConnectionResult::Success) {
+        std::cout << ERROR_CONSOLE_TEXT << "Error setting up Mavlink FTP server." << std::endl;
+        return 1;
+    }
+    auto ftp_server = std::make_shared<Ftp>(mavsdk_server.systems().at(0));
+    ftp_server->set_root_directory(root_dir);
+
+    Mavsdk mavsdk_client;
+    auto prom = std::make_shared<std::promise<void>>();
+    auto future_result = prom->get_future();
+    // The callback can fire again while connecting, but the promise can only be set once.
+    auto connected = std::make_shared<bool>(false);
+    mavsdk_client.subscribe_on_new_system([&mavsdk_client, prom, connected]() {
+        if (!*connected && mavsdk_client.systems().at(0)->is_connected()) {
+            *connected = true;
+            prom->set_value();
+        }
+    });
+    if (mavsdk_client.add_udp_connection(port) != ConnectionResult::Success ||
+        future_result.wait_for(std::chrono::seconds(5)) == std::future_status::timeout) {
+        std::cout << ERROR_CONSOLE_TEXT << "Client could not connect to the server."
+                  << NORMAL_CONSOLE_TEXT << std::endl;
+        return 1;
+    }
+    mavsdk_client.subscribe_on_new_system(nullptr);
+
+    auto ftp_client = std::make_shared<Ftp>(mavsdk_client.systems().at(0));
+    ftp_client->set_target_compid(ftp_server->get_our_compid());
+
+    const auto local_dir = std::filesystem::temp_directory_path() / "mavsdk_ftp_stress";
+    // Only written from the callbacks, and read once all downloads are done.
+    std::vector<uint32_t> bytes_downloaded(parallel, 0);
+    std::atomic<unsigned> downloads_running{parallel};
+    std::atomic<unsigned> failures{0};
+    std::vector<std::promise<void>> downloads_done(parallel);
+    std::vector<std::future<void>> downloads_done_futures;
+    for (auto& done : downloads_done) {
+        downloads_done_futures.push_back(done.get_future());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; i < parallel; ++i) {
+        // Every download needs its own folder, as they all write a file with the same name.
+        const auto folder = local_dir / std::to_string(i);
+        std::filesystem::create_directories(folder);
+
+        ftp_client->download_async(
+            file,
+            folder.string(),
+            [&, i](Ftp::Result result, Ftp::ProgressData progress) {
+                if (result == Ftp::Result::Next) {
+                    bytes_downloaded[i] = progress.bytes_transferred;
+                    return;
+                }
+                if (result != Ftp::Result::Success) {
+                    std::cout << ERROR_CONSOLE_TEXT << "Download " << i << " failed: " << result
+                              << NORMAL_CONSOLE_TEXT << std::endl;
+                    ++failures;
+                }
+                --downloads_running;
+                downloads_done[i].set_value();
+            });
+    }
+
+    // Directory listings go on in between, they must not have to wait for the downloads.
+    unsigned listings = 0;
+    while (downloads_running > 0) {
+        auto list_prom = std::make_shared<std::promise<Ftp::Result>>();
+        auto list_future = list_prom->get_future();
+        ftp_client->list_directory_async(
+            "/", [list_prom](Ftp::Result result, std::vector<std::string>) {
+                list_prom->set_value(result);
+            });
+        const auto result = list_future.get();
+        if (result != Ftp::Result::Success) {
+            std::cout << ERROR_CONSOLE_TEXT << "Listing failed: " << result << NORMAL_CONSOLE_TEXT
+                      << std::endl;
+            ++failures;
+            break;
+        }
+        ++listings;
+    }
+
+    for (auto& done_future : downloads_done_futures) {
+        done_future.wait();
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t total_bytes = 0;
+    for (const auto bytes : bytes_downloaded) {
+        total_bytes += bytes;
+    }
+    std::filesystem::remove_all(local_dir);
+
+    std::cout << NORMAL_CONSOLE_TEXT << "Downloads:    " << parallel << std::endl
+              << "Listings:     " << listings << std::endl
+              << "Failures:     " << failures << std::endl
+              << "Bytes:        " << total_bytes << std::endl
+              << "Elapsed:      " << std::fixed << std::setprecision(2) << elapsed.count()
+              << " s" << std::endl
+              << "Throughput:   " << std::setprecision(1)
+              << static_cast<double>(total_bytes) / 1024.0 / elapsed.count() << " KiB/s"
+              << std::endl;
+
+    return failures > 0 ? 1 : 0;
 }
 
 int main(int argc, char** argv)
 {
+    if (argc >= 4 && std::string(argv[1]) == "stress") {
+        return stress(argv[2], argv[3], argc >= 5 ? std::stoi(argv[4]) : 3);
+    }
+
     if (argc != 4) {
         usage(argv[0]);
         return 1;
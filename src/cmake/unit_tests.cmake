@@ -19,6 +19,9 @@ target_link_libraries(unit_tests_runner
     mavsdk_camera
     mavsdk_calibration
     mavsdk_telemetry
+    mavsdk_ftp
+    mavsdk_mavlink_passthrough
+    mavsdk_param
     CURL::libcurl
     JsonCpp::jsoncpp
     gtest
@@ -27,3 +30,22 @@ target_link_libraries(unit_tests_runner
 )
 
 add_test(unit_tests unit_tests_runner)
+
+# Replaces the global operator new to count allocations, so it can't share an
+# executable with the other tests.
+add_executable(allocation_tests_runner
+    ${PROJECT_SOURCE_DIR}/core/allocation_test.cpp
+)
+
+set_target_properties(allocation_tests_runner
+    PROPERTIES COMPILE_FLAGS ${warnings}
+)
+
+target_link_libraries(allocation_tests_runner
+    mavsdk
+    mavsdk_telemetry
+    gtest
+    gtest_main
+)
+
+add_test(allocation_tests allocation_tests_runner)
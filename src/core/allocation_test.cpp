@@ -0,0 +1,248 @@
+#include "callback_executor.h"
+#include "callback_list.h"
+#include "mavsdk_impl.h"
+#include "seqlock.h"
+#include "user_callback_queue.h"
+#include "plugins/telemetry/telemetry.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+// This replaces the global operator new, which is why it's built into a test
+// executable of its own, rather than into unit_tests_runner.
+
+using namespace mavsdk;
+
+namespace {
+
+// Allocations are only counted on the threads which asked for it, so that
+// anything else running meanwhile doesn't interfere. Only where nothing else
+// is running, they can be counted on all threads.
+thread_local bool counting_allocations = false;
+std::atomic<bool> counting_allocations_everywhere{false};
+std::atomic<int> allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (counting_allocations || counting_allocations_everywhere) {
+        ++allocations;
+    }
+    void* ptr = std::malloc(size != 0 ? size : 1);
+    if (ptr == nullptr) {
+        // We're built without exceptions, so we can't throw std::bad_alloc.
+        std::abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(Allocation, UpdateToSubscriberDoesNotAllocate)
+{
+    // The path of an update, from the decoded message to the subscriber, the same
+    // as TelemetryImpl and SystemImpl take it, apart from the callback thread.
+    using ActuatorControlTarget = Telemetry::ActuatorControlTarget;
+
+    Seqlock<ActuatorControlTarget> seqlock;
+    CallbackList<ActuatorControlTarget> callbacks;
+    UserCallbackQueue queue{64};
+
+    ActuatorControlTarget received{};
+    callbacks.subscribe(
+        [&received](ActuatorControlTarget target) { received = target; }, QueuePolicy::DropNewest);
+
+    const CallbackQueueFunc queue_func =
+        [&queue](
+            UserCallbackQueue::Func func,
+            const std::shared_ptr<UserCallbackQueue::Subscription>& subscription) {
+            queue.push(UserCallbackQueue::UserCallback{std::move(func), __FILE__, __LINE__},
+                subscription);
+        };
+
+    allocations = 0;
+    counting_allocations = true;
+
+    ActuatorControlTarget target{};
+    target.group = 2;
+    for (unsigned i = 0; i < target.controls.capacity(); ++i) {
+        target.controls.push_back(static_cast<float>(i));
+    }
+    seqlock.store(target);
+
+    callbacks.queue(queue_func, seqlock.load());
+
+    UserCallbackQueue::UserCallback callback;
+    const bool popped = queue.pop(callback);
+    if (popped) {
+        callback.func();
+    }
+    callback = UserCallbackQueue::UserCallback{};
+
+    counting_allocations = false;
+
+    ASSERT_TRUE(popped);
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_EQ(received, target);
+}
+
+namespace {
+
+Telemetry::Odometry make_odometry(unsigned i)
+{
+    Telemetry::Odometry odometry{};
+    odometry.time_usec = i;
+    for (auto* covariance : {&odometry.pose_covariance, &odometry.velocity_covariance}) {
+        for (unsigned j = 0; j < covariance->covariance_matrix.capacity(); ++j) {
+            covariance->covariance_matrix.push_back(static_cast<float>(i + j));
+        }
+    }
+    return odometry;
+}
+
+Telemetry::ActuatorOutputStatus make_actuator_output_status(unsigned i)
+{
+    Telemetry::ActuatorOutputStatus status{};
+    status.active = i;
+    for (unsigned j = 0; j < status.actuator.capacity(); ++j) {
+        status.actuator.push_back(static_cast<float>(i + j));
+    }
+    return status;
+}
+
+// Runs a callback on the thread calling the user callbacks, and waits for it.
+void run_on_callback_thread(MavsdkImpl& mavsdk_impl, void (*func)())
+{
+    std::atomic<bool> done{false};
+    mavsdk_impl.call_user_callback_located(__FILE__, __LINE__, [func, &done]() {
+        func();
+        done = true;
+    });
+    while (!done) {
+        std::this_thread::yield();
+    }
+}
+
+void wait_for(const std::atomic<unsigned>& value, unsigned expected)
+{
+    while (value < expected) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+TEST(Allocation, UpdatesThroughMavsdkCallbacksDoNotAllocate)
+{
+    // The biggest updates there are, which are called back the same way as the
+    // plugins do it, by the threads of MavsdkImpl.
+    MavsdkImpl mavsdk_impl;
+    CallbackList<Telemetry::Odometry> odometry_callbacks;
+    CallbackList<Telemetry::ActuatorOutputStatus> actuator_output_status_callbacks;
+
+    std::atomic<unsigned> received{0};
+    Telemetry::Odometry odometry_received{};
+    Telemetry::ActuatorOutputStatus actuator_output_status_received{};
+    odometry_callbacks.subscribe(
+        [&](Telemetry::Odometry odometry) {
+            odometry_received = odometry;
+            ++received;
+        },
+        QueuePolicy::LatestValue);
+    actuator_output_status_callbacks.subscribe(
+        [&](Telemetry::ActuatorOutputStatus status) {
+            actuator_output_status_received = status;
+            ++received;
+        },
+        QueuePolicy::DropNewest);
+
+    const CallbackQueueFunc queue_func =
+        [&mavsdk_impl](
+            UserCallbackQueue::Func func,
+            const std::shared_ptr<UserCallbackQueue::Subscription>& subscription) {
+            mavsdk_impl.call_user_callback_located(
+                __FILE__, __LINE__, std::move(func), subscription);
+        };
+
+    // The first callback sets up what the thread needs to time callbacks.
+    odometry_callbacks.queue(queue_func, make_odometry(0));
+    actuator_output_status_callbacks.queue(queue_func, make_actuator_output_status(0));
+    wait_for(received, 2);
+
+    allocations = 0;
+    run_on_callback_thread(mavsdk_impl, []() { counting_allocations = true; });
+    counting_allocations = true;
+
+    for (unsigned i = 1; i <= 10; ++i) {
+        odometry_callbacks.queue(queue_func, make_odometry(i));
+        actuator_output_status_callbacks.queue(queue_func, make_actuator_output_status(i));
+        wait_for(received, 2 + 2 * i);
+    }
+
+    counting_allocations = false;
+    // Only once this has run, the callbacks before are done.
+    run_on_callback_thread(mavsdk_impl, []() { counting_allocations = false; });
+
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_EQ(odometry_received, make_odometry(10));
+    EXPECT_EQ(actuator_output_status_received, make_actuator_output_status(10));
+}
+
+TEST(Allocation, CallbacksOnSeveralThreadsDoNotAllocate)
+{
+    // With more than one thread, callbacks go through the strands of their subscription.
+    UserCallbackQueue queue{64};
+    CallbackExecutor executor(
+        queue, [](UserCallbackQueue::UserCallback& callback) { callback.func(); });
+    executor.start(2);
+
+    std::vector<std::shared_ptr<UserCallbackQueue::Subscription>> subscriptions;
+    for (const auto policy :
+         {UserCallbackQueue::OverflowPolicy::DropNewest,
+          UserCallbackQueue::OverflowPolicy::DropOldest,
+          UserCallbackQueue::OverflowPolicy::CoalesceLatest}) {
+        subscriptions.push_back(UserCallbackQueue::make_subscription(policy));
+    }
+
+    std::atomic<unsigned> called{0};
+    const auto push_round = [&]() {
+        for (const auto& subscription : subscriptions) {
+            queue.push(UserCallbackQueue::UserCallback{[&called]() { ++called; }}, subscription);
+        }
+    };
+
+    // Strands are only made the first time they are needed.
+    push_round();
+    wait_for(called, 3);
+
+    // Nothing else is running, so the threads of the executor are counted as well.
+    allocations = 0;
+    counting_allocations_everywhere = true;
+
+    for (unsigned i = 1; i <= 10; ++i) {
+        push_round();
+        wait_for(called, 3 + 3 * i);
+    }
+    // The strands are put back once the callbacks have run.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    counting_allocations_everywhere = false;
+    executor.stop();
+
+    EXPECT_EQ(allocations.load(), 0);
+}
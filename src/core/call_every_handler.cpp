@@ -1,5 +1,7 @@
 #include "call_every_handler.h"
 
+#include <algorithm>
+
 namespace mavsdk {
 
 CallEveryHandler::CallEveryHandler(Time& time) : _time(time) {}
@@ -19,23 +21,37 @@ void CallEveryHandler::add(std::function<void()> callback, double interval_s, vo
 
     void* new_cookie = static_cast<void*>(new_entry.get());
 
+    bool earliest = false;
     {
         std::lock_guard<std::mutex> lock(_entries_mutex);
         _entries.insert(std::pair<void*, std::shared_ptr<Entry>>(new_cookie, new_entry));
+        earliest = schedule(new_cookie, *new_entry);
     }
 
     if (cookie != nullptr) {
         *cookie = new_cookie;
     }
+
+    if (earliest) {
+        wakeup();
+    }
 }
 
 void CallEveryHandler::change(double interval_s, const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_entries_mutex);
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        it->second->interval_s = interval_s;
+        auto it = _entries.find(const_cast<void*>(cookie));
+        if (it != _entries.end()) {
+            it->second->interval_s = interval_s;
+            earliest = schedule(it->first, *it->second);
+        }
+    }
+
+    if (earliest) {
+        wakeup();
     }
 }
 
@@ -46,6 +62,8 @@ void CallEveryHandler::reset(const void* cookie)
     auto it = _entries.find(const_cast<void*>(cookie));
     if (it != _entries.end()) {
         it->second->last_time = _time.steady_time();
+        // This can only move the next call later, so no need to wake anyone up.
+        schedule(it->first, *it->second);
     }
 }
 
@@ -53,40 +71,117 @@ void CallEveryHandler::remove(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        _entries.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
-    }
+    _entries.erase(const_cast<void*>(cookie));
 }
 
 void CallEveryHandler::run_once()
 {
-    _entries_mutex.lock();
+    std::unique_lock<std::mutex> lock(_entries_mutex);
 
-    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
-        if (_time.elapsed_since_s(it->second->last_time) > double(it->second->interval_s)) {
-            _time.shift_steady_time_by(it->second->last_time, double(it->second->interval_s));
+    dl_time_t now = _time.steady_time();
 
-            if (it->second->callback) {
-                // Get a copy for the callback because we unlock.
-                std::function<void()> callback = it->second->callback;
+    // Entries are called at most once per run, even if they are late by more
+    // than one interval, so we only put them back into the heap at the end.
+    std::vector<void*> called;
 
-                // Unlock while we callback because it might in turn want to add timeouts.
-                _entries_mutex.unlock();
-                callback();
-                _entries_mutex.lock();
-            }
+    while (!_heap.empty() && _heap.front().time < now) {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+        const Scheduled due = _heap.back();
+        _heap.pop_back();
+
+        if (!is_current(due)) {
+            continue;
+        }
+
+        auto& entry = *_entries.at(due.cookie);
+        _time.shift_steady_time_by(entry.last_time, entry.interval_s);
+        // Not scheduled until we are done.
+        entry.schedule_id = 0;
+        called.push_back(due.cookie);
+
+        if (entry.callback) {
+            // Get a copy for the callback because we unlock.
+            std::function<void()> callback = entry.callback;
+
+            // Unlock while we callback because it might in turn want to add timeouts.
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+
+    for (void* cookie : called) {
+        auto it = _entries.find(cookie);
+        // It might have been removed, or changed which schedules it again.
+        if (it != _entries.end() && it->second->schedule_id == 0) {
+            schedule(it->first, *it->second);
         }
+    }
+}
+
+dl_time_t CallEveryHandler::next_deadline()
+{
+    std::lock_guard<std::mutex> lock(_entries_mutex);
+
+    drop_stale_entries();
+
+    return _heap.empty() ? dl_time_t::max() : _heap.front().time;
+}
+
+void CallEveryHandler::set_wakeup_callback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    _wakeup_callback = callback;
+}
 
-        // We leave the loop.
-        // FIXME: there should be a nicer way to do this.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            break;
+bool CallEveryHandler::schedule(void* cookie, Entry& entry)
+{
+    // Needs to be called with _entries_mutex locked.
+    entry.schedule_id = _next_schedule_id++;
+
+    dl_time_t next_time = entry.last_time;
+    _time.shift_steady_time_by(next_time, entry.interval_s);
+
+    // Changes leave stale entries behind, so once in a while we rebuild.
+    if (_heap.size() > 2 * _entries.size() + 16) {
+        _heap.clear();
+        for (const auto& other : _entries) {
+            if (other.second->schedule_id == 0) {
+                continue;
+            }
+            dl_time_t other_next_time = other.second->last_time;
+            _time.shift_steady_time_by(other_next_time, other.second->interval_s);
+            _heap.push_back({other_next_time, other.first, other.second->schedule_id});
         }
+        std::make_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+    } else {
+        _heap.push_back({next_time, cookie, entry.schedule_id});
+        std::push_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+    }
+
+    return _heap.front().schedule_id == entry.schedule_id;
+}
+
+bool CallEveryHandler::is_current(const Scheduled& scheduled) const
+{
+    auto it = _entries.find(scheduled.cookie);
+    return it != _entries.end() && it->second->schedule_id == scheduled.schedule_id;
+}
+
+void CallEveryHandler::drop_stale_entries()
+{
+    while (!_heap.empty() && !is_current(_heap.front())) {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+        _heap.pop_back();
+    }
+}
+
+void CallEveryHandler::wakeup()
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    if (_wakeup_callback) {
+        _wakeup_callback();
     }
-    _entries_mutex.unlock();
 }
 
 } // namespace mavsdk
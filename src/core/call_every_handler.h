@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <mutex>
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 #include "global_include.h"
 
 namespace mavsdk {
@@ -26,16 +28,45 @@ public:
 
     void run_once();
 
+    // Time at which run_once next has something to do, dl_time_t::max() if
+    // there is nothing scheduled.
+    dl_time_t next_deadline();
+
+    // Called (without any lock held) whenever the next deadline moves
+    // earlier, so that a thread waiting for it can wake up.
+    void set_wakeup_callback(std::function<void()> callback);
+
 private:
     struct Entry {
         std::function<void()> callback{nullptr};
         dl_time_t last_time{};
         double interval_s{0.0f};
+        uint64_t schedule_id{0};
     };
 
+    // Entries in the heap are not removed when an entry is changed or
+    // removed. They are skipped once they come up instead, when they no
+    // longer match the schedule_id of the entry.
+    struct Scheduled {
+        dl_time_t time;
+        void* cookie;
+        uint64_t schedule_id;
+
+        bool operator>(const Scheduled& other) const { return time > other.time; }
+    };
+
+    bool schedule(void* cookie, Entry& entry);
+    bool is_current(const Scheduled& scheduled) const;
+    void drop_stale_entries();
+    void wakeup();
+
     std::unordered_map<void*, std::shared_ptr<Entry>> _entries{};
+    std::vector<Scheduled> _heap{};
+    uint64_t _next_schedule_id{1};
     std::mutex _entries_mutex{};
-    bool _iterator_invalidated{false};
+
+    std::mutex _wakeup_callback_mutex{};
+    std::function<void()> _wakeup_callback{nullptr};
 
     Time& _time;
 };
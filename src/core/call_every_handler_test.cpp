@@ -144,3 +144,32 @@ TEST(CallEveryHandler, CallImmediately)
     }
     EXPECT_EQ(num_called, 1);
 }
+
+TEST(CallEveryHandler, NextDeadline)
+{
+    Time time{};
+    CallEveryHandler ceh(time);
+
+    unsigned wakeups = 0;
+    ceh.set_wakeup_callback([&wakeups]() { ++wakeups; });
+
+    EXPECT_EQ(ceh.next_deadline(), dl_time_t::max());
+
+    void* cookie = nullptr;
+    ceh.add([]() {}, 0.1, &cookie);
+    EXPECT_EQ(wakeups, 1);
+
+    // It is due straightaway.
+    EXPECT_LT(ceh.next_deadline(), time.steady_time());
+    ceh.run_once();
+
+    const auto deadline = ceh.next_deadline();
+    EXPECT_GT(deadline, time.steady_time());
+
+    ceh.change(0.05, cookie);
+    EXPECT_EQ(wakeups, 2);
+    EXPECT_LT(ceh.next_deadline(), deadline);
+
+    ceh.remove(cookie);
+    EXPECT_EQ(ceh.next_deadline(), dl_time_t::max());
+}
@@ -0,0 +1,228 @@
+#include "callback_executor.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+void CallbackStrand::push_back(UserCallbackQueue::UserCallback callback)
+{
+    if (count == callbacks.size()) {
+        // Only grows when the strand falls further behind than ever before.
+        std::vector<UserCallbackQueue::UserCallback> grown(std::max<size_t>(4, 2 * count));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move(callbacks[(first + i) % callbacks.size()]);
+        }
+        callbacks = std::move(grown);
+        first = 0;
+    }
+    callbacks[(first + count) % callbacks.size()] = std::move(callback);
+    ++count;
+}
+
+void CallbackStrand::pop_front()
+{
+    callbacks[first] = UserCallbackQueue::UserCallback{};
+    first = (first + 1) % callbacks.size();
+    --count;
+}
+
+CallbackExecutor::CallbackExecutor(UserCallbackQueue& queue, Runner runner) :
+    _queue(queue),
+    _runner(std::move(runner)),
+    _max_callbacks_per_strand(queue.capacity())
+{}
+
+CallbackExecutor::~CallbackExecutor()
+{
+    stop();
+}
+
+void CallbackExecutor::start(unsigned num_threads)
+{
+    // With only one thread, the dispatch thread calls the callbacks itself.
+    if (num_threads > 1) {
+        for (unsigned i = 0; i < num_threads; ++i) {
+            _worker_threads.push_back(new std::thread(&CallbackExecutor::worker_thread, this));
+        }
+    }
+
+    _dispatch_thread = new std::thread(&CallbackExecutor::dispatch_thread, this);
+}
+
+void CallbackExecutor::stop()
+{
+    if (_dispatch_thread != nullptr) {
+        _queue.stop();
+        _dispatch_thread->join();
+        delete _dispatch_thread;
+        _dispatch_thread = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = true;
+    }
+    _cv.notify_all();
+
+    for (auto worker_thread : _worker_threads) {
+        worker_thread->join();
+        delete worker_thread;
+    }
+    _worker_threads.clear();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _first_ready = nullptr;
+    _last_ready = nullptr;
+    _strand_without_subscription = nullptr;
+    for (const auto& strand : _strands) {
+        if (strand->subscription) {
+            strand->subscription->_strand = nullptr;
+        }
+    }
+    _idle_strands.clear();
+    _strands.clear();
+}
+
+UserCallbackQueue::Stats CallbackExecutor::stats() const
+{
+    UserCallbackQueue::Stats stats;
+    stats.dropped_newest = _dropped_newest;
+    stats.dropped_oldest = _dropped_oldest;
+    stats.coalesced = _coalesced;
+    return stats;
+}
+
+void CallbackExecutor::dispatch_thread()
+{
+    UserCallbackQueue::UserCallback callback;
+    std::shared_ptr<UserCallbackQueue::Subscription> subscription;
+
+    while (_queue.pop(callback, subscription)) {
+        if (_worker_threads.empty()) {
+            _runner(callback);
+        } else {
+            dispatch(callback, subscription);
+        }
+        subscription.reset();
+    }
+}
+
+void CallbackExecutor::dispatch(
+    UserCallbackQueue::UserCallback& callback,
+    std::shared_ptr<UserCallbackQueue::Subscription>& subscription)
+{
+    const auto policy =
+        subscription ? subscription->policy : UserCallbackQueue::OverflowPolicy::DropNewest;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto& strand = strand_of(subscription.get());
+    if (strand == nullptr) {
+        strand = take_idle_strand();
+        strand->subscription = subscription;
+        strand->push_back(std::move(callback));
+        push_ready(strand);
+        lock.unlock();
+        _cv.notify_one();
+        return;
+    }
+
+    // The strand is either waiting or running already, in which case the worker
+    // running it picks up the new callback once it's done.
+    //
+    // A strand can only fall behind so far. Otherwise, a slow one would use up
+    // memory without bounds, while the queue in front of it never runs full.
+    if (policy == UserCallbackQueue::OverflowPolicy::CoalesceLatest && strand->count > 0) {
+        strand->back() = std::move(callback);
+        ++_coalesced;
+        ++subscription->_coalesced;
+        return;
+    }
+
+    if (strand->count >= _max_callbacks_per_strand) {
+        if (policy == UserCallbackQueue::OverflowPolicy::DropOldest) {
+            strand->pop_front();
+            ++_dropped_oldest;
+        } else {
+            ++_dropped_newest;
+            return;
+        }
+    }
+
+    strand->push_back(std::move(callback));
+}
+
+void CallbackExecutor::worker_thread()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _cv.wait(lock, [this]() { return _first_ready != nullptr || _should_exit; });
+        if (_should_exit) {
+            break;
+        }
+
+        auto strand = pop_ready();
+
+        auto callback = std::move(strand->front());
+        strand->pop_front();
+
+        lock.unlock();
+        _runner(callback);
+        callback = UserCallbackQueue::UserCallback{};
+        lock.lock();
+
+        // Only one callback at a time so that busy strands take turns.
+        if (strand->count > 0) {
+            push_ready(strand);
+            continue;
+        }
+
+        strand_of(strand->subscription.get()) = nullptr;
+        strand->subscription.reset();
+        _idle_strands.push_back(strand);
+    }
+}
+
+CallbackStrand*& CallbackExecutor::strand_of(UserCallbackQueue::Subscription* subscription)
+{
+    return subscription ? subscription->_strand : _strand_without_subscription;
+}
+
+CallbackStrand* CallbackExecutor::take_idle_strand()
+{
+    if (_idle_strands.empty()) {
+        _strands.push_back(std::make_unique<CallbackStrand>());
+        // So that a strand can always be put back without allocating.
+        _idle_strands.reserve(_strands.size());
+        return _strands.back().get();
+    }
+
+    auto strand = _idle_strands.back();
+    _idle_strands.pop_back();
+    return strand;
+}
+
+void CallbackExecutor::push_ready(CallbackStrand* strand)
+{
+    strand->next_ready = nullptr;
+    if (_last_ready == nullptr) {
+        _first_ready = strand;
+    } else {
+        _last_ready->next_ready = strand;
+    }
+    _last_ready = strand;
+}
+
+CallbackStrand* CallbackExecutor::pop_ready()
+{
+    auto strand = _first_ready;
+    _first_ready = strand->next_ready;
+    if (_first_ready == nullptr) {
+        _last_ready = nullptr;
+    }
+    strand->next_ready = nullptr;
+    return strand;
+}
+
+} // namespace mavsdk
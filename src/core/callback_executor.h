@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "user_callback_queue.h"
+
+namespace mavsdk {
+
+// Callbacks of one subscription which are waiting in a CallbackExecutor, or of which
+// one is running.
+//
+// Strands are reused once they're done, and so is the space for their callbacks,
+// which only grows if a strand falls further behind than it did before.
+struct CallbackStrand {
+    // Keeps the subscription alive while its callbacks are waiting.
+    std::shared_ptr<UserCallbackQueue::Subscription> subscription{};
+    // Ring buffer of the callbacks waiting.
+    std::vector<UserCallbackQueue::UserCallback> callbacks{};
+    size_t first{0};
+    size_t count{0};
+    // The next one in the list of strands which are ready to run.
+    CallbackStrand* next_ready{nullptr};
+
+    UserCallbackQueue::UserCallback& front() { return callbacks[first]; }
+    UserCallbackQueue::UserCallback& back()
+    {
+        return callbacks[(first + count - 1) % callbacks.size()];
+    }
+    void push_back(UserCallbackQueue::UserCallback callback);
+    void pop_front();
+};
+
+// Calls the callbacks taken out of a UserCallbackQueue using a pool of threads.
+//
+// The callbacks of one subscription form a strand: they are called one after
+// the other in the order they were pushed, while callbacks of different
+// strands can run in parallel. This way, a slow callback only holds up its
+// own strand. Callbacks pushed without a subscription share one strand.
+//
+// With only one thread, all callbacks are called one after the other on the
+// thread taking them out of the queue.
+class CallbackExecutor {
+public:
+    // Called to actually run a callback, e.g. to time it.
+    using Runner = std::function<void(UserCallbackQueue::UserCallback&)>;
+
+    CallbackExecutor(UserCallbackQueue& queue, Runner runner);
+    ~CallbackExecutor();
+
+    void start(unsigned num_threads);
+    void stop();
+
+    // Callbacks dropped or coalesced because a strand got too far behind.
+    UserCallbackQueue::Stats stats() const;
+
+    // Non-copyable
+    CallbackExecutor(const CallbackExecutor&) = delete;
+    const CallbackExecutor& operator=(const CallbackExecutor&) = delete;
+
+private:
+    void dispatch_thread();
+    void worker_thread();
+    void dispatch(
+        UserCallbackQueue::UserCallback& callback,
+        std::shared_ptr<UserCallbackQueue::Subscription>& subscription);
+
+    // The strand of a subscription, which is nullptr while it has no callbacks.
+    CallbackStrand*& strand_of(UserCallbackQueue::Subscription* subscription);
+    CallbackStrand* take_idle_strand();
+    void push_ready(CallbackStrand* strand);
+    CallbackStrand* pop_ready();
+
+    UserCallbackQueue& _queue;
+    Runner _runner;
+    const size_t _max_callbacks_per_strand;
+
+    std::thread* _dispatch_thread{nullptr};
+    std::vector<std::thread*> _worker_threads{};
+
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    // All strands there are, busy or idle.
+    std::vector<std::unique_ptr<CallbackStrand>> _strands{};
+    // Strands without callbacks, to be reused.
+    std::vector<CallbackStrand*> _idle_strands{};
+    // The strand of the callbacks pushed without a subscription.
+    CallbackStrand* _strand_without_subscription{nullptr};
+    // Strands which have callbacks waiting but none running, oldest first.
+    CallbackStrand* _first_ready{nullptr};
+    CallbackStrand* _last_ready{nullptr};
+    bool _should_exit{false};
+
+    std::atomic<uint64_t> _dropped_newest{0};
+    std::atomic<uint64_t> _dropped_oldest{0};
+    std::atomic<uint64_t> _coalesced{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,193 @@
+#include "callback_executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+using Policy = UserCallbackQueue::OverflowPolicy;
+
+bool wait_for(const std::function<bool()>& condition)
+{
+    for (unsigned i = 0; i < 200; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+void run(UserCallbackQueue::UserCallback& callback)
+{
+    callback.func();
+}
+
+} // namespace
+
+TEST(CallbackExecutor, SingleThreadCallsInOrder)
+{
+    UserCallbackQueue queue(64);
+    CallbackExecutor executor(queue, run);
+    executor.start(1);
+
+    auto subscription = UserCallbackQueue::make_subscription(Policy::DropNewest);
+
+    std::mutex calls_mutex;
+    std::vector<int> calls;
+    for (int i = 0; i < 20; ++i) {
+        queue.push(
+            UserCallbackQueue::UserCallback{[&, i]() {
+                std::lock_guard<std::mutex> lock(calls_mutex);
+                calls.push_back(i);
+            }},
+            (i % 2 == 0) ? subscription : nullptr);
+    }
+
+    EXPECT_TRUE(wait_for([&]() {
+        std::lock_guard<std::mutex> lock(calls_mutex);
+        return calls.size() == 20;
+    }));
+    executor.stop();
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(calls[i], i);
+    }
+}
+
+TEST(CallbackExecutor, KeepsOrderWithinStrand)
+{
+    constexpr unsigned num_strands = 4;
+    constexpr unsigned num_per_strand = 1000;
+
+    UserCallbackQueue queue(64);
+    CallbackExecutor executor(queue, run);
+    executor.start(4);
+
+    std::vector<std::shared_ptr<UserCallbackQueue::Subscription>> subscriptions;
+    std::vector<unsigned> next(num_strands, 0);
+    std::vector<std::atomic<unsigned>> running(num_strands);
+    std::atomic<unsigned> out_of_order{0};
+    std::atomic<unsigned> concurrent{0};
+    std::atomic<unsigned> called{0};
+
+    for (unsigned s = 0; s < num_strands; ++s) {
+        subscriptions.push_back(UserCallbackQueue::make_subscription(Policy::DropOldest));
+    }
+
+    for (unsigned i = 0; i < num_per_strand; ++i) {
+        for (unsigned s = 0; s < num_strands; ++s) {
+            // Everything has to get through, so wait for space if needed.
+            while (queue.size() >= queue.capacity() - 1) {
+                std::this_thread::yield();
+            }
+            queue.push(
+                UserCallbackQueue::UserCallback{[&, s, i]() {
+                    if (++running[s] != 1) {
+                        ++concurrent;
+                    }
+                    if (next[s] != i) {
+                        ++out_of_order;
+                    }
+                    next[s] = i + 1;
+                    --running[s];
+                    ++called;
+                }},
+                subscriptions[s]);
+        }
+    }
+
+    EXPECT_TRUE(wait_for([&]() { return called == num_strands * num_per_strand; }));
+    executor.stop();
+
+    EXPECT_EQ(out_of_order, 0);
+    EXPECT_EQ(concurrent, 0);
+}
+
+TEST(CallbackExecutor, SlowStrandDoesNotHoldUpOthers)
+{
+    UserCallbackQueue queue(64);
+    CallbackExecutor executor(queue, run);
+    executor.start(2);
+
+    auto slow = UserCallbackQueue::make_subscription(Policy::DropNewest);
+    auto fast = UserCallbackQueue::make_subscription(Policy::DropNewest);
+
+    std::atomic<bool> release{false};
+    std::atomic<unsigned> slow_called{0};
+    std::atomic<unsigned> fast_called{0};
+
+    for (unsigned i = 0; i < 3; ++i) {
+        queue.push(
+            UserCallbackQueue::UserCallback{[&]() {
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                ++slow_called;
+            }},
+            slow);
+    }
+    for (unsigned i = 0; i < 10; ++i) {
+        queue.push(UserCallbackQueue::UserCallback{[&]() { ++fast_called; }}, fast);
+    }
+
+    EXPECT_TRUE(wait_for([&]() { return fast_called == 10; }));
+    EXPECT_EQ(slow_called, 0);
+
+    release = true;
+    EXPECT_TRUE(wait_for([&]() { return slow_called == 3; }));
+    executor.stop();
+}
+
+TEST(CallbackExecutor, CoalescesBehindSlowCallback)
+{
+    UserCallbackQueue queue(64);
+    CallbackExecutor executor(queue, run);
+    executor.start(2);
+
+    auto subscription = UserCallbackQueue::make_subscription(Policy::CoalesceLatest);
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    std::mutex calls_mutex;
+    std::vector<int> calls;
+
+    auto push = [&](int value) {
+        queue.push(
+            UserCallbackQueue::UserCallback{[&, value]() {
+                started = true;
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                std::lock_guard<std::mutex> lock(calls_mutex);
+                calls.push_back(value);
+            }},
+            subscription);
+    };
+
+    push(0);
+    EXPECT_TRUE(wait_for([&]() { return started.load(); }));
+    for (int i = 1; i <= 5; ++i) {
+        push(i);
+        EXPECT_TRUE(wait_for([&]() { return queue.size() == 0; }));
+    }
+
+    release = true;
+    EXPECT_TRUE(wait_for([&]() {
+        std::lock_guard<std::mutex> lock(calls_mutex);
+        return calls.size() == 2;
+    }));
+    executor.stop();
+
+    // Whether they are coalesced in the queue or behind the running one
+    // depends on timing.
+    EXPECT_EQ(calls, (std::vector<int>{0, 5}));
+    EXPECT_EQ(executor.stats().coalesced + queue.stats().coalesced, 4);
+    EXPECT_EQ(subscription->coalesced(), 4);
+}
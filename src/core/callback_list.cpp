@@ -0,0 +1,14 @@
+#include "callback_list.h"
+
+#include <atomic>
+
+namespace mavsdk {
+
+uint64_t next_callback_list_id()
+{
+    // 0 is left for the subscriber without handle.
+    static std::atomic<uint64_t> next_id{1};
+    return next_id++;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "handle.h"
+#include "user_callback_queue.h"
+
+namespace mavsdk {
+
+// Unique over all lists, so that the handle of one list can't unsubscribe from another one.
+uint64_t next_callback_list_id();
+
+// Queues func as a user callback, see PluginImplBase::_queue_user_callback.
+using CallbackQueueFunc = std::function<void(
+    UserCallbackQueue::Func, const std::shared_ptr<UserCallbackQueue::Subscription>&)>;
+
+// Subscribers to one stream of updates, e.g. the position.
+//
+// Every update is copied once and shared between all subscribers, each of which
+// gets it queued as a user callback using its own QueuePolicy. With only one
+// subscriber, the copy is kept in the callback itself, so that small updates
+// don't need to be allocated.
+//
+// The subscribe functions which predate handles only have one subscriber, which
+// replaces the previous one. It is set using set() and uses QueuePolicy::DropNewest.
+template<typename... Args> class CallbackList {
+public:
+    using Callback = std::function<void(Args...)>;
+
+    CallbackList() = default;
+    ~CallbackList() = default;
+
+    Handle<Args...> subscribe(const Callback& callback, QueuePolicy policy)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t id = next_callback_list_id();
+        add(id, callback, policy);
+        return Handle<Args...>(id);
+    }
+
+    // Callbacks which are queued already can still be called afterwards.
+    void unsubscribe(Handle<Args...> handle)
+    {
+        if (!handle.valid()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        remove(handle._id);
+    }
+
+    // Replaces the subscriber without handle, or removes it if the callback is nullptr.
+    void set(const Callback& callback)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        remove(0);
+        if (callback) {
+            add(0, callback, QueuePolicy::DropNewest);
+        }
+    }
+
+    // Removes all subscribers, with or without handle.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _subscribers = std::make_shared<const std::vector<Subscriber>>();
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _subscribers->empty();
+    }
+
+    void queue(const CallbackQueueFunc& queue_func, const Args&... args) const
+    {
+        std::shared_ptr<const std::vector<Subscriber>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            subscribers = _subscribers;
+        }
+
+        if (subscribers->empty()) {
+            return;
+        }
+
+        if (subscribers->size() == 1) {
+            queue_func(
+                [subscribers, values = std::tuple<Args...>(args...)]() {
+                    std::apply(subscribers->front().callback, values);
+                },
+                subscribers->front().user_callbacks);
+            return;
+        }
+
+        const auto values = std::make_shared<const std::tuple<Args...>>(args...);
+
+        for (size_t i = 0; i < subscribers->size(); ++i) {
+            queue_func(
+                [subscribers, i, values]() { std::apply((*subscribers)[i].callback, *values); },
+                (*subscribers)[i].user_callbacks);
+        }
+    }
+
+    // Non-copyable
+    CallbackList(const CallbackList&) = delete;
+    const CallbackList& operator=(const CallbackList&) = delete;
+
+private:
+    struct Subscriber {
+        uint64_t id;
+        Callback callback;
+        std::shared_ptr<UserCallbackQueue::Subscription> user_callbacks;
+    };
+
+    // The list is replaced rather than changed, so that queue() doesn't need to
+    // hold the mutex while queueing, and the queued callbacks can refer to it.
+    void add(uint64_t id, const Callback& callback, QueuePolicy policy)
+    {
+        auto subscribers = std::make_shared<std::vector<Subscriber>>(*_subscribers);
+        subscribers->push_back(Subscriber{id, callback, make_user_callbacks(policy)});
+        _subscribers = std::move(subscribers);
+    }
+
+    void remove(uint64_t id)
+    {
+        auto subscribers = std::make_shared<std::vector<Subscriber>>();
+        for (const auto& subscriber : *_subscribers) {
+            if (subscriber.id != id) {
+                subscribers->push_back(subscriber);
+            }
+        }
+        _subscribers = std::move(subscribers);
+    }
+
+    static std::shared_ptr<UserCallbackQueue::Subscription> make_user_callbacks(QueuePolicy policy)
+    {
+        switch (policy) {
+            case QueuePolicy::DropOldest:
+                return UserCallbackQueue::make_subscription(
+                    UserCallbackQueue::OverflowPolicy::DropOldest);
+            case QueuePolicy::LatestValue:
+                return UserCallbackQueue::make_subscription(
+                    UserCallbackQueue::OverflowPolicy::CoalesceLatest);
+            case QueuePolicy::DropNewest:
+            default:
+                return UserCallbackQueue::make_subscription(
+                    UserCallbackQueue::OverflowPolicy::DropNewest);
+        }
+    }
+
+    mutable std::mutex _mutex{};
+    std::shared_ptr<const std::vector<Subscriber>> _subscribers{
+        std::make_shared<const std::vector<Subscriber>>()};
+};
+
+} // namespace mavsdk
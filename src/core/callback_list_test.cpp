@@ -0,0 +1,188 @@
+#include "callback_list.h"
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+struct CopyCounter {
+    CopyCounter() = default;
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter& operator=(const CopyCounter& other) = default;
+
+    int value{0};
+    static unsigned copies;
+};
+
+unsigned CopyCounter::copies = 0;
+
+// Queues the callbacks in a queue of our own, so we can call them when we want.
+class Fixture {
+public:
+    void queue(
+        UserCallbackQueue::Func func,
+        const std::shared_ptr<UserCallbackQueue::Subscription>& subscription)
+    {
+        queue_.push(UserCallbackQueue::UserCallback{std::move(func)}, subscription);
+    }
+
+    void run_all()
+    {
+        while (queue_.size() > 0) {
+            UserCallbackQueue::UserCallback callback;
+            ASSERT_TRUE(queue_.pop(callback));
+            callback.func();
+        }
+    }
+
+    CallbackQueueFunc queue_func()
+    {
+        return [this](
+                   UserCallbackQueue::Func func,
+                   const std::shared_ptr<UserCallbackQueue::Subscription>& subscription) {
+            queue(std::move(func), subscription);
+        };
+    }
+
+    UserCallbackQueue queue_{64};
+};
+
+} // namespace
+
+TEST(CallbackList, FansOutToAllSubscribers)
+{
+    Fixture fixture;
+    CallbackList<int> list;
+    std::vector<int> first;
+    std::vector<int> second;
+
+    list.subscribe([&first](int value) { first.push_back(value); }, QueuePolicy::DropNewest);
+    list.subscribe([&second](int value) { second.push_back(value); }, QueuePolicy::DropNewest);
+
+    list.queue(fixture.queue_func(), 1);
+    list.queue(fixture.queue_func(), 2);
+    fixture.run_all();
+
+    EXPECT_EQ(first, (std::vector<int>{1, 2}));
+    EXPECT_EQ(second, (std::vector<int>{1, 2}));
+}
+
+TEST(CallbackList, Unsubscribes)
+{
+    Fixture fixture;
+    CallbackList<int> list;
+    std::vector<int> first;
+    std::vector<int> second;
+
+    auto handle =
+        list.subscribe([&first](int value) { first.push_back(value); }, QueuePolicy::DropNewest);
+    list.subscribe([&second](int value) { second.push_back(value); }, QueuePolicy::DropNewest);
+    EXPECT_TRUE(handle.valid());
+
+    list.queue(fixture.queue_func(), 1);
+    list.unsubscribe(handle);
+    list.queue(fixture.queue_func(), 2);
+    fixture.run_all();
+
+    EXPECT_EQ(first, (std::vector<int>{1}));
+    EXPECT_EQ(second, (std::vector<int>{1, 2}));
+
+    // Unsubscribing again or with an invalid handle does nothing.
+    list.unsubscribe(handle);
+    list.unsubscribe(Handle<int>{});
+    EXPECT_FALSE(list.empty());
+}
+
+TEST(CallbackList, HandlesOfOtherListsDontUnsubscribe)
+{
+    CallbackList<int> first;
+    CallbackList<int> second;
+
+    auto handle = first.subscribe([](int) {}, QueuePolicy::DropNewest);
+    second.subscribe([](int) {}, QueuePolicy::DropNewest);
+
+    second.unsubscribe(handle);
+    EXPECT_FALSE(second.empty());
+
+    first.unsubscribe(handle);
+    EXPECT_TRUE(first.empty());
+}
+
+TEST(CallbackList, ClearRemovesAllSubscribers)
+{
+    CallbackList<int> list;
+
+    list.subscribe([](int) {}, QueuePolicy::DropNewest);
+    list.set([](int) {});
+    EXPECT_FALSE(list.empty());
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(CallbackList, SetReplacesSubscriberWithoutHandle)
+{
+    Fixture fixture;
+    CallbackList<std::string, int> list;
+    std::vector<std::string> calls;
+
+    list.subscribe(
+        [&calls](std::string name, int value) { calls.push_back(name + std::to_string(value)); },
+        QueuePolicy::DropNewest);
+    list.set([&calls](std::string name, int value) {
+        calls.push_back("a" + name + std::to_string(value));
+    });
+    list.set([&calls](std::string name, int value) {
+        calls.push_back("b" + name + std::to_string(value));
+    });
+
+    list.queue(fixture.queue_func(), "x", 1);
+    fixture.run_all();
+    EXPECT_EQ(calls, (std::vector<std::string>{"x1", "bx1"}));
+
+    list.set(nullptr);
+    calls.clear();
+    list.queue(fixture.queue_func(), "y", 2);
+    fixture.run_all();
+    EXPECT_EQ(calls, (std::vector<std::string>{"y2"}));
+}
+
+TEST(CallbackList, EverySubscriberHasItsOwnPolicy)
+{
+    Fixture fixture;
+    CallbackList<int> list;
+    std::vector<int> latest;
+    std::vector<int> all;
+
+    list.subscribe([&latest](int value) { latest.push_back(value); }, QueuePolicy::LatestValue);
+    list.subscribe([&all](int value) { all.push_back(value); }, QueuePolicy::DropNewest);
+
+    for (int i = 0; i < 5; ++i) {
+        list.queue(fixture.queue_func(), i);
+    }
+    fixture.run_all();
+
+    EXPECT_EQ(latest, (std::vector<int>{4}));
+    EXPECT_EQ(all, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(CallbackList, SharesValueBetweenSubscribers)
+{
+    Fixture fixture;
+    CallbackList<CopyCounter> list;
+    unsigned calls = 0;
+
+    for (unsigned i = 0; i < 3; ++i) {
+        list.subscribe([&calls](const CopyCounter&) { ++calls; }, QueuePolicy::DropNewest);
+    }
+
+    CopyCounter::copies = 0;
+    list.queue(fixture.queue_func(), CopyCounter{});
+    EXPECT_EQ(CopyCounter::copies, 1);
+
+    fixture.run_all();
+    EXPECT_EQ(calls, 3);
+}
@@ -2,6 +2,7 @@
 #include "mavsdk_impl.h"
 #include "mavlink_channels.h"
 #include "global_include.h"
+#include <cstring>
 
 namespace mavsdk {
 
@@ -17,6 +18,59 @@ Connection::~Connection()
     _receiver_callback = {};
 }
 
+bool Connection::send_message(const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
+    return send_serialized_message(buffer, buffer_len);
+}
+
+bool Connection::send_serialized_message(const uint8_t* data, unsigned len)
+{
+    if (!_coalescing) {
+        return send_bytes(data, len);
+    }
+
+    std::lock_guard<std::mutex> lock(_coalesce_mutex);
+
+    bool success = true;
+    if (_coalesce_len + len > COALESCE_MAX_LEN) {
+        success = flush_locked();
+    }
+
+    std::memcpy(&_coalesce_buffer[_coalesce_len], data, len);
+    _coalesce_len += len;
+
+    return success;
+}
+
+void Connection::set_coalescing(bool coalescing)
+{
+    _coalescing = coalescing;
+
+    if (!coalescing) {
+        flush();
+    }
+}
+
+bool Connection::flush()
+{
+    std::lock_guard<std::mutex> lock(_coalesce_mutex);
+    return flush_locked();
+}
+
+bool Connection::flush_locked()
+{
+    if (_coalesce_len == 0) {
+        return true;
+    }
+
+    const bool success = send_bytes(_coalesce_buffer, _coalesce_len);
+    _coalesce_len = 0;
+    return success;
+}
+
 bool Connection::start_mavlink_receiver()
 {
     uint8_t channel;
@@ -43,4 +97,19 @@ void Connection::receive_message(mavlink_message_t& message)
     _receiver_callback(message);
 }
 
+bool Connection::add_to_io_reactor(int fd, IoReactor::ReadableCallback callback)
+{
+    if (_io_reactor == nullptr) {
+        return false;
+    }
+    return _io_reactor->add(fd, std::move(callback));
+}
+
+void Connection::remove_from_io_reactor(int fd)
+{
+    if (_io_reactor != nullptr) {
+        _io_reactor->remove(fd);
+    }
+}
+
 } // namespace mavsdk
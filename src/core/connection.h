@@ -2,7 +2,11 @@
 
 #include "mavsdk.h"
 #include "mavlink_receiver.h"
+#include "io_reactor.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
 namespace mavsdk {
 
@@ -16,19 +20,51 @@ public:
     virtual ConnectionResult start() = 0;
     virtual ConnectionResult stop() = 0;
 
-    virtual bool send_message(const mavlink_message_t& message) = 0;
+    bool send_message(const mavlink_message_t& message);
+
+    // Sends a message which is already serialized, so that it only needs
+    // to be serialized once for all connections.
+    bool send_serialized_message(const uint8_t* data, unsigned len);
+
+    // With coalescing, messages are collected and only sent on flush(), or
+    // earlier if no more fit into one datagram.
+    void set_coalescing(bool coalescing);
+    bool flush();
+
+    // If set before start(), the connection is serviced by the reactor
+    // instead of its own receive thread.
+    void set_io_reactor(IoReactor* io_reactor) { _io_reactor = io_reactor; }
 
     // Non-copyable
     Connection(const Connection&) = delete;
     const Connection& operator=(const Connection&) = delete;
 
 protected:
+    // Sends one datagram or chunk of a stream to the remote(s).
+    virtual bool send_bytes(const uint8_t* data, unsigned len) = 0;
+
     bool start_mavlink_receiver();
     void stop_mavlink_receiver();
     void receive_message(mavlink_message_t& message);
 
+    // Returns false if the fd has to be serviced by a receive thread instead.
+    bool add_to_io_reactor(int fd, IoReactor::ReadableCallback callback);
+    void remove_from_io_reactor(int fd);
+
     receiver_callback_t _receiver_callback{};
     std::unique_ptr<MAVLinkReceiver> _mavlink_receiver;
+    IoReactor* _io_reactor{nullptr};
+
+private:
+    bool flush_locked();
+
+    // Small enough to fit into one packet with the usual MTU of 1500 bytes.
+    static constexpr unsigned COALESCE_MAX_LEN = 1400;
+
+    std::atomic<bool> _coalescing{false};
+    std::mutex _coalesce_mutex{};
+    uint8_t _coalesce_buffer[COALESCE_MAX_LEN]{};
+    unsigned _coalesce_len{0};
 
     // void received_mavlink_message(mavlink_message_t &);
 };
@@ -0,0 +1,97 @@
+#include "connection.h"
+
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+class FakeConnection : public Connection {
+public:
+    FakeConnection() : Connection([](mavlink_message_t&) {}) {}
+
+    ConnectionResult start() override { return ConnectionResult::Success; }
+    ConnectionResult stop() override { return ConnectionResult::Success; }
+
+    std::vector<std::vector<uint8_t>> sent{};
+
+protected:
+    bool send_bytes(const uint8_t* data, unsigned len) override
+    {
+        sent.emplace_back(data, data + len);
+        return true;
+    }
+};
+
+mavlink_message_t heartbeat()
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, MAV_COMP_ID_AUTOPILOT1, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, 0);
+    return message;
+}
+
+} // namespace
+
+TEST(Connection, SendsEachMessageWithoutCoalescing)
+{
+    FakeConnection connection;
+    const auto message = heartbeat();
+
+    EXPECT_TRUE(connection.send_message(message));
+    EXPECT_TRUE(connection.send_message(message));
+
+    ASSERT_EQ(connection.sent.size(), 2);
+
+    uint8_t expected[MAVLINK_MAX_PACKET_LEN];
+    const unsigned expected_len = mavlink_msg_to_send_buffer(expected, &message);
+    EXPECT_EQ(connection.sent[0], std::vector<uint8_t>(expected, expected + expected_len));
+}
+
+TEST(Connection, CoalescesUntilFlush)
+{
+    FakeConnection connection;
+    connection.set_coalescing(true);
+    const auto message = heartbeat();
+
+    for (unsigned i = 0; i < 3; ++i) {
+        EXPECT_TRUE(connection.send_message(message));
+    }
+    EXPECT_EQ(connection.sent.size(), 0);
+
+    EXPECT_TRUE(connection.flush());
+    ASSERT_EQ(connection.sent.size(), 1);
+
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    const unsigned frame_len = mavlink_msg_to_send_buffer(frame, &message);
+    EXPECT_EQ(connection.sent[0].size(), 3 * frame_len);
+
+    // Nothing left to send.
+    EXPECT_TRUE(connection.flush());
+    EXPECT_EQ(connection.sent.size(), 1);
+}
+
+TEST(Connection, CoalescingNeverExceedsOneDatagram)
+{
+    FakeConnection connection;
+    connection.set_coalescing(true);
+    const auto message = heartbeat();
+
+    for (unsigned i = 0; i < 200; ++i) {
+        EXPECT_TRUE(connection.send_message(message));
+    }
+    connection.set_coalescing(false);
+
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    const unsigned frame_len = mavlink_msg_to_send_buffer(frame, &message);
+
+    unsigned total_len = 0;
+    for (const auto& datagram : connection.sent) {
+        EXPECT_LE(datagram.size(), 1400);
+        EXPECT_EQ(datagram.size() % frame_len, 0);
+        total_len += datagram.size();
+    }
+    EXPECT_EQ(total_len, 200 * frame_len);
+    EXPECT_GT(connection.sent.size(), 1);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+namespace mavsdk {
+
+/**
+ * @brief Vector with a fixed capacity, which keeps its elements inline instead of on the heap.
+ *
+ * It is used for the variable-length fields of telemetry types, whose length is bounded by
+ * the MAVLink message they come from, so that copying them doesn't allocate.
+ *
+ * Elements pushed beyond the capacity are dropped.
+ */
+template<typename T, std::size_t N> class FixedVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Default constructor, for an empty vector.
+     */
+    FixedVector() = default;
+
+    /**
+     * @brief Constructor from a list of elements, of which at most N are kept.
+     */
+    FixedVector(std::initializer_list<T> elements)
+    {
+        for (const auto& element : elements) {
+            push_back(element);
+        }
+    }
+
+    /**
+     * @brief Appends an element, unless the vector is full.
+     */
+    void push_back(const T& element)
+    {
+        if (_size < N) {
+            _data[_size++] = element;
+        }
+    }
+
+    /**
+     * @brief Removes all elements.
+     */
+    void clear() { _size = 0; }
+
+    /**
+     * @brief Number of elements.
+     */
+    size_type size() const { return _size; }
+
+    /**
+     * @brief Maximum number of elements.
+     */
+    static constexpr size_type capacity() { return N; }
+
+    /**
+     * @brief Whether there are no elements.
+     */
+    bool empty() const { return _size == 0; }
+
+    /**
+     * @brief Element at index, which needs to be less than size().
+     */
+    T& operator[](size_type index) { return _data[index]; }
+
+    /**
+     * @brief Element at index, which needs to be less than size().
+     */
+    const T& operator[](size_type index) const { return _data[index]; }
+
+    iterator begin() { return _data.data(); }
+    iterator end() { return _data.data() + _size; }
+    const_iterator begin() const { return _data.data(); }
+    const_iterator end() const { return _data.data() + _size; }
+
+    /**
+     * @brief Equal operator, which compares the elements up to size().
+     */
+    friend bool operator==(const FixedVector& lhs, const FixedVector& rhs)
+    {
+        if (lhs._size != rhs._size) {
+            return false;
+        }
+        for (size_type i = 0; i < lhs._size; ++i) {
+            if (!(lhs._data[i] == rhs._data[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Not equal operator.
+     */
+    friend bool operator!=(const FixedVector& lhs, const FixedVector& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    std::array<T, N> _data{};
+    size_type _size{0};
+};
+
+} // namespace mavsdk
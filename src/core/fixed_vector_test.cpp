@@ -0,0 +1,57 @@
+#include "fixed_vector.h"
+
+#include <type_traits>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+struct Status {
+    uint32_t active{0};
+    FixedVector<float, 32> values{};
+};
+
+} // namespace
+
+TEST(FixedVector, PushesUpToCapacity)
+{
+    FixedVector<int, 3> vector;
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(vector.capacity(), 3);
+
+    for (int i = 0; i < 5; ++i) {
+        vector.push_back(i);
+    }
+    EXPECT_EQ(vector.size(), 3);
+    EXPECT_EQ(vector[0], 0);
+    EXPECT_EQ(vector[2], 2);
+
+    int sum = 0;
+    for (const auto& element : vector) {
+        sum += element;
+    }
+    EXPECT_EQ(sum, 3);
+
+    vector.clear();
+    EXPECT_TRUE(vector.empty());
+    EXPECT_EQ(vector.begin(), vector.end());
+}
+
+TEST(FixedVector, ComparesOnlyElementsInUse)
+{
+    FixedVector<int, 4> lhs{1, 2};
+    FixedVector<int, 4> rhs{1, 2, 3};
+    EXPECT_NE(lhs, rhs);
+
+    rhs.clear();
+    rhs.push_back(1);
+    rhs.push_back(2);
+    EXPECT_EQ(lhs, rhs);
+}
+
+TEST(FixedVector, IsTriviallyCopyable)
+{
+    EXPECT_TRUE((std::is_trivially_copyable<FixedVector<float, 8>>::value));
+    EXPECT_TRUE(std::is_trivially_copyable<Status>::value);
+}
@@ -43,12 +43,12 @@ double Time::elapsed_since_s(const dl_time_t& since)
 dl_time_t Time::steady_time_in_future(double duration_s)
 {
     auto now = steady_time();
-    return now + std::chrono::milliseconds(int64_t(duration_s * 1e3));
+    return now + std::chrono::microseconds(int64_t(duration_s * 1e6));
 }
 
 void Time::shift_steady_time_by(dl_time_t& time, double offset_s)
 {
-    time += std::chrono::milliseconds(int64_t(offset_s * 1e3));
+    time += std::chrono::microseconds(int64_t(offset_s * 1e6));
 }
 
 void Time::sleep_for(std::chrono::hours h)
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mavsdk {
+
+template<typename... Args> class CallbackList;
+
+/**
+ * @brief How updates are queued for a subscriber which doesn't keep up with them.
+ */
+enum class QueuePolicy {
+    DropNewest, /**< @brief Once too many updates are queued, new ones are dropped (default). */
+    DropOldest, /**< @brief Once too many updates are queued, the oldest ones are dropped. */
+    LatestValue, /**< @brief Only the latest update is queued, the ones in between are
+                    skipped. */
+};
+
+/**
+ * @brief Handle of a subscription, which is used to unsubscribe again.
+ */
+template<typename... Args> class Handle {
+public:
+    /**
+     * @brief Default constructor, for a handle which isn't subscribed.
+     */
+    Handle() = default;
+
+    /**
+     * @brief Whether this is the handle of a subscription.
+     *
+     * @return `true` if it was returned by a subscribe function.
+     */
+    bool valid() const { return _id != 0; }
+
+private:
+    explicit Handle(uint64_t id) : _id(id) {}
+
+    uint64_t _id{0};
+
+    friend class CallbackList<Args...>;
+};
+
+} // namespace mavsdk
@@ -0,0 +1,232 @@
+#include "io_reactor.h"
+#include "global_include.h"
+#include "log.h"
+
+#if defined(LINUX)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+namespace mavsdk {
+
+IoReactor::IoReactor() {}
+
+IoReactor::~IoReactor()
+{
+    stop();
+}
+
+#if defined(LINUX)
+
+// The id 0 is reserved for the eventfd used to stop the threads.
+static constexpr uint64_t wakeup_id = 0;
+
+bool IoReactor::start(unsigned num_threads)
+{
+    if (num_threads == 0) {
+        return false;
+    }
+
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd < 0) {
+        LogErr() << "epoll_create1 failed: " << strerror(errno);
+        return false;
+    }
+
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_wakeup_fd < 0) {
+        LogErr() << "eventfd failed: " << strerror(errno);
+        stop();
+        return false;
+    }
+
+    // The wakeup event is not one-shot, so that it reaches all threads.
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = wakeup_id;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event) != 0) {
+        LogErr() << "epoll_ctl failed: " << strerror(errno);
+        stop();
+        return false;
+    }
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        _threads.emplace_back(&IoReactor::run, this);
+    }
+
+    return true;
+}
+
+void IoReactor::stop()
+{
+    if (_wakeup_fd >= 0) {
+        const uint64_t one = 1;
+        if (write(_wakeup_fd, &one, sizeof(one)) != sizeof(one)) {
+            LogErr() << "eventfd write failed: " << strerror(errno);
+        }
+    }
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+
+    if (_wakeup_fd >= 0) {
+        close(_wakeup_fd);
+        _wakeup_fd = -1;
+    }
+    if (_epoll_fd >= 0) {
+        close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+bool IoReactor::add(int fd, ReadableCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_epoll_fd < 0) {
+        return false;
+    }
+
+    const uint64_t id = _next_id++;
+
+    // One-shot, so that no other thread picks up the same fd until the
+    // callback has returned and we re-arm it.
+    struct epoll_event event {};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = id;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        LogErr() << "epoll_ctl failed: " << strerror(errno);
+        return false;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->fd = fd;
+    entry->callback = std::move(callback);
+    _entries[id] = entry;
+    return true;
+}
+
+void IoReactor::remove(int fd)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto it = std::find_if(_entries.begin(), _entries.end(), [fd](const auto& pair) {
+        return pair.second->fd == fd;
+    });
+    if (it == _entries.end()) {
+        return;
+    }
+
+    auto entry = it->second;
+    _entries.erase(it);
+    entry->removed = true;
+
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) != 0) {
+        LogErr() << "epoll_ctl failed: " << strerror(errno);
+    }
+
+    if (entry->running_on != std::this_thread::get_id()) {
+        _callback_finished.wait(lock, [&entry]() { return !entry->running; });
+    }
+}
+
+void IoReactor::run()
+{
+    struct epoll_event events[16];
+
+    while (true) {
+        const int num_events =
+            epoll_wait(_epoll_fd, events, sizeof(events) / sizeof(events[0]), -1);
+
+        if (num_events < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LogErr() << "epoll_wait failed: " << strerror(errno);
+            return;
+        }
+
+        for (int i = 0; i < num_events; ++i) {
+            if (events[i].data.u64 == wakeup_id) {
+                return;
+            }
+            handle(events[i].data.u64);
+        }
+    }
+}
+
+void IoReactor::handle(uint64_t id)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(id);
+        if (it == _entries.end()) {
+            return;
+        }
+        entry = it->second;
+        entry->running = true;
+        entry->running_on = std::this_thread::get_id();
+    }
+
+    entry->callback();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entry->running = false;
+        entry->running_on = std::thread::id{};
+
+        if (!entry->removed) {
+            struct epoll_event event {};
+            event.events = EPOLLIN | EPOLLONESHOT;
+            event.data.u64 = id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, entry->fd, &event) != 0) {
+                LogErr() << "epoll_ctl failed: " << strerror(errno);
+            }
+        }
+    }
+    _callback_finished.notify_all();
+}
+
+#else
+
+bool IoReactor::start(unsigned num_threads)
+{
+    UNUSED(num_threads);
+    return false;
+}
+
+void IoReactor::stop() {}
+
+bool IoReactor::add(int fd, ReadableCallback callback)
+{
+    UNUSED(fd);
+    UNUSED(callback);
+    return false;
+}
+
+void IoReactor::remove(int fd)
+{
+    UNUSED(fd);
+}
+
+void IoReactor::run() {}
+
+void IoReactor::handle(uint64_t id)
+{
+    UNUSED(id);
+}
+
+#endif
+
+} // namespace mavsdk
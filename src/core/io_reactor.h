@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mavsdk {
+
+// Waits for incoming data on the file descriptors of all connections using a
+// few shared threads instead of a blocking receive thread per connection.
+//
+// Every file descriptor is only ever handled by one thread at a time, so the
+// readable callback of a connection doesn't need to be thread-safe.
+//
+// This is currently only available on Linux (epoll), otherwise start() fails
+// and connections use their own receive thread.
+class IoReactor {
+public:
+    // Called when the file descriptor is readable. It should read what is
+    // available without blocking.
+    using ReadableCallback = std::function<void()>;
+
+    IoReactor();
+    ~IoReactor();
+
+    bool start(unsigned num_threads);
+    void stop();
+
+    bool add(int fd, ReadableCallback callback);
+
+    // Once this returns, the callback is not called anymore, unless it is
+    // called from within the callback itself.
+    void remove(int fd);
+
+    // Non-copyable
+    IoReactor(const IoReactor&) = delete;
+    const IoReactor& operator=(const IoReactor&) = delete;
+
+private:
+    struct Entry {
+        int fd{-1};
+        ReadableCallback callback{nullptr};
+        bool removed{false};
+        bool running{false};
+        std::thread::id running_on{};
+    };
+
+    void run();
+    void handle(uint64_t id);
+
+    int _epoll_fd{-1};
+    int _wakeup_fd{-1};
+    std::vector<std::thread> _threads{};
+
+    std::mutex _mutex{};
+    std::condition_variable _callback_finished{};
+    // Entries are looked up by id rather than by fd because an fd number
+    // can be reused by the system as soon as it is closed.
+    std::unordered_map<uint64_t, std::shared_ptr<Entry>> _entries{};
+    uint64_t _next_id{1};
+};
+
+} // namespace mavsdk
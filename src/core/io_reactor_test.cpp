@@ -0,0 +1,152 @@
+#if defined(LINUX)
+
+#include "io_reactor.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace mavsdk;
+
+namespace {
+
+bool wait_for(const std::function<bool()>& condition)
+{
+    for (unsigned i = 0; i < 100; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+struct SocketPair {
+    SocketPair() { EXPECT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0); }
+    ~SocketPair()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    void send(char c) { EXPECT_EQ(write(fds[1], &c, 1), 1); }
+
+    int fds[2]{-1, -1};
+};
+
+} // namespace
+
+TEST(IoReactor, CallsBackWhenReadable)
+{
+    IoReactor reactor;
+    ASSERT_TRUE(reactor.start(2));
+
+    SocketPair pairs[3];
+    std::atomic<unsigned> received[3]{};
+
+    for (unsigned i = 0; i < 3; ++i) {
+        ASSERT_TRUE(reactor.add(pairs[i].fds[0], [&pairs, &received, i]() {
+            char c;
+            if (read(pairs[i].fds[0], &c, 1) == 1) {
+                ++received[i];
+            }
+        }));
+    }
+
+    for (unsigned round = 0; round < 10; ++round) {
+        for (auto& pair : pairs) {
+            pair.send('x');
+        }
+    }
+
+    EXPECT_TRUE(wait_for([&received]() {
+        return received[0] == 10 && received[1] == 10 && received[2] == 10;
+    }));
+
+    for (auto& pair : pairs) {
+        reactor.remove(pair.fds[0]);
+    }
+    reactor.stop();
+}
+
+TEST(IoReactor, CallbackIsNeverRunConcurrently)
+{
+    IoReactor reactor;
+    ASSERT_TRUE(reactor.start(4));
+
+    SocketPair pair;
+    std::atomic<unsigned> running{0};
+    std::atomic<unsigned> max_running{0};
+    std::atomic<unsigned> received{0};
+
+    // Only read one byte per callback so that the fd stays readable.
+    ASSERT_TRUE(reactor.add(pair.fds[0], [&]() {
+        const unsigned now_running = ++running;
+        if (now_running > max_running) {
+            max_running = now_running;
+        }
+        char c;
+        if (read(pair.fds[0], &c, 1) == 1) {
+            ++received;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --running;
+    }));
+
+    for (unsigned i = 0; i < 20; ++i) {
+        pair.send('x');
+    }
+
+    EXPECT_TRUE(wait_for([&received]() { return received == 20; }));
+    EXPECT_EQ(max_running, 1);
+
+    reactor.remove(pair.fds[0]);
+}
+
+TEST(IoReactor, NotCalledAfterRemove)
+{
+    IoReactor reactor;
+    ASSERT_TRUE(reactor.start(1));
+
+    SocketPair pair;
+    std::atomic<unsigned> calls{0};
+
+    ASSERT_TRUE(reactor.add(pair.fds[0], [&]() {
+        char c;
+        EXPECT_EQ(read(pair.fds[0], &c, 1), 1);
+        ++calls;
+    }));
+
+    pair.send('x');
+    EXPECT_TRUE(wait_for([&calls]() { return calls == 1; }));
+
+    reactor.remove(pair.fds[0]);
+    pair.send('x');
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(IoReactor, RemoveFromCallback)
+{
+    IoReactor reactor;
+    ASSERT_TRUE(reactor.start(1));
+
+    SocketPair pair;
+    std::atomic<unsigned> calls{0};
+
+    ASSERT_TRUE(reactor.add(pair.fds[0], [&]() {
+        ++calls;
+        reactor.remove(pair.fds[0]);
+    }));
+
+    pair.send('x');
+    pair.send('x');
+    EXPECT_TRUE(wait_for([&calls]() { return calls == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls, 1);
+}
+
+#endif
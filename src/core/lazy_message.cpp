@@ -0,0 +1,31 @@
+#include "lazy_message.h"
+
+namespace mavsdk {
+
+LazyMessage::LazyMessage(Decoder decoder) : _decoder(std::move(decoder)) {}
+
+void LazyMessage::store(const mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _message = message;
+    _pending = true;
+}
+
+void LazyMessage::decode(const mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending = false;
+    _decoder(message);
+}
+
+void LazyMessage::decode_pending() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_pending) {
+        return;
+    }
+    _pending = false;
+    _decoder(_message);
+}
+
+} // namespace mavsdk
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+
+#include "mavlink_include.h"
+
+namespace mavsdk {
+
+// The latest message of one kind, which is only decoded once it's needed.
+//
+// Decoding and converting every message that comes in is wasted for topics
+// which nobody subscribes to or polls, so the raw message is stored instead,
+// and decoded once its value is asked for.
+class LazyMessage {
+public:
+    using Decoder = std::function<void(const mavlink_message_t&)>;
+
+    explicit LazyMessage(Decoder decoder);
+    ~LazyMessage() = default;
+
+    // Keeps the message, replacing one which hasn't been decoded yet.
+    void store(const mavlink_message_t& message);
+
+    // Decodes the message right away, e.g. because someone is subscribed to it.
+    void decode(const mavlink_message_t& message);
+
+    // Decodes the stored message, if it hasn't been decoded yet.
+    //
+    // This is const, so that it can be called from getters: the decoded value
+    // is the same whenever it is decoded.
+    void decode_pending() const;
+
+    // Non-copyable
+    LazyMessage(const LazyMessage&) = delete;
+    const LazyMessage& operator=(const LazyMessage&) = delete;
+
+private:
+    const Decoder _decoder;
+
+    // Also held while decoding, so that an older message can't be decoded
+    // after a newer one.
+    mutable std::mutex _mutex{};
+    mutable mavlink_message_t _message{};
+    mutable bool _pending{false};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,84 @@
+#include "lazy_message.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+mavlink_message_t message_with_seq(uint8_t seq)
+{
+    mavlink_message_t message{};
+    message.seq = seq;
+    return message;
+}
+
+} // namespace
+
+TEST(LazyMessage, OnlyDecodesWhenAskedFor)
+{
+    std::vector<uint8_t> decoded;
+    LazyMessage lazy_message{
+        [&decoded](const mavlink_message_t& message) { decoded.push_back(message.seq); }};
+
+    // Nothing stored yet.
+    lazy_message.decode_pending();
+    EXPECT_TRUE(decoded.empty());
+
+    for (uint8_t i = 1; i <= 10; ++i) {
+        lazy_message.store(message_with_seq(i));
+    }
+    EXPECT_TRUE(decoded.empty());
+
+    // Only the latest one gets decoded, and only once.
+    lazy_message.decode_pending();
+    lazy_message.decode_pending();
+    EXPECT_EQ(decoded, (std::vector<uint8_t>{10}));
+}
+
+TEST(LazyMessage, DecodesRightAway)
+{
+    std::vector<uint8_t> decoded;
+    LazyMessage lazy_message{
+        [&decoded](const mavlink_message_t& message) { decoded.push_back(message.seq); }};
+
+    lazy_message.store(message_with_seq(1));
+    lazy_message.decode(message_with_seq(2));
+    EXPECT_EQ(decoded, (std::vector<uint8_t>{2}));
+
+    // The stored message is older, so it's not decoded anymore.
+    lazy_message.decode_pending();
+    EXPECT_EQ(decoded, (std::vector<uint8_t>{2}));
+}
+
+TEST(LazyMessage, NeverDecodesOlderAfterNewer)
+{
+    std::atomic<int> last_decoded{0};
+    std::atomic<int> out_of_order{0};
+    LazyMessage lazy_message{[&](const mavlink_message_t& message) {
+        if (message.seq < last_decoded) {
+            ++out_of_order;
+        }
+        last_decoded = message.seq;
+    }};
+
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        while (!done) {
+            lazy_message.decode_pending();
+        }
+    });
+
+    for (uint8_t i = 1; i < 255; ++i) {
+        lazy_message.store(message_with_seq(i));
+    }
+    done = true;
+    reader.join();
+
+    lazy_message.decode_pending();
+    EXPECT_EQ(out_of_order, 0);
+    EXPECT_EQ(last_decoded, 254);
+}
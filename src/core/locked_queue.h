@@ -3,6 +3,7 @@
 #include <queue>
 #include <mutex>
 #include <memory>
+#include <functional>
 
 namespace mavsdk {
 
@@ -11,10 +12,21 @@ public:
     LockedQueue(){};
     ~LockedQueue(){};
 
+    // The wakeup callback is called whenever an item is added or removed, so
+    // whoever works on the queue doesn't have to poll it. It needs to be set
+    // before the queue is used.
+    void set_wakeup_callback(std::function<void()> callback)
+    {
+        _wakeup_callback = std::move(callback);
+    }
+
     void push_back(std::shared_ptr<T> item_ptr)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _queue.push_back(item_ptr);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back(item_ptr);
+        }
+        wake_up();
     }
 
     size_t size()
@@ -28,7 +40,12 @@ public:
 
     iterator end() { return _queue.end(); }
 
-    iterator erase(iterator it) { return _queue.erase(it); }
+    iterator erase(iterator it)
+    {
+        auto next = _queue.erase(it);
+        wake_up();
+        return next;
+    }
 
     // This guard serves the purpose to combine a get_front with a pop_front.
     // Thus, no one can interfere between the two steps.
@@ -39,7 +56,13 @@ public:
             _locked_queue._mutex.lock();
         }
 
-        ~Guard() { _locked_queue._mutex.unlock(); }
+        ~Guard()
+        {
+            _locked_queue._mutex.unlock();
+            if (_popped) {
+                _locked_queue.wake_up();
+            }
+        }
 
         Guard(Guard& other) = delete;
         Guard(const Guard& other) = delete;
@@ -56,13 +79,26 @@ public:
             return _locked_queue._queue.front();
         }
 
-        void pop_front() { _locked_queue._queue.pop_front(); }
+        void pop_front()
+        {
+            _locked_queue._queue.pop_front();
+            _popped = true;
+        }
 
     private:
         LockedQueue<T>& _locked_queue;
+        bool _popped{false};
     };
 
 private:
+    void wake_up()
+    {
+        if (_wakeup_callback) {
+            _wakeup_callback();
+        }
+    }
+
+    std::function<void()> _wakeup_callback{nullptr};
     std::deque<std::shared_ptr<T>> _queue{};
     std::mutex _mutex{};
 };
@@ -1,18 +1,15 @@
 #include "mavlink_commands.h"
 #include "system_impl.h"
+#include <algorithm>
 #include <future>
 #include <memory>
 
 namespace mavsdk {
 
-// TODO: Currently the mavlink command handling is made in a way to only
-//       process one command at any time. Therefore, the work state is global
-//       for this whole class.
-//       The limitation is made because:
-//       - We are not sure what exactly will happen if the commands are sent in parallel
-//         and what kind of edge cases we might run into.
-//       - The queue used does not support going through and checking each and every
-//         item yet.
+// Several commands can be in flight at the same time. The only ones which have to
+// wait for each other are those whose acks can't be told apart: the same command
+// sent to the same component. A slow component therefore only holds up the
+// commands sent to itself.
 
 MavlinkCommandSender::MavlinkCommandSender(SystemImpl& system_impl) : _parent(system_impl)
 {
@@ -25,6 +22,13 @@ MavlinkCommandSender::MavlinkCommandSender(SystemImpl& system_impl) : _parent(sy
 MavlinkCommandSender::~MavlinkCommandSender()
 {
     _parent.unregister_all_mavlink_message_handlers(this);
+
+    LockedQueue<Work>::Guard work_queue_guard(_work_queue);
+    for (const auto& work : _work_queue) {
+        if (work->already_sent) {
+            _parent.unregister_timeout_handler(work->timeout_cookie);
+        }
+    }
 }
 
 MavlinkCommandSender::Result
@@ -68,6 +72,22 @@ MavlinkCommandSender::send_command(const MavlinkCommandSender::CommandLong& comm
     return res.get();
 }
 
+MavlinkCommandSender::Result
+MavlinkCommandSender::send_commands(const std::vector<MavlinkCommandSender::CommandLong>& commands)
+{
+    auto prom = std::make_shared<std::promise<Result>>();
+    auto res = prom->get_future();
+
+    queue_commands_async(commands, [prom](Result result, float progress) {
+        UNUSED(progress);
+        if (result != Result::InProgress) {
+            prom->set_value(result);
+        }
+    });
+
+    return res.get();
+}
+
 void MavlinkCommandSender::queue_command_async(
     const CommandInt& command, CommandResultCallback callback)
 {
@@ -75,11 +95,12 @@ void MavlinkCommandSender::queue_command_async(
     //  << (int)(command.target_system_id)<< ", " << (int)(command.target_component_id);
 
     auto new_work = std::make_shared<Work>();
+    new_work->mavlink_messages.resize(1);
 
     mavlink_msg_command_int_pack(
         _parent.get_own_system_id(),
         _parent.get_own_component_id(),
-        &new_work->mavlink_message,
+        &new_work->mavlink_messages[0],
         command.target_system_id,
         command.target_component_id,
         command.frame,
@@ -96,6 +117,7 @@ void MavlinkCommandSender::queue_command_async(
 
     new_work->callback = callback;
     new_work->mavlink_command = command.command;
+    new_work->target_component_id = command.target_component_id;
     _work_queue.push_back(new_work);
 }
 
@@ -105,25 +127,51 @@ void MavlinkCommandSender::queue_command_async(
     // LogDebug() << "Command " << (int)(command.command) << " to send to "
     //  << (int)(command.target_system_id)<< ", " << (int)(command.target_component_id);
 
+    queue_commands_async({command}, callback);
+}
+
+void MavlinkCommandSender::queue_commands_async(
+    const std::vector<CommandLong>& commands, CommandResultCallback callback)
+{
+    if (commands.empty()) {
+        call_callback(callback, Result::Success, 1.0f);
+        return;
+    }
+
+    for (const auto& command : commands) {
+        if (command.command != commands.front().command ||
+            command.target_component_id != commands.front().target_component_id) {
+            LogErr() << "Can't send different commands at once (" << command.command << ").";
+            call_callback(callback, Result::UnknownError, NAN);
+            return;
+        }
+    }
+
     auto new_work = std::make_shared<Work>();
-    mavlink_msg_command_long_pack(
-        _parent.get_own_system_id(),
-        _parent.get_own_component_id(),
-        &new_work->mavlink_message,
-        command.target_system_id,
-        command.target_component_id,
-        command.command,
-        command.confirmation,
-        command.params.param1,
-        command.params.param2,
-        command.params.param3,
-        command.params.param4,
-        command.params.param5,
-        command.params.param6,
-        command.params.param7);
+    new_work->mavlink_messages.resize(commands.size());
+
+    for (size_t i = 0; i < commands.size(); ++i) {
+        const auto& command = commands[i];
+        mavlink_msg_command_long_pack(
+            _parent.get_own_system_id(),
+            _parent.get_own_component_id(),
+            &new_work->mavlink_messages[i],
+            command.target_system_id,
+            command.target_component_id,
+            command.command,
+            command.confirmation,
+            command.params.param1,
+            command.params.param2,
+            command.params.param3,
+            command.params.param4,
+            command.params.param5,
+            command.params.param6,
+            command.params.param7);
+    }
 
     new_work->callback = callback;
-    new_work->mavlink_command = command.command;
+    new_work->mavlink_command = commands.front().command;
+    new_work->target_component_id = commands.front().target_component_id;
     new_work->time_started = _parent.get_time().steady_time();
     _work_queue.push_back(new_work);
 }
@@ -138,55 +186,54 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
 
     {
         LockedQueue<Work>::Guard work_queue_guard(_work_queue);
-        auto work = work_queue_guard.get_front();
+        auto it = find_in_flight(message.compid, command_ack.command);
 
-        if (!work) {
-            return;
-        }
-
-        if (work->mavlink_command != command_ack.command) {
-            // If the command does not match with our current command, ignore it.
+        if (it == _work_queue.end()) {
+            // If the command does not match with any command we sent, ignore it.
             LogWarn() << "Command ack " << int(command_ack.command)
-                      << " not matching our current command: " << work->mavlink_command;
+                      << " not matching any command in flight.";
             return;
         }
 
+        auto work = *it;
+
         // LogDebug() << "We got an ack: " << command_ack.command << " after: "
         //     << _parent.get_time().elapsed_since_s(work->time_started) << " s";
         temp_callback = work->callback;
+        bool done = false;
 
         switch (command_ack.result) {
             case MAV_RESULT_ACCEPTED:
-                _parent.unregister_timeout_handler(_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
                 temp_result = {Result::Success, 1.0f};
-                work_queue_guard.pop_front();
+                done = true;
                 break;
 
             case MAV_RESULT_DENIED:
                 LogWarn() << "command denied (" << work->mavlink_command << ").";
-                _parent.unregister_timeout_handler(_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
                 temp_result = {Result::CommandDenied, NAN};
-                work_queue_guard.pop_front();
+                done = true;
                 break;
 
             case MAV_RESULT_UNSUPPORTED:
                 LogWarn() << "command unsupported (" << work->mavlink_command << ").";
-                _parent.unregister_timeout_handler(_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
                 temp_result = {Result::Unsupported, NAN};
-                work_queue_guard.pop_front();
+                done = true;
                 break;
 
             case MAV_RESULT_TEMPORARILY_REJECTED:
                 LogWarn() << "command temporarily rejected (" << work->mavlink_command << ").";
-                _parent.unregister_timeout_handler(_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
                 temp_result = {Result::CommandDenied, NAN};
-                work_queue_guard.pop_front();
+                done = true;
                 break;
 
             case MAV_RESULT_FAILED:
-                _parent.unregister_timeout_handler(_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
                 temp_result = {Result::CommandDenied, NAN};
-                work_queue_guard.pop_front();
+                done = true;
                 break;
 
             case MAV_RESULT_IN_PROGRESS:
@@ -199,11 +246,9 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
                 // has arrived. A possible timeout for this case is the initial
                 // timeout * the possible retries because this should match the
                 // case where there is no progress update and we keep trying.
-                _parent.unregister_timeout_handler(_timeout_cookie);
-                _parent.register_timeout_handler(
-                    std::bind(&MavlinkCommandSender::receive_timeout, this),
-                    work->retries_to_do * work->timeout_s,
-                    &_timeout_cookie);
+                _parent.unregister_timeout_handler(work->timeout_cookie);
+                register_timeout(*work, work->retries_to_do * work->timeout_s);
+                work->measures_rtt = false;
 
                 temp_result = {Result::InProgress, command_ack.progress / 100.0f};
                 break;
@@ -212,6 +257,36 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
                 LogWarn() << "Received unknown ack.";
                 break;
         }
+
+        if (done) {
+            // Other components such as cameras can take a lot longer to ack, so only the
+            // autopilot's acks tell the round trip time of the link.
+            if (work->measures_rtt && work->acks_received == 0 &&
+                work->target_component_id == DEFAULT_COMPONENT_ID_AUTOPILOT &&
+                message.compid == DEFAULT_COMPONENT_ID_AUTOPILOT) {
+                _parent.rtt_estimator().add_sample_s(
+                    _parent.get_time().elapsed_since_s(work->time_started));
+            }
+            work->measures_rtt = false;
+
+            if (work->result == Result::Success) {
+                work->result = temp_result.first;
+            }
+            if (work->acks_to_discount > 0) {
+                --work->acks_to_discount;
+            } else {
+                ++work->acks_received;
+            }
+
+            if (work->acks_received < work->mavlink_messages.size()) {
+                // The rest of the batch is still on its way, so we wait for it.
+                register_timeout(*work, work->timeout_s);
+                return;
+            }
+
+            temp_result = {work->result, work->result == Result::Success ? 1.0f : NAN};
+            _work_queue.erase(it);
+        }
     }
 
     if (temp_callback != nullptr) {
@@ -219,40 +294,46 @@ void MavlinkCommandSender::receive_command_ack(mavlink_message_t message)
     }
 }
 
-void MavlinkCommandSender::receive_timeout()
+void MavlinkCommandSender::receive_timeout(const Work* timed_out)
 {
     CommandResultCallback temp_callback = nullptr;
     std::pair<Result, float> temp_result{Result::UnknownError, NAN};
 
     {
-        // If we're not waiting, we ignore this.
         LockedQueue<Work>::Guard work_queue_guard(_work_queue);
-        auto work = work_queue_guard.get_front();
+        auto it = std::find_if(
+            _work_queue.begin(), _work_queue.end(), [timed_out](const std::shared_ptr<Work>& work) {
+                return work.get() == timed_out;
+            });
 
-        if (!work) {
-            LogErr() << "Received timeout without item in queue.";
+        if (it == _work_queue.end()) {
+            // It has been acked in the meantime.
             return;
         }
 
+        auto work = *it;
+
         if (work->retries_to_do > 0) {
             // We're not sure the command arrived, let's retransmit.
             LogWarn() << "sending again after "
                       << _parent.get_time().elapsed_since_s(work->time_started)
                       << " s, retries to do: " << work->retries_to_do << "  ("
                       << work->mavlink_command << ").";
-            if (!_parent.send_message(work->mavlink_message)) {
+            // We can't tell which commands of a batch the acks were for, so the
+            // whole batch is sent again. What was acked so far still counts.
+            work->acks_to_discount = work->acks_received;
+            work->measures_rtt = false;
+            if (!send_messages(work->mavlink_messages)) {
                 LogErr() << "connection send error in retransmit (" << work->mavlink_command
                          << ").";
                 temp_callback = work->callback;
                 temp_result = {Result::ConnectionError, NAN};
-                work_queue_guard.pop_front();
+                _work_queue.erase(it);
 
             } else {
                 --work->retries_to_do;
-                _parent.register_timeout_handler(
-                    std::bind(&MavlinkCommandSender::receive_timeout, this),
-                    work->timeout_s,
-                    &_timeout_cookie);
+                work->timeout_s = RttEstimator::backed_off_s(work->timeout_s);
+                register_timeout(*work, work->timeout_s);
             }
 
         } else {
@@ -261,7 +342,7 @@ void MavlinkCommandSender::receive_timeout()
 
             temp_callback = work->callback;
             temp_result = {Result::ConnectionError, NAN};
-            work_queue_guard.pop_front();
+            _work_queue.erase(it);
         }
     }
 
@@ -272,39 +353,107 @@ void MavlinkCommandSender::receive_timeout()
 
 void MavlinkCommandSender::do_work()
 {
-    CommandResultCallback temp_callback = nullptr;
-    std::pair<Result, float> temp_result{Result::UnknownError, NAN};
+    std::vector<CommandResultCallback> failed_callbacks;
 
     {
         LockedQueue<Work>::Guard work_queue_guard(_work_queue);
-        auto work = work_queue_guard.get_front();
 
-        if (!work) {
-            // Nothing to do.
-            return;
-        }
-
-        if (!work->already_sent) {
-            // LogDebug() << "sending it the first time (" << work->mavlink_command << ")";
-            work->time_started = _parent.get_time().steady_time();
-            if (!_parent.send_message(work->mavlink_message)) {
-                LogErr() << "connection send error (" << work->mavlink_command << ")";
-                temp_callback = work->callback;
-                temp_result = {Result::ConnectionError, NAN};
-                work_queue_guard.pop_front();
-            } else {
+        // Commands which can't be told apart by their acks are sent one after the
+        // other, in the order they were queued. Everything else is sent right away.
+        std::vector<const Work*> ahead;
+
+        for (auto it = _work_queue.begin(); it != _work_queue.end();) {
+            auto work = *it;
+
+            const bool waiting = std::any_of(ahead.begin(), ahead.end(), [&](const Work* other) {
+                return acks_ambiguous(*other, *work);
+            });
+
+            if (!waiting && !work->already_sent) {
+                // LogDebug() << "sending it the first time (" << work->mavlink_command << ")";
+                work->time_started = _parent.get_time().steady_time();
+                if (!send_messages(work->mavlink_messages)) {
+                    LogErr() << "connection send error (" << work->mavlink_command << ")";
+                    failed_callbacks.push_back(work->callback);
+                    it = _work_queue.erase(it);
+                    continue;
+                }
                 work->already_sent = true;
-                _parent.register_timeout_handler(
-                    std::bind(&MavlinkCommandSender::receive_timeout, this),
-                    work->timeout_s,
-                    &_timeout_cookie);
+                // The RTT is measured to the autopilot, other components such as cameras
+                // can take a lot longer to ack. So for them the default is kept as the minimum.
+                const double estimated_s = _parent.rtt_estimator().timeout_s(work->timeout_s);
+                work->timeout_s = work->target_component_id == DEFAULT_COMPONENT_ID_AUTOPILOT ?
+                                      estimated_s :
+                                      std::max(work->timeout_s, estimated_s);
+                register_timeout(*work, work->timeout_s);
             }
+
+            ahead.push_back(work.get());
+            ++it;
         }
     }
 
-    if (temp_callback != nullptr) {
-        call_callback(temp_callback, temp_result.first, temp_result.second);
+    for (const auto& callback : failed_callbacks) {
+        call_callback(callback, Result::ConnectionError, NAN);
+    }
+}
+
+LockedQueue<MavlinkCommandSender::Work>::iterator
+MavlinkCommandSender::find_in_flight(uint8_t component_id, uint16_t command)
+{
+    const auto sent = [command](const std::shared_ptr<Work>& work) {
+        return work->already_sent && work->mavlink_command == command;
+    };
+
+    // The oldest one sent to this component, or to all components.
+    auto it = std::find_if(
+        _work_queue.begin(), _work_queue.end(), [&](const std::shared_ptr<Work>& work) {
+            return sent(work) && (work->target_component_id == component_id ||
+                                  work->target_component_id == MAV_COMP_ID_ALL);
+        });
+
+    if (it == _work_queue.end()) {
+        // Some commands sent to the autopilot are passed on and acked by another component,
+        // e.g. by a gimbal connected to it. Commands sent to other components are only
+        // acked by them, so an ack can't be taken for theirs by mistake.
+        it = std::find_if(
+            _work_queue.begin(), _work_queue.end(), [&](const std::shared_ptr<Work>& work) {
+                return sent(work) && work->target_component_id == DEFAULT_COMPONENT_ID_AUTOPILOT;
+            });
     }
+
+    return it;
+}
+
+bool MavlinkCommandSender::acks_ambiguous(const Work& lhs, const Work& rhs)
+{
+    return lhs.mavlink_command == rhs.mavlink_command &&
+           (lhs.target_component_id == rhs.target_component_id ||
+            lhs.target_component_id == MAV_COMP_ID_ALL ||
+            rhs.target_component_id == MAV_COMP_ID_ALL);
+}
+
+void MavlinkCommandSender::register_timeout(Work& work, double timeout_s)
+{
+    _parent.register_timeout_handler(
+        std::bind(&MavlinkCommandSender::receive_timeout, this, &work),
+        timeout_s,
+        &work.timeout_cookie);
+}
+
+bool MavlinkCommandSender::send_messages(std::vector<mavlink_message_t>& messages)
+{
+    for (auto& message : messages) {
+        if (!_parent.send_message(message)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MavlinkCommandSender::set_wakeup_callback(std::function<void()> callback)
+{
+    _work_queue.set_wakeup_callback(std::move(callback));
 }
 
 void MavlinkCommandSender::call_callback(
@@ -7,6 +7,7 @@
 #include <string>
 #include <functional>
 #include <mutex>
+#include <vector>
 
 namespace mavsdk {
 
@@ -94,11 +95,20 @@ public:
 
     Result send_command(const CommandInt& command);
     Result send_command(const CommandLong& command);
+    Result send_commands(const std::vector<CommandLong>& commands);
 
     void queue_command_async(const CommandInt& command, CommandResultCallback callback);
     void queue_command_async(const CommandLong& command, CommandResultCallback callback);
 
+    // Sends several commands of the same kind to the same component at once, instead
+    // of waiting for the ack of one before sending the next. The callback is called
+    // once all of them are acked, with the first result which isn't a success.
+    void queue_commands_async(
+        const std::vector<CommandLong>& commands, CommandResultCallback callback);
+
     void do_work();
+    // Called whenever do_work() has something new to do.
+    void set_wakeup_callback(std::function<void()> callback);
 
     static const int DEFAULT_COMPONENT_ID_AUTOPILOT = MAV_COMP_ID_AUTOPILOT1;
 
@@ -111,21 +121,38 @@ private:
         int retries_to_do{3};
         double timeout_s{0.5};
         uint16_t mavlink_command{0};
+        uint8_t target_component_id{0};
         bool already_sent{false};
-        mavlink_message_t mavlink_message{};
+        // Acks only say which command they are for, so the acks of a batch are
+        // counted rather than matched to the messages. When a batch is sent again, the
+        // messages acked before get acked a second time, so that many acks are discounted.
+        std::vector<mavlink_message_t> mavlink_messages{};
+        size_t acks_received{0};
+        size_t acks_to_discount{0};
+        // The first failure of the batch, which later acks don't undo.
+        Result result{Result::Success};
         CommandResultCallback callback{};
         dl_time_t time_started{};
+        void* timeout_cookie{nullptr};
+        // Only acks of commands sent once, and acked right away, tell the round trip time.
+        bool measures_rtt{true};
     };
 
     void receive_command_ack(mavlink_message_t message);
-    void receive_timeout();
+    void receive_timeout(const Work* timed_out);
+    bool send_messages(std::vector<mavlink_message_t>& messages);
+
+    // Only to be called while the work queue is locked.
+    LockedQueue<Work>::iterator find_in_flight(uint8_t component_id, uint16_t command);
+    void register_timeout(Work& work, double timeout_s);
+
+    // Whether acks for one couldn't be told apart from acks for the other.
+    static bool acks_ambiguous(const Work& lhs, const Work& rhs);
 
     void call_callback(const CommandResultCallback& callback, Result result, float progress);
 
     SystemImpl& _parent;
     LockedQueue<Work> _work_queue{};
-
-    void* _timeout_cookie = nullptr;
 };
 
 class MavlinkCommandReceiver {
@@ -0,0 +1,166 @@
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "mavsdk.h"
+#include "mocks/fake_autopilot.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
+
+using namespace mavsdk;
+using namespace mavsdk::testing;
+
+// The commands are sent through MavlinkPassthrough, which hands them to the command sender
+// of the system as they are.
+
+namespace {
+
+constexpr uint8_t CAMERA = MAV_COMP_ID_CAMERA;
+
+MavlinkPassthrough::CommandLong user_command(uint8_t target_compid, float param1)
+{
+    MavlinkPassthrough::CommandLong command{};
+    command.target_sysid = FakeAutopilot::SYSID;
+    command.target_compid = target_compid;
+    command.command = MAV_CMD_USER_1;
+    command.param1 = param1;
+    return command;
+}
+
+// The COMMAND_LONG with MAV_CMD_USER_1 which arrived at the fake autopilot, in order.
+struct Arrivals {
+    std::mutex mutex{};
+    std::vector<std::pair<float, std::chrono::steady_clock::time_point>> commands{};
+    std::promise<void> first{};
+
+    void add(const mavlink_message_t& command_long)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.emplace_back(
+            mavlink_msg_command_long_get_param1(&command_long), std::chrono::steady_clock::now());
+        if (commands.size() == 1) {
+            first.set_value();
+        }
+    }
+};
+
+bool is_user_command(const mavlink_message_t& command_long)
+{
+    return mavlink_msg_command_long_get_command(&command_long) == MAV_CMD_USER_1;
+}
+
+class MavlinkCommands : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        auto system = _autopilot.connect(_mavsdk);
+        ASSERT_TRUE(system);
+        _mavlink_passthrough = std::make_unique<MavlinkPassthrough>(system);
+    }
+
+    std::future<MavlinkPassthrough::Result> send(MavlinkPassthrough::CommandLong command)
+    {
+        return std::async(std::launch::async, [this, command]() {
+            return _mavlink_passthrough->send_command_long(command);
+        });
+    }
+
+    FakeAutopilot _autopilot{};
+    Mavsdk _mavsdk{};
+    std::unique_ptr<MavlinkPassthrough> _mavlink_passthrough{};
+};
+
+} // namespace
+
+TEST_F(MavlinkCommands, SlowComponentDoesNotHoldUpAutopilot)
+{
+    const auto delay = std::chrono::milliseconds(300);
+    auto arrivals = std::make_shared<Arrivals>();
+    _autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG, [this, arrivals, delay](const mavlink_message_t& message) {
+            if (!is_user_command(message)) {
+                return;
+            }
+            arrivals->add(message);
+            const uint8_t target = mavlink_msg_command_long_get_target_component(&message);
+            _autopilot.send(
+                FakeAutopilot::command_ack(message, target, MAV_RESULT_ACCEPTED),
+                target == CAMERA ? delay : std::chrono::milliseconds{});
+        });
+
+    auto slow = send(user_command(CAMERA, 1.0f));
+    ASSERT_EQ(
+        arrivals->first.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    auto fast = send(user_command(MAV_COMP_ID_AUTOPILOT1, 2.0f));
+    ASSERT_EQ(fast.wait_for(delay / 2), std::future_status::ready);
+    EXPECT_EQ(fast.get(), MavlinkPassthrough::Result::Success);
+    EXPECT_NE(slow.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+    EXPECT_EQ(slow.get(), MavlinkPassthrough::Result::Success);
+}
+
+TEST_F(MavlinkCommands, SameCommandToSameComponentIsSentInOrder)
+{
+    // The same command to the same component can't be told apart by its acks, so the second
+    // one may only be sent once the first one is acked.
+    const auto delay = std::chrono::milliseconds(100);
+    auto arrivals = std::make_shared<Arrivals>();
+    _autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG, [this, arrivals, delay](const mavlink_message_t& message) {
+            if (is_user_command(message)) {
+                arrivals->add(message);
+                _autopilot.send(
+                    FakeAutopilot::command_ack(message, CAMERA, MAV_RESULT_ACCEPTED), delay);
+            }
+        });
+
+    auto first = send(user_command(CAMERA, 1.0f));
+    ASSERT_EQ(
+        arrivals->first.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    auto second = send(user_command(CAMERA, 2.0f));
+
+    EXPECT_EQ(first.get(), MavlinkPassthrough::Result::Success);
+    EXPECT_EQ(second.get(), MavlinkPassthrough::Result::Success);
+
+    std::lock_guard<std::mutex> lock(arrivals->mutex);
+    ASSERT_EQ(arrivals->commands.size(), 2u);
+    EXPECT_EQ(arrivals->commands[0].first, 1.0f);
+    EXPECT_EQ(arrivals->commands[1].first, 2.0f);
+    EXPECT_GE(arrivals->commands[1].second - arrivals->commands[0].second, delay);
+}
+
+TEST_F(MavlinkCommands, IgnoresDuplicateAndStrayAcks)
+{
+    // The first command gets acked twice. The second one gets acked by the autopilot, which it
+    // wasn't sent to, before the camera denies it.
+    const auto late = std::chrono::milliseconds(50);
+    _autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG, [this, late](const mavlink_message_t& message) {
+            if (!is_user_command(message)) {
+                return;
+            }
+            if (mavlink_msg_command_long_get_param1(&message) == 1.0f) {
+                const auto ack = FakeAutopilot::command_ack(message, CAMERA, MAV_RESULT_ACCEPTED);
+                _autopilot.send(ack);
+                _autopilot.send(ack, late);
+            } else {
+                _autopilot.send(FakeAutopilot::command_ack(
+                    message, MAV_COMP_ID_AUTOPILOT1, MAV_RESULT_ACCEPTED));
+                _autopilot.send(
+                    FakeAutopilot::command_ack(message, CAMERA, MAV_RESULT_DENIED), 2 * late);
+            }
+        });
+
+    EXPECT_EQ(send(user_command(CAMERA, 1.0f)).get(), MavlinkPassthrough::Result::Success);
+
+    // An ack doesn't say which of two equal commands it is for, so a duplicate can only be
+    // ignored if it arrives while none of them is in flight.
+    std::this_thread::sleep_for(2 * late);
+
+    EXPECT_EQ(send(user_command(CAMERA, 2.0f)).get(), MavlinkPassthrough::Result::CommandDenied);
+}
@@ -1,58 +1,147 @@
+#include <algorithm>
 #include <mutex>
+#include <thread>
 #include "mavlink_message_handler.h"
+#include "log.h"
 
 namespace mavsdk {
 
+namespace {
+
+// Callbacks currently being called on this thread. We need to know them so
+// that a callback unregistering itself doesn't wait for itself to return.
+struct CallFrame {
+    const void* entry;
+    const CallFrame* previous;
+};
+
+thread_local const CallFrame* current_call = nullptr;
+
+unsigned calls_on_this_thread(const void* entry)
+{
+    unsigned count = 0;
+    for (const CallFrame* frame = current_call; frame != nullptr; frame = frame->previous) {
+        if (frame->entry == entry) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+MAVLinkMessageHandler::MAVLinkMessageHandler() : _table(new Table{}) {}
+
+MAVLinkMessageHandler::~MAVLinkMessageHandler()
+{
+    delete _table.load();
+}
+
 void MAVLinkMessageHandler::register_one(uint16_t msg_id, Callback callback, const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    Entry entry = {msg_id, callback, cookie};
-    _table.push_back(entry);
+    auto new_table = std::make_unique<Table>(*_table.load());
+
+    auto& page = (*new_table)[msg_id / PAGE_SIZE];
+    auto new_page = page ? std::make_shared<Page>(*page) : std::make_shared<Page>();
+    (*new_page)[msg_id % PAGE_SIZE].push_back(
+        std::make_shared<Entry>(msg_id, std::move(callback), cookie));
+    page = std::move(new_page);
+
+    replace_table(std::move(new_table));
 }
 
 void MAVLinkMessageHandler::unregister_one(uint16_t msg_id, const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-
-    for (auto it = _table.begin(); it != _table.end();
-         /* no ++it */) {
-        if (it->msg_id == msg_id && it->cookie == cookie) {
-            it = _table.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    unregister_if([msg_id, cookie](const Entry& entry) {
+        return entry.msg_id == msg_id && entry.cookie == cookie;
+    });
 }
 
 void MAVLinkMessageHandler::unregister_all(const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    unregister_if([cookie](const Entry& entry) { return entry.cookie == cookie; });
+}
+
+void MAVLinkMessageHandler::unregister_if(const std::function<bool(const Entry&)>& should_remove)
+{
+    std::vector<std::shared_ptr<Entry>> removed;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto new_table = std::make_unique<Table>(*_table.load());
+
+        for (auto& page : *new_table) {
+            if (!page) {
+                continue;
+            }
+
+            std::shared_ptr<Page> new_page;
+            for (unsigned i = 0; i < PAGE_SIZE; ++i) {
+                const auto& subscribers = (*page)[i];
+                for (const auto& entry : subscribers) {
+                    if (!should_remove(*entry)) {
+                        continue;
+                    }
+                    if (!new_page) {
+                        new_page = std::make_shared<Page>(*page);
+                    }
+                    auto& new_subscribers = (*new_page)[i];
+                    new_subscribers.erase(
+                        std::find(new_subscribers.begin(), new_subscribers.end(), entry));
+                    removed.push_back(entry);
+                }
+            }
+
+            if (new_page) {
+                page = std::move(new_page);
+            }
+        }
 
-    for (auto it = _table.begin(); it != _table.end();
-         /* no ++it */) {
-        if (it->cookie == cookie) {
-            it = _table.erase(it);
-        } else {
-            ++it;
+        if (removed.empty()) {
+            return;
         }
+
+        for (auto& entry : removed) {
+            entry->active = false;
+        }
+
+        replace_table(std::move(new_table));
+    }
+
+    // Callbacks which are already running need to finish before we return,
+    // otherwise the owner of the cookie could be gone by the time they do.
+    // We can't hold the lock for that because they might (un)register too.
+    for (const auto& entry : removed) {
+        wait_for_calls_to_finish(*entry);
     }
 }
 
 void MAVLinkMessageHandler::process_message(const mavlink_message_t& message)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    // msg_id is only 16 bits when registering.
+    if (message.msgid > UINT16_MAX) {
+        return;
+    }
+
+    ++_dispatching;
+
+    const Table& table = *_table.load();
+    const auto& page = table[message.msgid / PAGE_SIZE];
 
 #if MESSAGE_DEBUGGING == 1
     bool forwarded = false;
 #endif
-    for (auto it = _table.begin(); it != _table.end(); ++it) {
-        if (it->msg_id == message.msgid) {
+    if (page) {
+        for (const auto& entry : (*page)[message.msgid % PAGE_SIZE]) {
 #if MESSAGE_DEBUGGING == 1
-            LogDebug() << "Forwarding msg " << int(message.msgid) << " to " << size_t(it->cookie);
+            LogDebug() << "Forwarding msg " << int(message.msgid) << " to "
+                       << size_t(entry->cookie);
             forwarded = true;
 #endif
-            it->callback(message);
+            call(*entry, message);
         }
     }
 
@@ -61,6 +150,58 @@ void MAVLinkMessageHandler::process_message(const mavlink_message_t& message)
         LogDebug() << "Ignoring msg " << int(message.msgid);
     }
 #endif
+
+    if (--_dispatching == 0 && _has_retired_tables) {
+        // Only clean up if that doesn't keep us waiting.
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            free_retired_tables();
+        }
+    }
+}
+
+void MAVLinkMessageHandler::call(Entry& entry, const mavlink_message_t& message)
+{
+    if (!entry.active) {
+        return;
+    }
+
+    // Announce the call before checking again, so an unregister either
+    // prevents it or waits for it.
+    ++entry.calls_in_progress;
+    if (entry.active) {
+        const CallFrame frame{&entry, current_call};
+        current_call = &frame;
+        entry.callback(message);
+        current_call = frame.previous;
+    }
+    --entry.calls_in_progress;
+}
+
+void MAVLinkMessageHandler::wait_for_calls_to_finish(const Entry& entry)
+{
+    const unsigned own_calls = calls_on_this_thread(&entry);
+    while (entry.calls_in_progress > own_calls) {
+        std::this_thread::yield();
+    }
+}
+
+void MAVLinkMessageHandler::replace_table(std::unique_ptr<const Table> new_table)
+{
+    // Needs to be called with _mutex locked.
+    _retired_tables.emplace_back(_table.exchange(new_table.release()));
+    _has_retired_tables = true;
+    free_retired_tables();
+}
+
+void MAVLinkMessageHandler::free_retired_tables()
+{
+    // Needs to be called with _mutex locked.
+    // Anyone starting to dispatch from now on can only see the latest table.
+    if (_dispatching == 0) {
+        _retired_tables.clear();
+        _has_retired_tables = false;
+    }
 }
 
 } // namespace mavsdk
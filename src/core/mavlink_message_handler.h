@@ -1,31 +1,79 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include "mavlink_include.h"
 
 namespace mavsdk {
 
+// The callbacks are kept in a table indexed by msgid which is never modified
+// but replaced as a whole whenever a callback is (un)registered. Therefore,
+// process_message does not need to take a lock, and callbacks are allowed
+// to register or unregister callbacks themselves.
 class MAVLinkMessageHandler {
 public:
     using Callback = std::function<void(const mavlink_message_t&)>;
 
-    struct Entry {
-        uint16_t msg_id;
-        Callback callback;
-        const void* cookie; // This is the identification to unregister.
-    };
+    MAVLinkMessageHandler();
+    ~MAVLinkMessageHandler();
 
     void register_one(uint16_t msg_id, Callback callback, const void* cookie);
     void unregister_one(uint16_t msg_id, const void* cookie);
     void unregister_all(const void* cookie);
     void process_message(const mavlink_message_t& message);
 
+    // Non-copyable
+    MAVLinkMessageHandler(const MAVLinkMessageHandler&) = delete;
+    const MAVLinkMessageHandler& operator=(const MAVLinkMessageHandler&) = delete;
+
 private:
+    struct Entry {
+        Entry(uint16_t msg_id_, Callback callback_, const void* cookie_) :
+            msg_id(msg_id_),
+            callback(std::move(callback_)),
+            cookie(cookie_)
+        {}
+
+        // Non-copyable
+        Entry(const Entry&) = delete;
+        const Entry& operator=(const Entry&) = delete;
+
+        const uint16_t msg_id;
+        const Callback callback;
+        const void* const cookie; // This is the identification to unregister.
+
+        // Once unregistered, an entry is not called anymore even if it is still
+        // part of a table which is currently being dispatched.
+        std::atomic<bool> active{true};
+        std::atomic<unsigned> calls_in_progress{0};
+    };
+
+    // The table is split into pages of msgids which are only allocated
+    // when used, and shared between table versions if unchanged.
+    static constexpr unsigned PAGE_SIZE = 256;
+    using Subscribers = std::vector<std::shared_ptr<Entry>>;
+    using Page = std::array<Subscribers, PAGE_SIZE>;
+    using Table = std::array<std::shared_ptr<const Page>, (UINT16_MAX + 1) / PAGE_SIZE>;
+
+    void unregister_if(const std::function<bool(const Entry&)>& should_remove);
+    void replace_table(std::unique_ptr<const Table> new_table);
+    void free_retired_tables();
+    void call(Entry& entry, const mavlink_message_t& message);
+    static void wait_for_calls_to_finish(const Entry& entry);
+
+    // Only used to serialize changes to the table.
     std::mutex _mutex{};
-    std::vector<Entry> _table{};
+    std::atomic<const Table*> _table{nullptr};
+
+    // Replaced tables can only be freed once nobody dispatches anymore.
+    std::atomic<unsigned> _dispatching{0};
+    std::vector<std::unique_ptr<const Table>> _retired_tables{};
+    std::atomic<bool> _has_retired_tables{false};
 };
 
 } // namespace mavsdk
@@ -0,0 +1,151 @@
+#include "mavlink_message_handler.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+using namespace mavsdk;
+
+namespace {
+
+mavlink_message_t message_with_id(uint32_t msgid)
+{
+    mavlink_message_t message{};
+    message.msgid = msgid;
+    return message;
+}
+
+} // namespace
+
+TEST(MAVLinkMessageHandler, OnlyMatchingMsgIdIsCalled)
+{
+    MAVLinkMessageHandler handler;
+
+    unsigned heartbeats = 0;
+    unsigned attitudes = 0;
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT, [&](const mavlink_message_t&) { ++heartbeats; }, this);
+    handler.register_one(
+        MAVLINK_MSG_ID_ATTITUDE, [&](const mavlink_message_t&) { ++attitudes; }, this);
+
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_ATTITUDE));
+    handler.process_message(message_with_id(1234));
+    handler.process_message(message_with_id(0x10000 + MAVLINK_MSG_ID_ATTITUDE));
+
+    EXPECT_EQ(heartbeats, 2);
+    EXPECT_EQ(attitudes, 1);
+}
+
+TEST(MAVLinkMessageHandler, Unregister)
+{
+    MAVLinkMessageHandler handler;
+
+    int cookie1 = 0;
+    int cookie2 = 0;
+    unsigned calls1 = 0;
+    unsigned calls2 = 0;
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT, [&](const mavlink_message_t&) { ++calls1; }, &cookie1);
+    handler.register_one(
+        MAVLINK_MSG_ID_ATTITUDE, [&](const mavlink_message_t&) { ++calls1; }, &cookie1);
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT, [&](const mavlink_message_t&) { ++calls2; }, &cookie2);
+
+    handler.unregister_one(MAVLINK_MSG_ID_HEARTBEAT, &cookie1);
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_ATTITUDE));
+    EXPECT_EQ(calls1, 1);
+    EXPECT_EQ(calls2, 1);
+
+    handler.unregister_all(&cookie1);
+    handler.unregister_all(&cookie2);
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_ATTITUDE));
+    EXPECT_EQ(calls1, 1);
+    EXPECT_EQ(calls2, 1);
+}
+
+TEST(MAVLinkMessageHandler, RegisterAndUnregisterFromCallback)
+{
+    MAVLinkMessageHandler handler;
+
+    int cookie1 = 0;
+    int cookie2 = 0;
+    unsigned calls1 = 0;
+    unsigned calls2 = 0;
+
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT,
+        [&](const mavlink_message_t&) {
+            ++calls1;
+            // Replace ourselves with another callback.
+            handler.unregister_all(&cookie1);
+            handler.register_one(
+                MAVLINK_MSG_ID_HEARTBEAT, [&](const mavlink_message_t&) { ++calls2; }, &cookie2);
+        },
+        &cookie1);
+
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    EXPECT_EQ(calls1, 1);
+    EXPECT_EQ(calls2, 0);
+
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    EXPECT_EQ(calls1, 1);
+    EXPECT_EQ(calls2, 1);
+}
+
+TEST(MAVLinkMessageHandler, UnregisteredDuringDispatchIsNotCalled)
+{
+    MAVLinkMessageHandler handler;
+
+    int cookie1 = 0;
+    int cookie2 = 0;
+    unsigned calls2 = 0;
+
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT,
+        [&](const mavlink_message_t&) { handler.unregister_all(&cookie2); },
+        &cookie1);
+    handler.register_one(
+        MAVLINK_MSG_ID_HEARTBEAT, [&](const mavlink_message_t&) { ++calls2; }, &cookie2);
+
+    handler.process_message(message_with_id(MAVLINK_MSG_ID_HEARTBEAT));
+    EXPECT_EQ(calls2, 0);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare the dispatch cost with
+// different numbers of registered callbacks.
+TEST(MAVLinkMessageHandler, DISABLED_DispatchBenchmark)
+{
+    constexpr unsigned num_messages = 1000000;
+
+    for (unsigned num_handlers : {1u, 10u, 100u, 1000u}) {
+        MAVLinkMessageHandler handler;
+
+        unsigned calls = 0;
+        // Only one of the callbacks is for the message we dispatch, as usual.
+        for (unsigned i = 0; i < num_handlers; ++i) {
+            handler.register_one(
+                uint16_t(MAVLINK_MSG_ID_ATTITUDE + 1 + i),
+                [&calls](const mavlink_message_t&) { ++calls; },
+                &handler);
+        }
+        handler.register_one(
+            MAVLINK_MSG_ID_ATTITUDE, [&calls](const mavlink_message_t&) { ++calls; }, &handler);
+
+        const auto message = message_with_id(MAVLINK_MSG_ID_ATTITUDE);
+
+        const auto before = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < num_messages; ++i) {
+            handler.process_message(message);
+        }
+        const auto after = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(calls, num_messages);
+        std::cout << num_handlers << " handlers: "
+                  << std::chrono::duration<double, std::nano>(after - before).count() /
+                         num_messages
+                  << " ns per message" << std::endl;
+    }
+}
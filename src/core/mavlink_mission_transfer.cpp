@@ -1,14 +1,19 @@
 #include <algorithm>
 #include "mavlink_mission_transfer.h"
 #include "log.h"
+#include "rtt_estimator.h"
 
 namespace mavsdk {
 
 MAVLinkMissionTransfer::MAVLinkMissionTransfer(
-    Sender& sender, MAVLinkMessageHandler& message_handler, TimeoutHandler& timeout_handler) :
+    Sender& sender,
+    MAVLinkMessageHandler& message_handler,
+    TimeoutHandler& timeout_handler,
+    TimeoutSCallback timeout_s_callback) :
     _sender(sender),
     _message_handler(message_handler),
-    _timeout_handler(timeout_handler)
+    _timeout_handler(timeout_handler),
+    _timeout_s_callback(std::move(timeout_s_callback))
 {}
 
 MAVLinkMissionTransfer::~MAVLinkMissionTransfer() {}
@@ -17,7 +22,18 @@ std::weak_ptr<MAVLinkMissionTransfer::WorkItem> MAVLinkMissionTransfer::upload_i
     uint8_t type, const std::vector<ItemInt>& items, ResultCallback callback)
 {
     auto ptr = std::make_shared<UploadWorkItem>(
-        _sender, _message_handler, _timeout_handler, type, items, callback);
+        _sender,
+        _message_handler,
+        _timeout_handler,
+        item_timeout_s(),
+        type,
+        items,
+        [this, callback](Result result) {
+            if (callback) {
+                callback(result);
+            }
+            wake_up();
+        });
 
     _work_queue.push_back(ptr);
 
@@ -28,7 +44,17 @@ std::weak_ptr<MAVLinkMissionTransfer::WorkItem>
 MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndItemsCallback callback)
 {
     auto ptr = std::make_shared<DownloadWorkItem>(
-        _sender, _message_handler, _timeout_handler, type, callback);
+        _sender,
+        _message_handler,
+        _timeout_handler,
+        item_timeout_s(),
+        type,
+        [this, callback](Result result, std::vector<ItemInt> items) {
+            if (callback) {
+                callback(result, std::move(items));
+            }
+            wake_up();
+        });
 
     _work_queue.push_back(ptr);
 
@@ -38,7 +64,17 @@ MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndItemsCallbac
 void MAVLinkMissionTransfer::clear_items_async(uint8_t type, ResultCallback callback)
 {
     auto ptr = std::make_shared<ClearWorkItem>(
-        _sender, _message_handler, _timeout_handler, type, callback);
+        _sender,
+        _message_handler,
+        _timeout_handler,
+        item_timeout_s(),
+        type,
+        [this, callback](Result result) {
+            if (callback) {
+                callback(result);
+            }
+            wake_up();
+        });
 
     _work_queue.push_back(ptr);
 }
@@ -46,11 +82,41 @@ void MAVLinkMissionTransfer::clear_items_async(uint8_t type, ResultCallback call
 void MAVLinkMissionTransfer::set_current_item_async(int current, ResultCallback callback)
 {
     auto ptr = std::make_shared<SetCurrentWorkItem>(
-        _sender, _message_handler, _timeout_handler, current, callback);
+        _sender,
+        _message_handler,
+        _timeout_handler,
+        item_timeout_s(),
+        current,
+        [this, callback](Result result) {
+            if (callback) {
+                callback(result);
+            }
+            wake_up();
+        });
 
     _work_queue.push_back(ptr);
 }
 
+void MAVLinkMissionTransfer::set_wakeup_callback(std::function<void()> callback)
+{
+    _wakeup_callback = callback;
+    _work_queue.set_wakeup_callback(std::move(callback));
+}
+
+void MAVLinkMissionTransfer::wake_up()
+{
+    // The work items call back when they are done, so we need to come
+    // around once more to remove them from the queue.
+    if (_wakeup_callback) {
+        _wakeup_callback();
+    }
+}
+
+double MAVLinkMissionTransfer::item_timeout_s() const
+{
+    return _timeout_s_callback ? _timeout_s_callback(timeout_s) : timeout_s;
+}
+
 void MAVLinkMissionTransfer::do_work()
 {
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
@@ -78,10 +144,12 @@ MAVLinkMissionTransfer::WorkItem::WorkItem(
     Sender& sender,
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
+    double retry_timeout_s,
     uint8_t type) :
     _sender(sender),
     _message_handler(message_handler),
     _timeout_handler(timeout_handler),
+    _timeout_s(retry_timeout_s),
     _type(type)
 {}
 
@@ -103,10 +171,11 @@ MAVLinkMissionTransfer::UploadWorkItem::UploadWorkItem(
     Sender& sender,
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
+    double retry_timeout_s,
     uint8_t type,
     const std::vector<ItemInt>& items,
     ResultCallback callback) :
-    WorkItem(sender, message_handler, timeout_handler, type),
+    WorkItem(sender, message_handler, timeout_handler, retry_timeout_s, type),
     _items(items),
     _callback(callback)
 {
@@ -171,7 +240,7 @@ void MAVLinkMissionTransfer::UploadWorkItem::start()
 
     _retries_done = 0;
     _step = Step::SendCount;
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
 
     _next_sequence = 0;
 
@@ -395,9 +464,12 @@ void MAVLinkMissionTransfer::UploadWorkItem::process_timeout()
         return;
     }
 
+    // Wait twice as long for the retransmission, in case the link is slower than expected.
+    _timeout_s = RttEstimator::backed_off_s(_timeout_s);
+
     switch (_step) {
         case Step::SendCount:
-            _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+            _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
             send_count();
             break;
 
@@ -420,9 +492,10 @@ MAVLinkMissionTransfer::DownloadWorkItem::DownloadWorkItem(
     Sender& sender,
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
+    double retry_timeout_s,
     uint8_t type,
     ResultAndItemsCallback callback) :
-    WorkItem(sender, message_handler, timeout_handler, type),
+    WorkItem(sender, message_handler, timeout_handler, retry_timeout_s, type),
     _callback(callback)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -453,7 +526,7 @@ void MAVLinkMissionTransfer::DownloadWorkItem::start()
     _items.clear();
     _started = true;
     _retries_done = 0;
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
     request_list();
 }
 
@@ -615,14 +688,17 @@ void MAVLinkMissionTransfer::DownloadWorkItem::process_timeout()
         return;
     }
 
+    // Wait twice as long for the retransmission, in case the link is slower than expected.
+    _timeout_s = RttEstimator::backed_off_s(_timeout_s);
+
     switch (_step) {
         case Step::RequestList:
-            _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+            _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
             request_list();
             break;
 
         case Step::RequestItem:
-            _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+            _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
             request_item();
             break;
     }
@@ -641,9 +717,10 @@ MAVLinkMissionTransfer::ClearWorkItem::ClearWorkItem(
     Sender& sender,
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
+    double retry_timeout_s,
     uint8_t type,
     ResultCallback callback) :
-    WorkItem(sender, message_handler, timeout_handler, type),
+    WorkItem(sender, message_handler, timeout_handler, retry_timeout_s, type),
     _callback(callback)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -668,7 +745,7 @@ void MAVLinkMissionTransfer::ClearWorkItem::start()
 
     _started = true;
     _retries_done = 0;
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
     send_clear();
 }
 
@@ -709,7 +786,10 @@ void MAVLinkMissionTransfer::ClearWorkItem::process_timeout()
         return;
     }
 
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    // Wait twice as long for the retransmission, in case the link is slower than expected.
+    _timeout_s = RttEstimator::backed_off_s(_timeout_s);
+
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
     send_clear();
 }
 
@@ -780,9 +860,10 @@ MAVLinkMissionTransfer::SetCurrentWorkItem::SetCurrentWorkItem(
     Sender& sender,
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
+    double retry_timeout_s,
     int current,
     ResultCallback callback) :
-    WorkItem(sender, message_handler, timeout_handler, MAV_MISSION_TYPE_MISSION),
+    WorkItem(sender, message_handler, timeout_handler, retry_timeout_s, MAV_MISSION_TYPE_MISSION),
     _current(current),
     _callback(callback)
 {
@@ -814,7 +895,7 @@ void MAVLinkMissionTransfer::SetCurrentWorkItem::start()
     }
 
     _retries_done = 0;
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
     send_current_mission_item();
 }
 
@@ -876,7 +957,10 @@ void MAVLinkMissionTransfer::SetCurrentWorkItem::process_timeout()
         return;
     }
 
-    _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
+    // Wait twice as long for the retransmission, in case the link is slower than expected.
+    _timeout_s = RttEstimator::backed_off_s(_timeout_s);
+
+    _timeout_handler.add([this]() { process_timeout(); }, _timeout_s, &_cookie);
     send_current_mission_item();
 }
 
@@ -80,6 +80,7 @@ public:
             Sender& sender,
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
+            double retry_timeout_s,
             uint8_t type);
         virtual ~WorkItem();
         virtual void start() = 0;
@@ -96,6 +97,7 @@ public:
         Sender& _sender;
         MAVLinkMessageHandler& _message_handler;
         TimeoutHandler& _timeout_handler;
+        double _timeout_s;
         uint8_t _type;
         bool _started{false};
         bool _done{false};
@@ -108,6 +110,7 @@ public:
             Sender& sender,
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
+            double retry_timeout_s,
             uint8_t type,
             const std::vector<ItemInt>& items,
             ResultCallback callback);
@@ -150,6 +153,7 @@ public:
             Sender& sender,
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
+            double retry_timeout_s,
             uint8_t type,
             ResultAndItemsCallback callback);
 
@@ -191,6 +195,7 @@ public:
             Sender& sender,
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
+            double retry_timeout_s,
             uint8_t type,
             ResultCallback callback);
 
@@ -220,6 +225,7 @@ public:
             Sender& sender,
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
+            double retry_timeout_s,
             int current,
             ResultCallback callback);
 
@@ -245,11 +251,19 @@ public:
         unsigned _retries_done{0};
     };
 
+    // Used as long as the timeout callback doesn't say otherwise.
     static constexpr double timeout_s = 0.5;
     static constexpr unsigned retries = 4;
 
+    // Returns the timeout to use, given the default one, e.g. based on the
+    // measured round trip time.
+    using TimeoutSCallback = std::function<double(double default_s)>;
+
     MAVLinkMissionTransfer(
-        Sender& sender, MAVLinkMessageHandler& message_handler, TimeoutHandler& timeout_handler);
+        Sender& sender,
+        MAVLinkMessageHandler& message_handler,
+        TimeoutHandler& timeout_handler,
+        TimeoutSCallback timeout_s_callback = nullptr);
 
     ~MAVLinkMissionTransfer();
 
@@ -263,6 +277,8 @@ public:
     void set_current_item_async(int current, ResultCallback callback);
 
     void do_work();
+    // Called whenever do_work() has something new to do.
+    void set_wakeup_callback(std::function<void()> callback);
     bool is_idle();
 
     // Non-copyable
@@ -270,11 +286,16 @@ public:
     const MAVLinkMissionTransfer& operator=(const MAVLinkMissionTransfer&) = delete;
 
 private:
+    void wake_up();
+    double item_timeout_s() const;
+
     Sender& _sender;
     MAVLinkMessageHandler& _message_handler;
     TimeoutHandler& _timeout_handler;
+    TimeoutSCallback _timeout_s_callback;
 
     LockedQueue<WorkItem> _work_queue{};
+    std::function<void()> _wakeup_callback{nullptr};
 };
 
 } // namespace mavsdk
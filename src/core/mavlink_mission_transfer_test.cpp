@@ -6,6 +6,7 @@
 #include "global_include.h"
 #include "mavlink_mission_transfer.h"
 #include "mocks/sender_mock.h"
+#include "rtt_estimator.h"
 
 using namespace mavsdk;
 
@@ -21,6 +22,10 @@ using ItemInt = MAVLinkMissionTransfer::ItemInt;
 static MAVLinkAddress own_address{42, 16};
 static MAVLinkAddress target_address{99, 101};
 
+// Long enough for the next retransmission, however often the timeout has been doubled.
+static const auto until_next_retransmission = std::chrono::milliseconds(
+    static_cast<int>(RttEstimator::MAX_BACKOFF_TIMEOUT_S * 1.1 * 1000.));
+
 #define ONCE_ONLY \
     static bool called = false; \
     EXPECT_FALSE(called); \
@@ -369,6 +374,84 @@ TEST(MAVLinkMissionTransfer, UploadMissionResendsCount)
     timeout_handler.run_once();
 }
 
+TEST(MAVLinkMissionTransfer, UploadMissionResendsCountWithBackoff)
+{
+    MockSender mock_sender(own_address, target_address);
+    MAVLinkMessageHandler message_handler;
+    FakeTime time;
+    TimeoutHandler timeout_handler(time);
+
+    MAVLinkMissionTransfer mmt(mock_sender, message_handler, timeout_handler);
+
+    std::vector<ItemInt> items;
+    items.push_back(make_item(MAV_MISSION_TYPE_FENCE, 0));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+
+    EXPECT_CALL(mock_sender, send_message(Truly([&items](const mavlink_message_t& message) {
+                    return is_correct_mission_send_count(
+                        MAV_MISSION_TYPE_FENCE, items.size(), message);
+                })))
+        .Times(3);
+
+    mmt.upload_items_async(MAV_MISSION_TYPE_FENCE, items, [](Result result) {
+        UNUSED(result);
+        EXPECT_TRUE(false);
+    });
+    mmt.do_work();
+
+    // The first retransmission after the timeout.
+    time.sleep_for(std::chrono::milliseconds(
+        static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+
+    // The second one only after twice the timeout.
+    time.sleep_for(std::chrono::milliseconds(
+        static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+
+    time.sleep_for(std::chrono::milliseconds(
+        static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+}
+
+TEST(MAVLinkMissionTransfer, UploadMissionResendsCountAfterTimeoutFromCallback)
+{
+    MockSender mock_sender(own_address, target_address);
+    MAVLinkMessageHandler message_handler;
+    FakeTime time;
+    TimeoutHandler timeout_handler(time);
+
+    // E.g. a fast link, where we don't have to wait as long as by default.
+    const double fast_timeout_s = MAVLinkMissionTransfer::timeout_s / 5.0;
+    MAVLinkMissionTransfer mmt(
+        mock_sender, message_handler, timeout_handler, [fast_timeout_s](double default_s) {
+            UNUSED(default_s);
+            return fast_timeout_s;
+        });
+
+    std::vector<ItemInt> items;
+    items.push_back(make_item(MAV_MISSION_TYPE_FENCE, 0));
+    items.push_back(make_item(MAV_MISSION_TYPE_FENCE, 1));
+
+    ON_CALL(mock_sender, send_message(_)).WillByDefault(Return(true));
+
+    EXPECT_CALL(mock_sender, send_message(Truly([&items](const mavlink_message_t& message) {
+                    return is_correct_mission_send_count(
+                        MAV_MISSION_TYPE_FENCE, items.size(), message);
+                })))
+        .Times(2);
+
+    mmt.upload_items_async(MAV_MISSION_TYPE_FENCE, items, [](Result result) {
+        UNUSED(result);
+        EXPECT_TRUE(false);
+    });
+    mmt.do_work();
+
+    time.sleep_for(std::chrono::milliseconds(static_cast<int>(fast_timeout_s * 1.1 * 1000.)));
+    timeout_handler.run_once();
+}
+
 TEST(MAVLinkMissionTransfer, UploadMissionTimeoutAfterSendCount)
 {
     MockSender mock_sender(own_address, target_address);
@@ -404,8 +487,7 @@ TEST(MAVLinkMissionTransfer, UploadMissionTimeoutAfterSendCount)
 
     // After the specified retries we should give up with a timeout.
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1094,8 +1176,7 @@ TEST(MAVLinkMissionTransfer, DownloadMissionResendsRequestListButGivesUpAfterSom
     EXPECT_EQ(fut.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
 
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1201,8 +1282,7 @@ TEST(MAVLinkMissionTransfer, DownloadMissionResendsMissionRequestsAndTimesOutEve
 
     // After the specified retries we should give up with a timeout.
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1329,8 +1409,7 @@ TEST(MAVLinkMissionTransfer, DownloadMissionResendsRequestItemAgainForSecondItem
     message_handler.process_message(make_mission_count(items.size()));
 
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries - 2; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1343,8 +1422,7 @@ TEST(MAVLinkMissionTransfer, DownloadMissionResendsRequestItemAgainForSecondItem
     message_handler.process_message(make_mission_item(items, 0));
 
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1624,8 +1702,7 @@ TEST(MAVLinkMissionTransfer, SetCurrentWithRetransmissionAndTimeout)
     mmt.do_work();
 
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
@@ -1661,8 +1738,7 @@ TEST(MAVLinkMissionTransfer, SetCurrentWithRetransmissionAndSuccess)
     mmt.do_work();
 
     for (unsigned i = 0; i < MAVLinkMissionTransfer::retries - 2; ++i) {
-        time.sleep_for(std::chrono::milliseconds(
-            static_cast<int>(MAVLinkMissionTransfer::timeout_s * 1.1 * 1000.)));
+        time.sleep_for(until_next_retransmission);
         timeout_handler.run_once();
     }
 
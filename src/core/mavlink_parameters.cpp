@@ -1,11 +1,28 @@
 #include "mavlink_parameters.h"
+#include "param_cache.h"
 #include "system_impl.h"
+#include <algorithm>
 #include <cstring>
 #include <future>
 
 namespace mavsdk {
 
-MAVLinkParameters::MAVLinkParameters(SystemImpl& parent) : _parent(parent)
+namespace {
+
+// PX4 answers a request for this param with a hash over the current param set.
+constexpr const char* HASH_CHECK_PARAM = "_HASH_CHECK";
+
+const ParamId& hash_check_param_id()
+{
+    static const ParamId param_id{std::string(HASH_CHECK_PARAM)};
+    return param_id;
+}
+
+} // namespace
+
+MAVLinkParameters::MAVLinkParameters(SystemImpl& parent) :
+    _parent(parent),
+    _param_cache(std::make_unique<ParamCache>(ParamCache::directory_from_env()))
 {
     _parent.register_mavlink_message_handler(
         MAVLINK_MSG_ID_PARAM_VALUE,
@@ -52,7 +69,7 @@ void MAVLinkParameters::set_param_async(
     auto new_work = std::make_shared<WorkItem>();
     new_work->type = WorkItem::Type::Set;
     new_work->set_param_callback = callback;
-    new_work->param_name = name;
+    new_work->param_id = ParamId(name);
     new_work->param_value = value;
     new_work->extended = extended;
     new_work->cookie = cookie;
@@ -94,7 +111,7 @@ void MAVLinkParameters::get_param_async(
     auto new_work = std::make_shared<WorkItem>();
     new_work->type = WorkItem::Type::Get;
     new_work->get_param_callback = callback;
-    new_work->param_name = name;
+    new_work->param_id = ParamId(name);
     new_work->param_value = value_type;
     new_work->extended = extended;
     new_work->cookie = cookie;
@@ -121,11 +138,70 @@ MAVLinkParameters::get_param(const std::string& name, ParamValue value_type, boo
 }
 
 void MAVLinkParameters::get_all_params_async(get_all_params_callback_t callback)
+{
+    const uint64_t uuid = _parent.get_uuid();
+    if (!_param_cache->enabled() || uuid == 0) {
+        request_all_params(callback, false, 0);
+        return;
+    }
+
+    // Ask for the hash first, and only download all params if it doesn't match the cache.
+    // If the params change during the download, the stored hash is outdated and the next
+    // call downloads them again, which is what we want.
+    ParamValue hash_type;
+    hash_type.set<int32_t>(0);
+
+    get_param_async(
+        HASH_CHECK_PARAM,
+        hash_type,
+        [this, callback, uuid](Result result, ParamValue value) {
+            if (result != Result::Success) {
+                LogDebug() << "No param hash, not using the param cache.";
+                request_all_params(callback, false, 0);
+                return;
+            }
+
+            const auto hash = static_cast<uint32_t>(value.get<int32_t>());
+
+            uint32_t cached_hash = 0;
+            ParamSet cached_params;
+            if (_param_cache->load(uuid, cached_hash, cached_params) && cached_hash == hash) {
+                LogDebug() << "Param hash unchanged, using " << cached_params.size()
+                           << " cached params.";
+                callback(cached_params);
+                return;
+            }
+
+            request_all_params(callback, true, hash);
+        },
+        this);
+}
+
+void MAVLinkParameters::request_all_params(
+    get_all_params_callback_t callback, bool store_in_cache, uint32_t hash)
 {
     _all_param_store = std::make_shared<AllParameters>();
 
     _all_param_store->callback = callback;
+    _all_param_store->store_in_cache = store_in_cache;
+    _all_param_store->uuid = _parent.get_uuid();
+    _all_param_store->hash = hash;
 
+    if (!send_param_request_list()) {
+        LogErr() << "Failed to send param list request!";
+        callback(ParamSet{});
+        _all_param_store = nullptr;
+        return;
+    }
+
+    _parent.register_timeout_handler(
+        std::bind(&MAVLinkParameters::receive_all_params_timeout, this),
+        all_params_timeout_s(),
+        &_all_param_store->timeout_cookie);
+}
+
+bool MAVLinkParameters::send_param_request_list()
+{
     mavlink_message_t msg;
 
     mavlink_msg_param_request_list_pack(
@@ -135,26 +211,100 @@ void MAVLinkParameters::get_all_params_async(get_all_params_callback_t callback)
         _parent.get_system_id(),
         _parent.get_autopilot_id());
 
-    if (!_parent.send_message(msg)) {
-        LogErr() << "Failed to send param list request!";
-        callback(std::map<std::string, ParamValue>{});
-        _all_param_store = nullptr;
+    return _parent.send_message(msg);
+}
+
+double MAVLinkParameters::all_params_timeout_s()
+{
+    // Most of the time this waits for the next param of the list rather than for the answer to
+    // a request, so it must not get shorter than a gap the autopilot may leave in the list.
+    return std::max(
+        ALL_PARAMS_TIMEOUT_S, _parent.rtt_estimator().timeout_s(ALL_PARAMS_TIMEOUT_S));
+}
+
+double MAVLinkParameters::request_timeout_s(bool extended, double default_s)
+{
+    // The RTT is measured to the autopilot, the camera which extended params go to can take
+    // a lot longer to answer. So for it the default is kept as the minimum.
+    const double estimated_s = _parent.rtt_estimator().timeout_s(default_s);
+    return extended ? std::max(default_s, estimated_s) : estimated_s;
+}
+
+void MAVLinkParameters::request_missing_params(AllParameters& all_param_store)
+{
+    for (const auto index : all_param_store.indices.next_requests()) {
+        // An empty id means the param is requested by index.
+        char param_id[PARAM_ID_LEN] = {};
+
+        mavlink_message_t msg;
+        mavlink_msg_param_request_read_pack(
+            _parent.get_own_system_id(),
+            _parent.get_own_component_id(),
+            &msg,
+            _parent.get_system_id(),
+            _parent.get_autopilot_id(),
+            param_id,
+            static_cast<int16_t>(index));
+
+        if (!_parent.send_message(msg)) {
+            LogErr() << "Failed to send param request for index " << index;
+        }
+    }
+}
+
+void MAVLinkParameters::receive_all_params_timeout()
+{
+    std::unique_lock<std::mutex> lock(_all_param_mutex);
+
+    auto all_param_store = _all_param_store;
+    if (!all_param_store) {
+        return;
+    }
+
+    auto& indices = all_param_store->indices;
+
+    if (indices.received_count() > all_param_store->received_at_last_timeout) {
+        all_param_store->received_at_last_timeout = indices.received_count();
+        all_param_store->timeouts_without_progress = 0;
+    } else {
+        ++all_param_store->timeouts_without_progress;
+    }
+
+    if (all_param_store->timeouts_without_progress > MAX_ALL_PARAMS_TIMEOUTS) {
+        LogErr() << "Param list download timed out with " << indices.received_count() << " of "
+                 << indices.count() << " params";
+        _all_param_store = nullptr; // stop waiting, failed!
+        lock.unlock();
+        all_param_store->callback(ParamSet{});
+        return;
+    }
+
+    if (indices.count() == 0) {
+        // Not a single param has arrived, so either the request or the replies got lost.
+        LogWarn() << "No params received, requesting the list again";
+        if (!send_param_request_list()) {
+            LogErr() << "Failed to send param list request!";
+        }
+
+    } else {
+        // Either the end of the list or requests got lost, ask for whatever is still missing.
+        indices.set_stream_ended();
+        indices.set_requests_timed_out();
+        request_missing_params(*all_param_store);
     }
 
     _parent.register_timeout_handler(
-        std::bind(&MAVLinkParameters::receive_timeout, this),
-        1.0,
-        &_all_param_store->timeout_cookie);
+        std::bind(&MAVLinkParameters::receive_all_params_timeout, this),
+        all_params_timeout_s(),
+        &all_param_store->timeout_cookie);
 }
 
-std::map<std::string, MAVLinkParameters::ParamValue> MAVLinkParameters::get_all_params()
+MAVLinkParameters::ParamSet MAVLinkParameters::get_all_params()
 {
-    std::promise<std::map<std::string, ParamValue>> prom;
+    std::promise<ParamSet> prom;
     auto res = prom.get_future();
 
-    get_all_params_async([&prom](std::map<std::string, MAVLinkParameters::ParamValue> all_params) {
-        prom.set_value(all_params);
-    });
+    get_all_params_async([&prom](const ParamSet& all_params) { prom.set_value(all_params); });
 
     return res.get();
 }
@@ -178,22 +328,26 @@ void MAVLinkParameters::subscribe_param_changed(
     MAVLinkParameters::ParamChangedCallback callback,
     const void* cookie)
 {
+    if (name.size() > PARAM_ID_LEN) {
+        LogErr() << "Error: param name too long";
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_param_changed_subscriptions_mutex);
 
+    auto& subscriptions = _param_changed_subscriptions[ParamId(name)];
+
     if (callback != nullptr) {
         ParamChangedSubscription subscription{};
-        subscription.param_name = name;
         subscription.callback = callback;
         subscription.cookie = cookie;
         subscription.value_type = value_type;
-        _param_changed_subscriptions.push_back(subscription);
+        subscriptions.push_back(subscription);
 
     } else {
-        for (auto it = _param_changed_subscriptions.begin();
-             it != _param_changed_subscriptions.end();
-             /* ++it */) {
-            if (it->param_name.compare(name) == 0 && it->cookie == cookie) {
-                it = _param_changed_subscriptions.erase(it);
+        for (auto it = subscriptions.begin(); it != subscriptions.end(); /* ++it */) {
+            if (it->cookie == cookie) {
+                it = subscriptions.erase(it);
             } else {
                 ++it;
             }
@@ -201,6 +355,11 @@ void MAVLinkParameters::subscribe_param_changed(
     }
 }
 
+void MAVLinkParameters::set_wakeup_callback(std::function<void()> callback)
+{
+    _work_queue.set_wakeup_callback(std::move(callback));
+}
+
 void MAVLinkParameters::do_work()
 {
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
@@ -215,7 +374,7 @@ void MAVLinkParameters::do_work()
     }
 
     char param_id[PARAM_ID_LEN + 1] = {};
-    STRNCPY(param_id, work->param_name.c_str(), sizeof(param_id) - 1);
+    std::memcpy(param_id, work->param_id.data(), PARAM_ID_LEN);
 
     switch (work->type) {
         case WorkItem::Type::Set: {
@@ -258,6 +417,8 @@ void MAVLinkParameters::do_work()
             work->already_requested = true;
             // _last_request_time = _parent.get_time().steady_time();
 
+            work->timeout_s = request_timeout_s(work->extended, work->timeout_s);
+
             // We want to get notified if a timeout happens
             _parent.register_timeout_handler(
                 std::bind(&MAVLinkParameters::receive_timeout, this),
@@ -267,7 +428,7 @@ void MAVLinkParameters::do_work()
         } break;
 
         case WorkItem::Type::Get: {
-            // LogDebug() << "now getting: " << work->param_name;
+            // LogDebug() << "now getting: " << work->param_id.to_string();
             if (work->extended) {
                 mavlink_msg_param_ext_request_read_pack(
                     _parent.get_own_system_id(),
@@ -312,6 +473,8 @@ void MAVLinkParameters::do_work()
 
             // _last_request_time = _parent.get_time().steady_time();
 
+            work->timeout_s = request_timeout_s(work->extended, work->timeout_s);
+
             // We want to get notified if a timeout happens
             _parent.register_timeout_handler(
                 std::bind(&MAVLinkParameters::receive_timeout, this),
@@ -327,29 +490,12 @@ void MAVLinkParameters::process_param_value(const mavlink_message_t& message)
     mavlink_param_value_t param_value;
     mavlink_msg_param_value_decode(&message, &param_value);
 
-    // LogDebug() << "getting param value: " << extract_safe_param_id(param_value.param_id);
+    // LogDebug() << "getting param value: "
+    //            << ParamId::from_mavlink(param_value.param_id).to_string();
 
     // check if we are looking for param list
     if (_all_param_store) {
-        ParamValue value;
-        value.set_from_mavlink_param_value(param_value);
-
-        std::string param_id = extract_safe_param_id(param_value.param_id);
-
-        _all_param_store->all_params.insert(std::pair<std::string, ParamValue>(param_id, value));
-
-        if (param_value.param_index + 1 == param_value.param_count) {
-            _all_param_store->callback(_all_param_store->all_params);
-            _all_param_store = nullptr;
-        } else {
-            _parent.unregister_timeout_handler(_all_param_store->timeout_cookie);
-
-            _parent.register_timeout_handler(
-                std::bind(&MAVLinkParameters::receive_timeout, this),
-                1.0,
-                &_all_param_store->timeout_cookie);
-        }
-
+        process_all_params_value(param_value);
         return;
     }
 
@@ -366,7 +512,7 @@ void MAVLinkParameters::process_param_value(const mavlink_message_t& message)
         return;
     }
 
-    if (work->param_name.compare(extract_safe_param_id(param_value.param_id)) != 0) {
+    if (work->param_id != ParamId::from_mavlink(param_value.param_id)) {
         // No match, let's just return the borrowed work item.
         return;
     }
@@ -405,19 +551,69 @@ void MAVLinkParameters::process_param_value(const mavlink_message_t& message)
     }
 }
 
+void MAVLinkParameters::process_all_params_value(const mavlink_param_value_t& param_value)
+{
+    std::unique_lock<std::mutex> lock(_all_param_mutex);
+
+    auto all_param_store = _all_param_store;
+    if (!all_param_store) {
+        return;
+    }
+
+    auto& indices = all_param_store->indices;
+
+    if (indices.count() == 0) {
+        indices.reset(param_value.param_count);
+        all_param_store->all_params.reserve(param_value.param_count);
+    }
+
+    const auto param_id = ParamId::from_mavlink(param_value.param_id);
+
+    // The hash is not a param of its own, and has no valid index anyway.
+    if (param_id != hash_check_param_id() && indices.set_received(param_value.param_index)) {
+        ParamValue value;
+        value.set_from_mavlink_param_value(param_value);
+        all_param_store->all_params.set(param_id, value, param_value.param_index);
+    }
+
+    if (param_value.param_index + 1 == param_value.param_count) {
+        indices.set_stream_ended();
+    }
+
+    if (!indices.complete()) {
+        // Ask for params lost on the way while the rest of the list is still coming in.
+        request_missing_params(*all_param_store);
+        _parent.refresh_timeout_handler(all_param_store->timeout_cookie);
+        return;
+    }
+
+    _parent.unregister_timeout_handler(all_param_store->timeout_cookie);
+    _all_param_store = nullptr;
+    lock.unlock();
+
+    all_param_store->callback(all_param_store->all_params);
+
+    if (all_param_store->store_in_cache) {
+        _param_cache->store(
+            all_param_store->uuid, all_param_store->hash, all_param_store->all_params);
+    }
+}
+
 void MAVLinkParameters::notify_param_subscriptions(const mavlink_param_value_t& param_value)
 {
     std::lock_guard<std::mutex> lock(_param_changed_subscriptions_mutex);
 
-    for (const auto& subscription : _param_changed_subscriptions) {
-        if (subscription.param_name.compare(extract_safe_param_id(param_value.param_id)) != 0) {
-            continue;
-        }
+    const auto param_id = ParamId::from_mavlink(param_value.param_id);
+    const auto* subscriptions = _param_changed_subscriptions.find(param_id);
+    if (subscriptions == nullptr) {
+        return;
+    }
 
+    for (const auto& subscription : *subscriptions) {
         ParamValue value;
         value.set_from_mavlink_param_value(param_value);
         if (!subscription.value_type.is_same_type(value)) {
-            LogErr() << "Received wrong param type in subscription for " << subscription.param_name;
+            LogErr() << "Received wrong param type in subscription for " << param_id.to_string();
             continue;
         }
 
@@ -443,7 +639,7 @@ void MAVLinkParameters::process_param_ext_value(const mavlink_message_t& message
         return;
     }
 
-    if (work->param_name.compare(extract_safe_param_id(param_ext_value.param_id)) != 0) {
+    if (work->param_id != ParamId::from_mavlink(param_ext_value.param_id)) {
         return;
     }
 
@@ -457,7 +653,7 @@ void MAVLinkParameters::process_param_ext_value(const mavlink_message_t& message
                     work->get_param_callback(MAVLinkParameters::Result::Success, value);
                 }
             } else {
-                LogErr() << "Param types don't match for " << work->param_name;
+                LogErr() << "Param types don't match for " << work->param_id.to_string();
                 ParamValue no_value;
                 if (work->get_param_callback) {
                     work->get_param_callback(MAVLinkParameters::Result::WrongType, no_value);
@@ -495,7 +691,7 @@ void MAVLinkParameters::process_param_ext_ack(const mavlink_message_t& message)
     }
 
     // Now it still needs to match the param name
-    if (work->param_name.compare(extract_safe_param_id(param_ext_ack.param_id)) != 0) {
+    if (work->param_id != ParamId::from_mavlink(param_ext_ack.param_id)) {
         return;
     }
 
@@ -539,13 +735,6 @@ void MAVLinkParameters::process_param_ext_ack(const mavlink_message_t& message)
 
 void MAVLinkParameters::receive_timeout()
 {
-    // first check if we are waiting for param list response
-    if (_all_param_store) {
-        std::lock_guard<std::mutex> lock(_all_param_mutex);
-        _all_param_store->callback(std::map<std::string, ParamValue>{});
-        _all_param_store = nullptr; // stop waiting, failed!
-        return;
-    }
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
     auto work = work_queue_guard.get_front();
 
@@ -564,14 +753,16 @@ void MAVLinkParameters::receive_timeout()
             if (work->retries_to_do > 0) {
                 // We're not sure the command arrived, let's retransmit.
                 LogWarn() << "sending again, retries to do: " << work->retries_to_do << "  ("
-                          << work->param_name << ").";
+                          << work->param_id.to_string() << ").";
                 if (!_parent.send_message(work->mavlink_message)) {
-                    LogErr() << "connection send error in retransmit (" << work->param_name << ").";
+                    LogErr() << "connection send error in retransmit ("
+                             << work->param_id.to_string() << ").";
                     work_queue_guard.pop_front();
                     work->get_param_callback(
                         MAVLinkParameters::Result::ConnectionError, empty_value);
                 } else {
                     --work->retries_to_do;
+                    work->timeout_s = RttEstimator::backed_off_s(work->timeout_s);
                     _parent.register_timeout_handler(
                         std::bind(&MAVLinkParameters::receive_timeout, this),
                         work->timeout_s,
@@ -579,7 +770,8 @@ void MAVLinkParameters::receive_timeout()
                 }
             } else {
                 // We have tried retransmitting, giving up now.
-                LogErr() << "Error: Retrying failed get param busy timeout: " << work->param_name;
+                LogErr() << "Error: Retrying failed get param busy timeout: "
+                         << work->param_id.to_string();
 
                 work_queue_guard.pop_front();
 
@@ -590,13 +782,15 @@ void MAVLinkParameters::receive_timeout()
             if (work->retries_to_do > 0) {
                 // We're not sure the command arrived, let's retransmit.
                 LogWarn() << "sending again, retries to do: " << work->retries_to_do << "  ("
-                          << work->param_name << ").";
+                          << work->param_id.to_string() << ").";
                 if (!_parent.send_message(work->mavlink_message)) {
-                    LogErr() << "connection send error in retransmit (" << work->param_name << ").";
+                    LogErr() << "connection send error in retransmit ("
+                             << work->param_id.to_string() << ").";
                     work_queue_guard.pop_front();
                     work->set_param_callback(MAVLinkParameters::Result::ConnectionError);
                 } else {
                     --work->retries_to_do;
+                    work->timeout_s = RttEstimator::backed_off_s(work->timeout_s);
                     _parent.register_timeout_handler(
                         std::bind(&MAVLinkParameters::receive_timeout, this),
                         work->timeout_s,
@@ -604,7 +798,8 @@ void MAVLinkParameters::receive_timeout()
                 }
             } else {
                 // We have tried retransmitting, giving up now.
-                LogErr() << "Error: Retrying failed get param busy timeout: " << work->param_name;
+                LogErr() << "Error: Retrying failed get param busy timeout: "
+                         << work->param_id.to_string();
 
                 work_queue_guard.pop_front();
                 work->set_param_callback(MAVLinkParameters::Result::Timeout);
@@ -613,15 +808,6 @@ void MAVLinkParameters::receive_timeout()
     }
 }
 
-std::string MAVLinkParameters::extract_safe_param_id(const char param_id[])
-{
-    // The param_id field of the MAVLink struct has length 16 and is not 0 terminated.
-    // Therefore, we make a 0 terminated copy first.
-    char param_id_long_enough[PARAM_ID_LEN + 1] = {};
-    std::memcpy(param_id_long_enough, param_id, PARAM_ID_LEN);
-    return std::string(param_id_long_enough);
-}
-
 std::ostream& operator<<(std::ostream& strm, const MAVLinkParameters::ParamValue& obj)
 {
     strm << obj.get_string();
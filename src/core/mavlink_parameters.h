@@ -4,17 +4,21 @@
 #include "global_include.h"
 #include "mavlink_include.h"
 #include "locked_queue.h"
+#include "param_index_tracker.h"
+#include "param_store.h"
 #include <cstdint>
 #include <string>
 #include <functional>
 #include <cassert>
 #include <vector>
 #include <map>
+#include <memory>
 #include <variant>
 
 namespace mavsdk {
 
 class SystemImpl;
+class ParamCache;
 
 class MAVLinkParameters {
 public:
@@ -469,9 +473,13 @@ public:
         const void* cookie,
         bool extended = false);
 
-    std::map<std::string, MAVLinkParameters::ParamValue> get_all_params();
-    typedef std::function<void(std::map<std::string, MAVLinkParameters::ParamValue>)>
-        get_all_params_callback_t;
+    using ParamSet = ParamStore<ParamValue>;
+
+    // If the param cache is enabled (see ParamCache), the params are taken from it as long as
+    // the parameter hash of the autopilot hasn't changed, and are downloaded otherwise.
+    // The set is empty if the download failed.
+    ParamSet get_all_params();
+    typedef std::function<void(const ParamSet&)> get_all_params_callback_t;
     void get_all_params_async(get_all_params_callback_t callback);
 
     using ParamChangedCallback = std::function<void(ParamValue value)>;
@@ -484,6 +492,8 @@ public:
     void cancel_all_param(const void* cookie);
 
     void do_work();
+    // Called whenever do_work() has something new to do.
+    void set_wakeup_callback(std::function<void()> callback);
 
     friend std::ostream& operator<<(std::ostream&, const ParamValue&);
 
@@ -497,21 +507,36 @@ private:
     void process_param_ext_ack(const mavlink_message_t& message);
     void receive_timeout();
 
-    void notify_param_subscriptions(const mavlink_param_value_t& param_value);
+    struct AllParameters;
+    void request_all_params(get_all_params_callback_t callback, bool store_in_cache, uint32_t hash);
+    bool send_param_request_list();
+    void request_missing_params(AllParameters& all_param_store);
+    double all_params_timeout_s();
+    double request_timeout_s(bool extended, double default_s);
+    void process_all_params_value(const mavlink_param_value_t& param_value);
+    void receive_all_params_timeout();
 
-    static std::string extract_safe_param_id(const char param_id[]);
+    void notify_param_subscriptions(const mavlink_param_value_t& param_value);
 
     SystemImpl& _parent;
 
     // Params can be up to 16 chars without 0-termination.
     static constexpr size_t PARAM_ID_LEN = 16;
 
+    // Params missing from a list download are requested by index, this many at a time.
+    static constexpr std::size_t MAX_PARAM_REQUESTS_IN_FLIGHT = 10;
+    // Timeouts in a row, without any param arriving, before a list download fails. As long as
+    // not a single param has arrived, the list is requested again after each of them.
+    static constexpr int MAX_ALL_PARAMS_TIMEOUTS = 3;
+    // Minimum time to wait for the next param of a list download.
+    static constexpr double ALL_PARAMS_TIMEOUT_S = 1.0;
+
     struct WorkItem {
         enum class Type { Get, Set } type{Type::Get};
         // TODO: a union would be nicer for the callback
         get_param_callback_t get_param_callback{nullptr};
         set_param_callback_t set_param_callback{nullptr};
-        std::string param_name{};
+        ParamId param_id{};
         ParamValue param_value{};
         bool extended{false};
         int retries_done{0};
@@ -526,23 +551,30 @@ private:
     void* _timeout_cookie = nullptr;
 
     struct ParamChangedSubscription {
-        std::string param_name{};
         ParamChangedCallback callback{};
         ParamValue value_type{};
         const void* cookie{nullptr};
     };
 
     std::mutex _param_changed_subscriptions_mutex{};
-    std::vector<ParamChangedSubscription> _param_changed_subscriptions{};
+    ParamIdMap<std::vector<ParamChangedSubscription>> _param_changed_subscriptions{};
 
     struct AllParameters {
-        std::map<std::string, ParamValue> all_params{};
+        ParamSet all_params{};
         get_all_params_callback_t callback{nullptr};
         void* timeout_cookie{nullptr};
+        ParamIndexTracker indices{MAX_PARAM_REQUESTS_IN_FLIGHT};
+        std::size_t received_at_last_timeout{0};
+        int timeouts_without_progress{0};
+        bool store_in_cache{false};
+        uint64_t uuid{0};
+        uint32_t hash{0};
     };
     std::shared_ptr<AllParameters> _all_param_store{nullptr};
     std::mutex _all_param_mutex{};
 
+    std::unique_ptr<ParamCache> _param_cache;
+
     // dl_time_t _last_request_time = {};
 };
 
@@ -1,6 +1,9 @@
 #include "mavlink_receiver.h"
 #include "global_include.h"
 
+#include <algorithm>
+#include <cstring>
+
 #if DROP_DEBUG == 1
 #include <iomanip>
 #endif
@@ -27,20 +30,50 @@ void MAVLinkReceiver::set_new_datagram(char* datagram, unsigned datagram_len)
 
 bool MAVLinkReceiver::parse_message()
 {
+    // A frame which started in a previous read needs to be completed first.
+    if (_pending_len > 0 && parse_pending()) {
+#if DROP_DEBUG == 1
+        debug_drop_rate();
+#endif
+        return true;
+    }
+
     // Note that one datagram can contain multiple mavlink messages.
-    for (unsigned i = 0; i < _datagram_len; ++i) {
-        if (mavlink_parse_char(_channel, _datagram[i], &_last_message, &_status) == 1) {
-            // Move the pointer to the datagram forward by the amount parsed.
-            _datagram += (i + 1);
-            // And decrease the length, so we don't overshoot in the next round.
-            _datagram_len -= (i + 1);
+    while (_datagram_len > 0) {
+        const auto* data = reinterpret_cast<const uint8_t*>(_datagram);
+
+        const unsigned start = find_start_marker(data, _datagram_len);
+        if (start == _datagram_len) {
+            // Nothing but garbage left.
+            break;
+        }
+        advance_datagram(start);
+        data += start;
 
+        unsigned frame_len = 0;
+        switch (check_frame(data, _datagram_len, frame_len)) {
+            case FrameCheck::Complete:
+                decode_frame(data, frame_len);
+                _last_frame = {data, frame_len};
+                advance_datagram(frame_len);
 #if DROP_DEBUG == 1
-            debug_drop_rate();
+                debug_drop_rate();
 #endif
+                // We have parsed one message, let's return so it can be handled.
+                return true;
+
+            case FrameCheck::Incomplete:
+                // The rest of the frame is going to arrive with the next read.
+                std::memcpy(_pending, data, _datagram_len);
+                _pending_len = _datagram_len;
+                advance_datagram(_datagram_len);
+                break;
 
-            // We have parsed one message, let's return so it can be handled.
-            return true;
+            case FrameCheck::Invalid:
+                // Skip this start marker and look for the next one.
+                count_parse_error();
+                advance_datagram(1);
+                break;
         }
     }
 
@@ -50,6 +83,185 @@ bool MAVLinkReceiver::parse_message()
     return false;
 }
 
+bool MAVLinkReceiver::parse_pending()
+{
+    // The frame returned last time is only dropped now, once it has been handled.
+    drop_pending(_pending_consumed);
+    _pending_consumed = 0;
+
+    while (_pending_len > 0) {
+        unsigned frame_len = 0;
+        switch (check_frame(_pending, _pending_len, frame_len)) {
+            case FrameCheck::Complete:
+                decode_frame(_pending, frame_len);
+                _last_frame = {_pending, frame_len};
+                // After a resync the buffer can hold more than this frame, what follows it
+                // is parsed next time before going back to the datagram.
+                _pending_consumed = frame_len;
+                return true;
+
+            case FrameCheck::Incomplete: {
+                if (_datagram_len == 0) {
+                    return false;
+                }
+                // frame_len is what we need at least to make progress.
+                const unsigned missing = std::min(frame_len - _pending_len, _datagram_len);
+                std::memcpy(&_pending[_pending_len], _datagram, missing);
+                _pending_len += missing;
+                advance_datagram(missing);
+                break;
+            }
+
+            case FrameCheck::Invalid:
+                count_parse_error();
+                drop_pending(1);
+                break;
+        }
+    }
+    return false;
+}
+
+void MAVLinkReceiver::drop_pending(unsigned len)
+{
+    // Resync on the next start marker within what we have buffered.
+    const unsigned next = len + find_start_marker(&_pending[len], _pending_len - len);
+    std::memmove(_pending, &_pending[next], _pending_len - next);
+    _pending_len -= next;
+}
+
+void MAVLinkReceiver::advance_datagram(unsigned len)
+{
+    _datagram += len;
+    _datagram_len -= len;
+}
+
+unsigned MAVLinkReceiver::find_start_marker(const uint8_t* data, unsigned len)
+{
+    for (unsigned i = 0; i < len; ++i) {
+        if (data[i] == MAVLINK_STX || data[i] == MAVLINK_STX_MAVLINK1) {
+            return i;
+        }
+    }
+    return len;
+}
+
+MAVLinkReceiver::FrameCheck
+MAVLinkReceiver::check_frame(const uint8_t* data, unsigned len, unsigned& frame_len)
+{
+    // data[0] is a start marker, data[1] the payload length for both versions.
+    const bool is_v1 = (data[0] == MAVLINK_STX_MAVLINK1);
+    const unsigned header_len =
+        is_v1 ? (MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1) : MAVLINK_NUM_HEADER_BYTES;
+
+    if (len < header_len) {
+        frame_len = header_len;
+        return FrameCheck::Incomplete;
+    }
+
+    const uint8_t payload_len = data[1];
+    const uint8_t incompat_flags = is_v1 ? 0 : data[2];
+
+    if ((incompat_flags & ~MAVLINK_IFLAG_MASK) != 0) {
+        // We can't handle features that we don't know about.
+        return FrameCheck::Invalid;
+    }
+
+    const unsigned signature_len =
+        (incompat_flags & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+    frame_len = header_len + payload_len + MAVLINK_NUM_CHECKSUM_BYTES + signature_len;
+
+    if (len < frame_len) {
+        return FrameCheck::Incomplete;
+    }
+
+    const uint32_t msgid =
+        is_v1 ? data[5] : (data[7] | (uint32_t(data[8]) << 8) | (uint32_t(data[9]) << 16));
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(msgid);
+
+    // The checksum covers everything after the start marker up to the end of
+    // the payload, followed by the extra CRC byte of the message definition.
+    uint16_t crc = crc_calculate(&data[1], static_cast<uint16_t>(header_len - 1 + payload_len));
+    crc_accumulate(entry ? entry->crc_extra : 0, &crc);
+
+    const unsigned crc_pos = header_len + payload_len;
+    if (data[crc_pos] != (crc & 0xFF) || data[crc_pos + 1] != (crc >> 8)) {
+        return FrameCheck::Invalid;
+    }
+
+    return FrameCheck::Complete;
+}
+
+void MAVLinkReceiver::decode_frame(const uint8_t* data, unsigned frame_len)
+{
+    const bool is_v1 = (data[0] == MAVLINK_STX_MAVLINK1);
+    const unsigned header_len =
+        is_v1 ? (MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1) : MAVLINK_NUM_HEADER_BYTES;
+
+    _last_message.magic = data[0];
+    _last_message.len = data[1];
+    if (is_v1) {
+        _last_message.incompat_flags = 0;
+        _last_message.compat_flags = 0;
+        _last_message.seq = data[2];
+        _last_message.sysid = data[3];
+        _last_message.compid = data[4];
+        _last_message.msgid = data[5];
+    } else {
+        _last_message.incompat_flags = data[2];
+        _last_message.compat_flags = data[3];
+        _last_message.seq = data[4];
+        _last_message.sysid = data[5];
+        _last_message.compid = data[6];
+        _last_message.msgid = data[7] | (uint32_t(data[8]) << 8) | (uint32_t(data[9]) << 16);
+    }
+
+    char* payload = _MAV_PAYLOAD_NON_CONST(&_last_message);
+    std::memcpy(payload, &data[header_len], _last_message.len);
+
+    // Zero-fill the rest, v2 truncates trailing zeros of the payload.
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(_last_message.msgid);
+    if (entry && _last_message.len < entry->max_msg_len) {
+        std::memset(&payload[_last_message.len], 0, entry->max_msg_len - _last_message.len);
+    }
+
+    const unsigned crc_pos = header_len + _last_message.len;
+    _last_message.ck[0] = data[crc_pos];
+    _last_message.ck[1] = data[crc_pos + 1];
+    _last_message.checksum = data[crc_pos] | (uint16_t(data[crc_pos + 1]) << 8);
+
+    if (frame_len > crc_pos + MAVLINK_NUM_CHECKSUM_BYTES) {
+        std::memcpy(
+            _last_message.signature,
+            &data[crc_pos + MAVLINK_NUM_CHECKSUM_BYTES],
+            MAVLINK_SIGNATURE_BLOCK_LEN);
+    }
+
+    // Keep the same statistics as mavlink_parse_char would.
+    if (_status.packet_rx_success_count == 0) {
+        _status.packet_rx_drop_count = 0;
+    }
+    _status.msg_received = MAVLINK_FRAMING_OK;
+    _status.parse_state = MAVLINK_PARSE_STATE_IDLE;
+    _status.packet_idx = 0;
+    _status.current_rx_seq = _last_message.seq;
+    ++_status.packet_rx_success_count;
+    _status.packet_rx_drop_count += _status.parse_error;
+    _status.parse_error = 0;
+    if (is_v1) {
+        _status.flags |= MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    } else {
+        _status.flags &= ~MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    }
+}
+
+void MAVLinkReceiver::count_parse_error()
+{
+    _status.msg_received = MAVLINK_FRAMING_INCOMPLETE;
+    if (_status.parse_error < UINT8_MAX) {
+        ++_status.parse_error;
+    }
+}
+
 #if DROP_DEBUG == 1
 void MAVLinkReceiver::debug_drop_rate()
 {
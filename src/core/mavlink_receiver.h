@@ -16,6 +16,17 @@ public:
 
     mavlink_status_t& get_status() { return _status; }
 
+    // View of the raw bytes of the last parsed frame. It points either into
+    // the datagram given to set_new_datagram or into the internal buffer used
+    // for frames split across reads, so it is only valid until the next call
+    // to parse_message().
+    struct Frame {
+        const uint8_t* data{nullptr};
+        unsigned len{0};
+    };
+
+    const Frame& get_last_frame() const { return _last_frame; }
+
     void set_new_datagram(char* datagram, unsigned datagram_len);
 
     bool parse_message();
@@ -31,12 +42,30 @@ public:
 #endif
 
 private:
+    enum class FrameCheck { Complete, Incomplete, Invalid };
+
+    static FrameCheck check_frame(const uint8_t* data, unsigned len, unsigned& frame_len);
+    static unsigned find_start_marker(const uint8_t* data, unsigned len);
+
+    bool parse_pending();
+    void drop_pending(unsigned len);
+    void advance_datagram(unsigned len);
+    void decode_frame(const uint8_t* data, unsigned frame_len);
+    void count_parse_error();
+
     uint8_t _channel;
     mavlink_message_t _last_message = {};
     mavlink_status_t _status = {};
+    Frame _last_frame{};
     char* _datagram = nullptr;
     unsigned _datagram_len = 0;
 
+    // Start of a frame which has not been completely received yet.
+    uint8_t _pending[MAVLINK_MAX_PACKET_LEN]{};
+    unsigned _pending_len = 0;
+    // Length of the frame at the start of _pending which was returned last.
+    unsigned _pending_consumed = 0;
+
 #if DROP_DEBUG == 1
     unsigned _bytes_received = 0;
 
@@ -0,0 +1,159 @@
+#include "mavlink_receiver.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+std::vector<uint8_t> heartbeat_frame(uint8_t sysid)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        sysid, MAV_COMP_ID_AUTOPILOT1, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, 0);
+
+    std::vector<uint8_t> buffer(MAVLINK_MAX_PACKET_LEN);
+    buffer.resize(mavlink_msg_to_send_buffer(buffer.data(), &message));
+    return buffer;
+}
+
+std::vector<uint8_t> attitude_frame(uint8_t sysid, float roll)
+{
+    mavlink_message_t message;
+    mavlink_msg_attitude_pack(
+        sysid, MAV_COMP_ID_AUTOPILOT1, &message, 42, roll, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+
+    std::vector<uint8_t> buffer(MAVLINK_MAX_PACKET_LEN);
+    buffer.resize(mavlink_msg_to_send_buffer(buffer.data(), &message));
+    return buffer;
+}
+
+void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& frame)
+{
+    stream.insert(stream.end(), frame.begin(), frame.end());
+}
+
+std::vector<mavlink_message_t>
+parse_all(MAVLinkReceiver& receiver, std::vector<uint8_t>& data, unsigned chunk_size)
+{
+    std::vector<mavlink_message_t> messages;
+    for (unsigned offset = 0; offset < data.size(); offset += chunk_size) {
+        const unsigned len = std::min(chunk_size, unsigned(data.size()) - offset);
+        receiver.set_new_datagram(reinterpret_cast<char*>(&data[offset]), len);
+        while (receiver.parse_message()) {
+            messages.push_back(receiver.get_last_message());
+        }
+    }
+    return messages;
+}
+
+} // namespace
+
+TEST(MAVLinkReceiver, MultipleFramesInOneDatagram)
+{
+    std::vector<uint8_t> stream;
+    append(stream, heartbeat_frame(1));
+    append(stream, attitude_frame(2, 0.1f));
+    append(stream, heartbeat_frame(3));
+
+    MAVLinkReceiver receiver(0);
+    const auto messages = parse_all(receiver, stream, stream.size());
+
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(messages[0].msgid, MAVLINK_MSG_ID_HEARTBEAT);
+    EXPECT_EQ(messages[0].sysid, 1);
+    EXPECT_EQ(messages[1].msgid, MAVLINK_MSG_ID_ATTITUDE);
+    EXPECT_EQ(messages[1].sysid, 2);
+    EXPECT_FLOAT_EQ(mavlink_msg_attitude_get_roll(&messages[1]), 0.1f);
+    EXPECT_EQ(messages[2].sysid, 3);
+    EXPECT_EQ(receiver.get_status().packet_rx_success_count, 3);
+}
+
+TEST(MAVLinkReceiver, FrameViewPointsToRawBytes)
+{
+    auto stream = attitude_frame(1, 0.5f);
+
+    MAVLinkReceiver receiver(0);
+    receiver.set_new_datagram(reinterpret_cast<char*>(stream.data()), stream.size());
+    ASSERT_TRUE(receiver.parse_message());
+
+    const auto& frame = receiver.get_last_frame();
+    EXPECT_EQ(frame.data, stream.data());
+    EXPECT_EQ(frame.len, stream.size());
+    EXPECT_FALSE(receiver.parse_message());
+}
+
+TEST(MAVLinkReceiver, FramesSplitAcrossReads)
+{
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 1; i <= 20; ++i) {
+        append(stream, (i % 2) ? heartbeat_frame(i) : attitude_frame(i, float(i)));
+    }
+
+    // Every chunk size from byte-by-byte to whole frames has to work for stream transports.
+    for (unsigned chunk_size = 1; chunk_size < 64; ++chunk_size) {
+        MAVLinkReceiver receiver(0);
+        const auto messages = parse_all(receiver, stream, chunk_size);
+
+        ASSERT_EQ(messages.size(), 20) << "chunk size: " << chunk_size;
+        for (uint8_t i = 1; i <= 20; ++i) {
+            EXPECT_EQ(messages[i - 1].sysid, i);
+        }
+        EXPECT_FLOAT_EQ(mavlink_msg_attitude_get_roll(&messages[1]), 2.0f);
+    }
+}
+
+TEST(MAVLinkReceiver, SkipsGarbageAndBadCrc)
+{
+    std::vector<uint8_t> stream{0x00, 0x42, MAVLINK_STX, 0x01};
+    append(stream, heartbeat_frame(1));
+
+    auto corrupted = attitude_frame(2, 0.1f);
+    corrupted[corrupted.size() - 1] ^= 0xFF;
+    append(stream, corrupted);
+
+    append(stream, attitude_frame(3, 0.2f));
+
+    for (unsigned chunk_size : {1u, 7u, unsigned(stream.size())}) {
+        MAVLinkReceiver receiver(0);
+        const auto messages = parse_all(receiver, stream, chunk_size);
+
+        ASSERT_EQ(messages.size(), 2) << "chunk size: " << chunk_size;
+        EXPECT_EQ(messages[0].sysid, 1);
+        EXPECT_EQ(messages[1].sysid, 3);
+        EXPECT_GT(receiver.get_status().packet_rx_drop_count, 0);
+    }
+}
+
+TEST(MAVLinkReceiver, KeepsFramesPulledInByFakeHeader)
+{
+    // A stray start marker with a plausible header makes the receiver buffer as many bytes as
+    // the fake payload length says. The frames among them must not get lost when the fake
+    // frame turns out to be invalid. 49 bytes of payload covers both frames exactly.
+    for (uint8_t fake_payload_len : {10, 30, 49}) {
+        std::vector<uint8_t> stream{
+            0x00, 0x42, MAVLINK_STX, fake_payload_len, 0, 0, 7, 1, 1, 0, 0, 0};
+        append(stream, heartbeat_frame(1));
+        append(stream, attitude_frame(2, 0.1f));
+
+        // The first read ends within the fake header.
+        const unsigned split = 6;
+        MAVLinkReceiver receiver(0);
+        std::vector<mavlink_message_t> messages;
+        receiver.set_new_datagram(reinterpret_cast<char*>(stream.data()), split);
+        while (receiver.parse_message()) {
+            messages.push_back(receiver.get_last_message());
+        }
+        receiver.set_new_datagram(reinterpret_cast<char*>(&stream[split]), stream.size() - split);
+        while (receiver.parse_message()) {
+            messages.push_back(receiver.get_last_message());
+        }
+
+        ASSERT_EQ(messages.size(), 2) << "fake payload length: " << unsigned(fake_payload_len);
+        EXPECT_EQ(messages[0].msgid, MAVLINK_MSG_ID_HEARTBEAT);
+        EXPECT_EQ(messages[0].sysid, 1);
+        EXPECT_EQ(messages[1].msgid, MAVLINK_MSG_ID_ATTITUDE);
+        EXPECT_EQ(messages[1].sysid, 2);
+        EXPECT_FLOAT_EQ(mavlink_msg_attitude_get_roll(&messages[1]), 0.1f);
+    }
+}
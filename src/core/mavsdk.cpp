@@ -88,6 +88,17 @@ void Mavsdk::subscribe_on_new_system(const NewSystemCallback callback)
     _impl->subscribe_on_new_system(callback);
 }
 
+Mavsdk::UserCallbackStats Mavsdk::user_callback_stats() const
+{
+    const auto stats = _impl->user_callback_stats();
+
+    UserCallbackStats result;
+    result.dropped_newest = stats.dropped_newest;
+    result.dropped_oldest = stats.dropped_oldest;
+    result.coalesced = stats.coalesced;
+    return result;
+}
+
 void Mavsdk::register_on_discover(const event_callback_t callback)
 {
     _impl->register_on_discover(callback);
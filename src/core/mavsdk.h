@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -293,6 +294,24 @@ public:
      */
     void subscribe_on_new_system(NewSystemCallback callback);
 
+    /**
+     * @brief Numbers of callbacks into user code which were not called.
+     *
+     * Callbacks are dropped if they are queued faster than the user code returns.
+     */
+    struct UserCallbackStats {
+        uint64_t dropped_newest{0}; /**< @brief Dropped because the queue was full. */
+        uint64_t dropped_oldest{0}; /**< @brief Dropped to make space for newer ones. */
+        uint64_t coalesced{0}; /**< @brief Replaced by a newer one of the same subscription. */
+    };
+
+    /**
+     * @brief Get the numbers of callbacks into user code dropped so far.
+     *
+     * @return The numbers of dropped callbacks.
+     */
+    UserCallbackStats user_callback_stats() const;
+
     /**
      * @brief Callback type for discover and timeout notifications (deprecated).
      *
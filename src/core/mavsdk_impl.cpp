@@ -1,5 +1,7 @@
 #include "mavsdk_impl.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <mutex>
 #include <utility>
 
@@ -26,26 +28,50 @@ MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
         }
     }
 
+    start_io_reactor();
+
+    if (const char* env_p = std::getenv("MAVSDK_SEND_COALESCING_MS")) {
+        _send_coalescing_interval_s = std::strtod(env_p, nullptr) / 1000.0;
+        if (_send_coalescing_interval_s > 0.0) {
+            LogDebug() << "Coalescing messages sent within " << env_p << " ms.";
+        }
+    }
+
+    timeout_handler.set_wakeup_callback([this]() { wake_work_thread(); });
+    call_every_handler.set_wakeup_callback([this]() { wake_work_thread(); });
+
+    if (_send_coalescing_interval_s > 0.0) {
+        call_every_handler.add(
+            [this]() { flush_connections(); }, _send_coalescing_interval_s, &_flush_cookie);
+    }
+
+    call_every_handler.add(
+        [this]() { check_running_callbacks(); },
+        _CALLBACK_TIMEOUT_S / 2.0,
+        &_callback_watchdog_cookie);
+
     _work_thread = new std::thread(&MavsdkImpl::work_thread, this);
 
-    _process_user_callbacks_thread =
-        new std::thread(&MavsdkImpl::process_user_callbacks_thread, this);
+    unsigned num_callback_threads = _DEFAULT_CALLBACK_THREADS;
+    if (const char* env_p = std::getenv("MAVSDK_CALLBACK_THREADS")) {
+        num_callback_threads = static_cast<unsigned>(std::strtoul(env_p, nullptr, 10));
+        LogDebug() << "Calling user callbacks using " << num_callback_threads << " threads.";
+    }
+    _callback_executor.start(num_callback_threads);
 }
 
 MavsdkImpl::~MavsdkImpl()
 {
     call_every_handler.remove(_heartbeat_send_cookie);
+    call_every_handler.remove(_flush_cookie);
+    call_every_handler.remove(_callback_watchdog_cookie);
 
     _should_exit = true;
 
-    if (_process_user_callbacks_thread != nullptr) {
-        _user_callback_queue.stop();
-        _process_user_callbacks_thread->join();
-        delete _process_user_callbacks_thread;
-        _process_user_callbacks_thread = nullptr;
-    }
+    _callback_executor.stop();
 
     if (_work_thread != nullptr) {
+        wake_work_thread();
         _work_thread->join();
         delete _work_thread;
         _work_thread = nullptr;
@@ -61,6 +87,29 @@ MavsdkImpl::~MavsdkImpl()
         std::lock_guard<std::mutex> lock(_connections_mutex);
         _connections.clear();
     }
+
+    if (_io_reactor) {
+        _io_reactor->stop();
+    }
+}
+
+void MavsdkImpl::start_io_reactor()
+{
+    unsigned num_threads = _DEFAULT_IO_THREADS;
+    if (const char* env_p = std::getenv("MAVSDK_IO_THREADS")) {
+        num_threads = static_cast<unsigned>(std::strtoul(env_p, nullptr, 10));
+    }
+
+    if (num_threads == 0) {
+        LogDebug() << "Using a receive thread per connection.";
+        return;
+    }
+
+    _io_reactor.reset(new IoReactor());
+    if (!_io_reactor->start(num_threads)) {
+        // Not supported on this platform, so connections need to use their own threads.
+        _io_reactor.reset();
+    }
 }
 
 std::string MavsdkImpl::version() const
@@ -152,10 +201,14 @@ void MavsdkImpl::receive_message(mavlink_message_t& message)
 
 bool MavsdkImpl::send_message(mavlink_message_t& message)
 {
+    // Serialize only once, no matter how many connections we send it on.
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
     std::lock_guard<std::mutex> lock(_connections_mutex);
 
     for (auto it = _connections.begin(); it != _connections.end(); ++it) {
-        if (!(**it).send_message(message)) {
+        if (!(**it).send_serialized_message(buffer, buffer_len)) {
             LogErr() << "send fail";
             return false;
         }
@@ -217,6 +270,7 @@ ConnectionResult MavsdkImpl::add_udp_connection(const std::string& local_ip, con
     if (!new_conn) {
         return ConnectionResult::ConnectionError;
     }
+    new_conn->set_io_reactor(_io_reactor.get());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         add_connection(new_conn);
@@ -231,6 +285,7 @@ ConnectionResult MavsdkImpl::setup_udp_remote(const std::string& remote_ip, int
     if (!new_conn) {
         return ConnectionResult::ConnectionError;
     }
+    new_conn->set_io_reactor(_io_reactor.get());
     ConnectionResult ret = new_conn->start();
     _is_single_system = true;
     if (ret == ConnectionResult::Success) {
@@ -250,6 +305,7 @@ ConnectionResult MavsdkImpl::add_tcp_connection(const std::string& remote_ip, in
     if (!new_conn) {
         return ConnectionResult::ConnectionError;
     }
+    new_conn->set_io_reactor(_io_reactor.get());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         add_connection(new_conn);
@@ -268,6 +324,7 @@ MavsdkImpl::add_serial_connection(const std::string& dev_path, int baudrate, boo
     if (!new_conn) {
         return ConnectionResult::ConnectionError;
     }
+    new_conn->set_io_reactor(_io_reactor.get());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         add_connection(new_conn);
@@ -277,10 +334,21 @@ MavsdkImpl::add_serial_connection(const std::string& dev_path, int baudrate, boo
 
 void MavsdkImpl::add_connection(std::shared_ptr<Connection> new_connection)
 {
+    new_connection->set_coalescing(_send_coalescing_interval_s > 0.0);
+
     std::lock_guard<std::mutex> lock(_connections_mutex);
     _connections.push_back(new_connection);
 }
 
+void MavsdkImpl::flush_connections()
+{
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    for (auto& connection : _connections) {
+        connection->flush();
+    }
+}
+
 void MavsdkImpl::set_configuration(Mavsdk::Configuration configuration)
 {
     _configuration = configuration;
@@ -494,12 +562,41 @@ void MavsdkImpl::work_thread()
     while (!_should_exit) {
         timeout_handler.run_once();
         call_every_handler.run_once();
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        std::unique_lock<std::mutex> lock(_work_mutex);
+        const auto next_deadline =
+            std::min(timeout_handler.next_deadline(), call_every_handler.next_deadline());
+
+        const auto woken_up = [this]() { return _work_pending || _should_exit; };
+        if (next_deadline == dl_time_t::max()) {
+            _work_cv.wait(lock, woken_up);
+        } else {
+            _work_cv.wait_until(lock, next_deadline, woken_up);
+        }
+        _work_pending = false;
     }
 }
 
+void MavsdkImpl::wake_work_thread()
+{
+    {
+        std::lock_guard<std::mutex> lock(_work_mutex);
+        _work_pending = true;
+    }
+    _work_cv.notify_one();
+}
+
 void MavsdkImpl::call_user_callback_located(
-    const std::string& filename, const int linenumber, const std::function<void()>& func)
+    const char* filename, const int linenumber, UserCallbackQueue::Func func)
+{
+    call_user_callback_located(filename, linenumber, std::move(func), nullptr);
+}
+
+void MavsdkImpl::call_user_callback_located(
+    const char* filename,
+    const int linenumber,
+    UserCallbackQueue::Func func,
+    const std::shared_ptr<UserCallbackQueue::Subscription>& subscription)
 {
     auto callback_size = _user_callback_queue.size();
     if (callback_size == 10) {
@@ -507,52 +604,76 @@ void MavsdkImpl::call_user_callback_located(
             << "User callback queue too slow.\n"
                "See: https://mavsdk.mavlink.io/develop/en/cpp/troubleshooting.html#user_callbacks";
 
-    } else if (callback_size == 99) {
+    } else if (callback_size == _user_callback_queue.capacity() - 1) {
         LogErr()
             << "User callback queue overflown\n"
                "See: https://mavsdk.mavlink.io/develop/en/cpp/troubleshooting.html#user_callbacks";
-
-    } else if (callback_size == 100) {
-        return;
     }
 
     // We only need to keep track of filename and linenumber if we're actually debugging this.
-    UserCallback user_callback =
-        _callback_debugging ? UserCallback{func, filename, linenumber} : UserCallback{func};
+    if (_callback_debugging) {
+        _user_callback_queue.push(
+            UserCallbackQueue::UserCallback{std::move(func), filename, linenumber}, subscription);
+    } else {
+        _user_callback_queue.push(UserCallbackQueue::UserCallback{std::move(func)}, subscription);
+    }
+}
 
-    _user_callback_queue.enqueue(user_callback);
+UserCallbackQueue::Stats MavsdkImpl::user_callback_stats() const
+{
+    auto stats = _user_callback_queue.stats();
+    const auto executor_stats = _callback_executor.stats();
+    stats.dropped_newest += executor_stats.dropped_newest;
+    stats.dropped_oldest += executor_stats.dropped_oldest;
+    stats.coalesced += executor_stats.coalesced;
+    return stats;
 }
 
-void MavsdkImpl::process_user_callbacks_thread()
+void MavsdkImpl::run_user_callback(UserCallbackQueue::UserCallback& callback)
 {
-    while (!_should_exit) {
-        auto callback = _user_callback_queue.dequeue();
-        if (!callback.first) {
+    // Every callback thread gets its entry the first time, after which timing a
+    // callback doesn't allocate.
+    thread_local RunningCallback* running = nullptr;
+    if (running == nullptr) {
+        std::lock_guard<std::mutex> lock(_running_callbacks_mutex);
+        _running_callbacks.push_back(std::make_unique<RunningCallback>());
+        running = _running_callbacks.back().get();
+    }
+
+    running->filename.store(callback.filename, std::memory_order_relaxed);
+    running->linenumber.store(callback.linenumber, std::memory_order_relaxed);
+    running->started_s.store(_time.elapsed_s(), std::memory_order_release);
+    callback.func();
+    running->started_s.store(-1.0, std::memory_order_release);
+}
+
+void MavsdkImpl::check_running_callbacks()
+{
+    // Every callback is timed on its own, so with several callback threads, this
+    // warns about the strand which is held up.
+    const double now_s = _time.elapsed_s();
+
+    std::lock_guard<std::mutex> lock(_running_callbacks_mutex);
+    for (auto& running : _running_callbacks) {
+        const double started_s = running->started_s.load(std::memory_order_acquire);
+        if (started_s < 0.0 || started_s == running->warned_about_s ||
+            now_s - started_s < _CALLBACK_TIMEOUT_S) {
             continue;
         }
-
-        void* cookie{nullptr};
-
-        const double timeout_s = 1.0;
-        timeout_handler.add(
-            [&]() {
-                if (_callback_debugging) {
-                    LogWarn() << "Callback called from " << callback.second.filename << ":"
-                              << callback.second.linenumber << " took more than " << timeout_s
-                              << " second to run.";
-                    fflush(stdout);
-                    fflush(stderr);
-                    abort();
-                } else {
-                    LogWarn()
-                        << "Callback took more than " << timeout_s << " second to run.\n"
-                        << "See: https://mavsdk.mavlink.io/develop/en/cpp/troubleshooting.html#user_callbacks";
-                }
-            },
-            timeout_s,
-            &cookie);
-        callback.second.func();
-        timeout_handler.remove(cookie);
+        running->warned_about_s = started_s;
+
+        if (_callback_debugging) {
+            LogWarn() << "Callback called from " << running->filename.load() << ":"
+                      << running->linenumber.load() << " took more than "
+                      << _CALLBACK_TIMEOUT_S << " second to run.";
+            fflush(stdout);
+            fflush(stderr);
+            abort();
+        } else {
+            LogWarn()
+                << "Callback took more than " << _CALLBACK_TIMEOUT_S << " second to run.\n"
+                << "See: https://mavsdk.mavlink.io/develop/en/cpp/troubleshooting.html#user_callbacks";
+        }
     }
 }
 
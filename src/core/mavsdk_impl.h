@@ -1,18 +1,22 @@
 #pragma once
 
 #include <unordered_map>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <atomic>
 
 #include "call_every_handler.h"
 #include "connection.h"
+#include "io_reactor.h"
 #include "mavsdk.h"
 #include "mavlink_include.h"
 #include "mavlink_address.h"
-#include "safe_queue.h"
 #include "system.h"
 #include "timeout_handler.h"
+#include "callback_executor.h"
+#include "user_callback_queue.h"
 
 namespace mavsdk {
 
@@ -78,17 +82,27 @@ public:
     CallEveryHandler call_every_handler;
 
     void call_user_callback_located(
-        const std::string& filename, const int linenumber, const std::function<void()>& func);
+        const char* filename, const int linenumber, UserCallbackQueue::Func func);
+    void call_user_callback_located(
+        const char* filename,
+        const int linenumber,
+        UserCallbackQueue::Func func,
+        const std::shared_ptr<UserCallbackQueue::Subscription>& subscription);
+    UserCallbackQueue::Stats user_callback_stats() const;
 
     MAVLinkAddress own_address{};
 
 private:
+    void start_io_reactor();
     void add_connection(std::shared_ptr<Connection>);
+    void flush_connections();
     void make_system_with_component(uint8_t system_id, uint8_t component_id);
     bool does_system_exist(uint8_t system_id);
 
     void work_thread();
-    void process_user_callbacks_thread();
+    void wake_work_thread();
+    void run_user_callback(UserCallbackQueue::UserCallback& callback);
+    void check_running_callbacks();
 
     void send_heartbeat();
 
@@ -97,6 +111,16 @@ private:
     std::mutex _connections_mutex{};
     std::vector<std::shared_ptr<Connection>> _connections{};
 
+    // Receives on all connections unless disabled using MAVSDK_IO_THREADS=0,
+    // in which case every connection uses its own receive thread.
+    std::unique_ptr<IoReactor> _io_reactor{};
+    static constexpr unsigned _DEFAULT_IO_THREADS = 1;
+
+    // If set using MAVSDK_SEND_COALESCING_MS, outgoing messages are collected
+    // and sent together at this interval instead of one datagram each.
+    double _send_coalescing_interval_s{0.0};
+    void* _flush_cookie{nullptr};
+
     mutable std::recursive_mutex _systems_mutex{};
     std::unordered_map<uint8_t, std::shared_ptr<System>> _systems{};
 
@@ -111,28 +135,38 @@ private:
     Mavsdk::Configuration _configuration{Mavsdk::Configuration::UsageType::GroundStation};
     bool _is_single_system{false};
 
-    struct UserCallback {
-        UserCallback() {}
-        UserCallback(const std::function<void()>& func_) : func(func_) {}
-        UserCallback(
-            const std::function<void()>& func_,
-            const std::string& filename_,
-            const int linenumber_) :
-            func(func_),
-            filename(filename_),
-            linenumber(linenumber_)
-        {}
-
-        std::function<void()> func{};
-        std::string filename{};
-        int linenumber{};
-    };
-
     std::thread* _work_thread{nullptr};
-    std::thread* _process_user_callbacks_thread{nullptr};
-    SafeQueue<UserCallback> _user_callback_queue{};
+    // The work thread sleeps until the next timeout or call every is due,
+    // or until one is scheduled earlier than that.
+    std::mutex _work_mutex{};
+    std::condition_variable _work_cv{};
+    bool _work_pending{false};
+
+    static constexpr size_t _USER_CALLBACK_QUEUE_CAPACITY = 128;
+    UserCallbackQueue _user_callback_queue{_USER_CALLBACK_QUEUE_CAPACITY};
+    // More than one thread, set using MAVSDK_CALLBACK_THREADS, means that
+    // callbacks of different subscriptions and systems can run in parallel.
+    static constexpr unsigned _DEFAULT_CALLBACK_THREADS = 1;
+    CallbackExecutor _callback_executor{
+        _user_callback_queue,
+        [this](UserCallbackQueue::UserCallback& callback) { run_user_callback(callback); }};
     bool _callback_debugging{false};
 
+    // Every thread calling user callbacks tells which one it is running since when, so
+    // that one watchdog can warn about those taking too long, rather than a timeout
+    // being added for every callback.
+    struct RunningCallback {
+        std::atomic<double> started_s{-1.0};
+        std::atomic<const char*> filename{nullptr};
+        std::atomic<int> linenumber{0};
+        // Only used by the watchdog, so that it warns once per callback.
+        double warned_about_s{-1.0};
+    };
+    std::mutex _running_callbacks_mutex{};
+    std::vector<std::unique_ptr<RunningCallback>> _running_callbacks{};
+    static constexpr double _CALLBACK_TIMEOUT_S = 1.0;
+    void* _callback_watchdog_cookie{nullptr};
+
     static constexpr double _HEARTBEAT_SEND_INTERVAL_S = 1.0;
     std::atomic<bool> _sending_heartbeats{false};
     void* _heartbeat_send_cookie = nullptr;
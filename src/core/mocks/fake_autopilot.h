@@ -0,0 +1,188 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "mavsdk.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
+
+namespace mavsdk {
+namespace testing {
+
+// An autopilot for unit tests: a second Mavsdk in the same process, connected over UDP on
+// localhost. Apart from what it takes to be discovered, it only answers what a test tells it
+// to. Answers can be sent on behalf of any component and after a delay.
+class FakeAutopilot {
+public:
+    FakeAutopilot()
+    {
+        Mavsdk::Configuration configuration(Mavsdk::Configuration::UsageType::Autopilot);
+        _mavsdk.set_configuration(configuration);
+        _sender = std::thread([this]() { send_when_due(); });
+    }
+
+    ~FakeAutopilot()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _should_exit = true;
+        }
+        _due_changed.notify_all();
+        _sender.join();
+    }
+
+    // Connects the Mavsdk of a test to the fake autopilot. Returns the system it sees, or
+    // nullptr if it couldn't connect.
+    std::shared_ptr<System> connect(Mavsdk& mavsdk)
+    {
+        auto prom = std::make_shared<std::promise<void>>();
+        auto future_result = prom->get_future();
+        auto connected = std::make_shared<bool>(false);
+        mavsdk.subscribe_on_new_system([&mavsdk, prom, connected]() {
+            if (!*connected && mavsdk.systems().at(0)->is_connected()) {
+                *connected = true;
+                prom->set_value();
+            }
+        });
+
+        // Tests may run in parallel, so the test takes the first port nobody else is bound to.
+        int port = 0;
+        for (int candidate = 14720; candidate < 14820 && port == 0; ++candidate) {
+            if (mavsdk.add_udp_connection(candidate) == ConnectionResult::Success) {
+                port = candidate;
+            }
+        }
+        if (port == 0 ||
+            _mavsdk.setup_udp_remote("127.0.0.1", port) != ConnectionResult::Success) {
+            mavsdk.subscribe_on_new_system(nullptr);
+            return nullptr;
+        }
+
+        _mavlink_passthrough = std::make_shared<MavlinkPassthrough>(_mavsdk.systems().at(0));
+        _mavlink_passthrough->subscribe_message_async(
+            MAVLINK_MSG_ID_COMMAND_LONG,
+            [this](const mavlink_message_t& message) { receive_command_long(message); });
+
+        const bool discovered =
+            future_result.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        mavsdk.subscribe_on_new_system(nullptr);
+        return discovered ? mavsdk.systems().at(0) : nullptr;
+    }
+
+    // Called for every message with this id arriving at the fake autopilot. Only the
+    // COMMAND_LONG which are needed for the discovery are handled without being asked to.
+    void subscribe_message(
+        uint16_t message_id, std::function<void(const mavlink_message_t&)> callback)
+    {
+        if (message_id == MAVLINK_MSG_ID_COMMAND_LONG) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _command_long_callback = std::move(callback);
+        } else {
+            _mavlink_passthrough->subscribe_message_async(message_id, std::move(callback));
+        }
+    }
+
+    // Sends a message once the delay is over. Messages with the same delay are sent in the
+    // order they were passed.
+    void send(const mavlink_message_t& message, std::chrono::milliseconds delay = {})
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _due.emplace(
+                std::make_pair(std::chrono::steady_clock::now() + delay, _sequence++), message);
+        }
+        _due_changed.notify_all();
+    }
+
+    // A COMMAND_ACK for a COMMAND_LONG which arrived, as if it came from compid.
+    static mavlink_message_t
+    command_ack(const mavlink_message_t& command_long, uint8_t compid, MAV_RESULT result)
+    {
+        mavlink_command_ack_t command_ack{};
+        command_ack.command = mavlink_msg_command_long_get_command(&command_long);
+        command_ack.result = result;
+        command_ack.target_system = command_long.sysid;
+        command_ack.target_component = command_long.compid;
+
+        mavlink_message_t message;
+        mavlink_msg_command_ack_encode(SYSID, compid, &message, &command_ack);
+        return message;
+    }
+
+    static constexpr uint8_t SYSID = 1;
+
+    // Non-copyable
+    FakeAutopilot(const FakeAutopilot&) = delete;
+    const FakeAutopilot& operator=(const FakeAutopilot&) = delete;
+
+private:
+    void receive_command_long(const mavlink_message_t& message)
+    {
+        if (mavlink_msg_command_long_get_command(&message) ==
+            MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES) {
+            // Without a UUID, the autopilot only counts as discovered after a few heartbeats.
+            mavlink_autopilot_version_t autopilot_version{};
+            autopilot_version.uid = 42;
+            mavlink_message_t answer;
+            mavlink_msg_autopilot_version_encode(
+                SYSID, MAV_COMP_ID_AUTOPILOT1, &answer, &autopilot_version);
+            send(answer);
+            send(command_ack(message, MAV_COMP_ID_AUTOPILOT1, MAV_RESULT_ACCEPTED));
+            return;
+        }
+
+        std::function<void(const mavlink_message_t&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            callback = _command_long_callback;
+        }
+        if (callback) {
+            callback(message);
+        }
+    }
+
+    void send_when_due()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_should_exit) {
+            if (_due.empty()) {
+                _due_changed.wait(lock);
+                continue;
+            }
+            if (_due.begin()->first.first > std::chrono::steady_clock::now()) {
+                _due_changed.wait_until(lock, _due.begin()->first.first);
+                continue;
+            }
+            auto message = _due.begin()->second;
+            _due.erase(_due.begin());
+
+            lock.unlock();
+            _mavlink_passthrough->send_message(message);
+            lock.lock();
+        }
+    }
+
+    std::mutex _mutex{};
+    std::condition_variable _due_changed{};
+    std::map<std::pair<std::chrono::steady_clock::time_point, uint64_t>, mavlink_message_t>
+        _due{};
+    uint64_t _sequence{0};
+    bool _should_exit{false};
+    std::function<void(const mavlink_message_t&)> _command_long_callback{};
+
+    // Destroyed before the state above, which their callbacks use.
+    Mavsdk _mavsdk{};
+    std::shared_ptr<MavlinkPassthrough> _mavlink_passthrough{};
+    std::thread _sender{};
+};
+
+} // namespace testing
+} // namespace mavsdk
@@ -0,0 +1,142 @@
+#include "param_cache.h"
+#include "log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace mavsdk {
+
+namespace {
+
+// Bump this whenever the format changes, so that old files are ignored.
+constexpr const char* HEADER = "mavsdk-param-cache-1";
+
+} // namespace
+
+std::string ParamCache::directory_from_env()
+{
+    if (const char* env_p = std::getenv("MAVSDK_PARAM_CACHE_DIR")) {
+        return std::string(env_p);
+    }
+    return std::string();
+}
+
+std::string ParamCache::file_path(uint64_t uuid) const
+{
+    std::stringstream ss;
+    ss << _directory;
+    if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\') {
+        ss << '/';
+    }
+    ss << "params_" << std::hex << uuid << ".txt";
+    return ss.str();
+}
+
+bool ParamCache::load(uint64_t uuid, uint32_t& hash, MAVLinkParameters::ParamSet& params) const
+{
+    if (!enabled()) {
+        return false;
+    }
+
+    std::ifstream file(file_path(uuid));
+    if (!file) {
+        return false;
+    }
+
+    std::string header;
+    uint32_t stored_hash = 0;
+    size_t count = 0;
+    if (!(file >> header >> std::hex >> stored_hash >> std::dec >> count) || header != HEADER) {
+        LogWarn() << "Ignoring invalid param cache " << file_path(uuid);
+        return false;
+    }
+
+    MAVLinkParameters::ParamSet loaded;
+    // There can't be more params than a PARAM_VALUE can count.
+    loaded.reserve(std::min<size_t>(count, UINT16_MAX));
+
+    // Each line has the name, the MAV_PARAM_TYPE, and the 4 bytes of the value as sent
+    // in PARAM_VALUE, so that floats come back exactly.
+    std::string name;
+    unsigned type = 0;
+    uint32_t bits = 0;
+    while (file >> name >> std::dec >> type >> std::hex >> bits) {
+        if (type != MAV_PARAM_TYPE_REAL32 && type != MAV_PARAM_TYPE_INT32) {
+            LogWarn() << "Ignoring param cache with unexpected type " << type;
+            return false;
+        }
+        mavlink_param_value_t param_value{};
+        std::memcpy(&param_value.param_value, &bits, sizeof(bits));
+        param_value.param_type = static_cast<uint8_t>(type);
+
+        MAVLinkParameters::ParamValue value;
+        value.set_from_mavlink_param_value(param_value);
+        loaded.set(ParamId(name), value);
+    }
+
+    if (loaded.size() != count) {
+        LogWarn() << "Ignoring truncated param cache " << file_path(uuid);
+        return false;
+    }
+
+    hash = stored_hash;
+    params = std::move(loaded);
+    return true;
+}
+
+bool ParamCache::store(
+    uint64_t uuid, uint32_t hash, const MAVLinkParameters::ParamSet& params) const
+{
+    if (!enabled()) {
+        return false;
+    }
+
+    const std::string path = file_path(uuid);
+    // Write a temporary file first, so that a reader never sees half of it.
+    const std::string tmp_path = path + ".tmp";
+
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file) {
+            LogWarn() << "Could not write param cache " << tmp_path;
+            return false;
+        }
+
+        file << HEADER << ' ' << std::hex << hash << ' ' << std::dec << params.size() << '\n';
+
+        for (const auto& param : params) {
+            const float float_bytes = param.value.get_4_float_bytes();
+            uint32_t bits = 0;
+            std::memcpy(&bits, &float_bytes, sizeof(bits));
+            file << param.id.to_string() << ' ' << std::dec
+                 << static_cast<unsigned>(param.value.get_mav_param_type()) << ' ' << std::hex
+                 << bits << '\n';
+        }
+
+        file.close();
+        if (!file) {
+            LogWarn() << "Could not write param cache " << tmp_path;
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), path.c_str()) == 0) {
+        return true;
+    }
+
+    // On Windows rename does not replace an existing file.
+    std::remove(path.c_str());
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        LogWarn() << "Could not replace param cache " << path;
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace mavsdk
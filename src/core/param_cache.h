@@ -0,0 +1,37 @@
+#pragma once
+
+#include "mavlink_parameters.h"
+#include <cstdint>
+#include <string>
+
+namespace mavsdk {
+
+// Keeps the parameter set of an autopilot on disk, keyed by its UUID, along
+// with the parameter hash it reported (PX4's _HASH_CHECK), so that the set
+// doesn't need to be downloaded again as long as that hash is unchanged.
+//
+// The cache is off if the directory is empty. The directory is not created.
+class ParamCache {
+public:
+    explicit ParamCache(std::string directory) : _directory(std::move(directory)) {}
+    ~ParamCache() = default;
+
+    // Directory set in the environment variable MAVSDK_PARAM_CACHE_DIR, or empty.
+    static std::string directory_from_env();
+
+    bool enabled() const { return !_directory.empty(); }
+
+    // Returns false if there is no usable file for this UUID.
+    bool load(uint64_t uuid, uint32_t& hash, MAVLinkParameters::ParamSet& params) const;
+
+    // Replaces the file for this UUID. Only float and int32 params can be stored,
+    // which are all that PARAM_VALUE carries.
+    bool store(uint64_t uuid, uint32_t hash, const MAVLinkParameters::ParamSet& params) const;
+
+    std::string file_path(uint64_t uuid) const;
+
+private:
+    const std::string _directory;
+};
+
+} // namespace mavsdk
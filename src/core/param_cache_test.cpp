@@ -0,0 +1,87 @@
+#include "param_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+MAVLinkParameters::ParamSet example_params()
+{
+    MAVLinkParameters::ParamSet params;
+
+    MAVLinkParameters::ParamValue float_value;
+    // Not representable with a few decimals, so it needs to be stored exactly.
+    float_value.set<float>(0.1f + 1e-7f);
+    params.set(ParamId("MPC_XY_VEL_MAX"), float_value);
+
+    MAVLinkParameters::ParamValue int_value;
+    int_value.set<int32_t>(-42);
+    params.set(ParamId("SYS_AUTOSTART"), int_value);
+
+    return params;
+}
+
+} // namespace
+
+TEST(ParamCache, IsDisabledWithoutDirectory)
+{
+    ParamCache cache{""};
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_FALSE(cache.store(1, 2, example_params()));
+
+    uint32_t hash = 0;
+    MAVLinkParameters::ParamSet params;
+    EXPECT_FALSE(cache.load(1, hash, params));
+}
+
+TEST(ParamCache, LoadsWhatWasStored)
+{
+    ParamCache cache{testing::TempDir()};
+    const uint64_t uuid = 0x1234567890abcdef;
+    std::remove(cache.file_path(uuid).c_str());
+
+    uint32_t hash = 0;
+    MAVLinkParameters::ParamSet params;
+    EXPECT_FALSE(cache.load(uuid, hash, params));
+
+    ASSERT_TRUE(cache.store(uuid, 0xdeadbeef, example_params()));
+    ASSERT_TRUE(cache.load(uuid, hash, params));
+
+    EXPECT_EQ(hash, 0xdeadbeef);
+    ASSERT_EQ(params.size(), 2);
+    const auto* float_value = params.find("MPC_XY_VEL_MAX");
+    ASSERT_NE(float_value, nullptr);
+    EXPECT_TRUE(float_value->is<float>());
+    EXPECT_EQ(float_value->get<float>(), 0.1f + 1e-7f);
+    const auto* int_value = params.find("SYS_AUTOSTART");
+    ASSERT_NE(int_value, nullptr);
+    EXPECT_TRUE(int_value->is<int32_t>());
+    EXPECT_EQ(int_value->get<int32_t>(), -42);
+
+    // Other autopilots have their own file.
+    EXPECT_NE(cache.file_path(uuid), cache.file_path(uuid + 1));
+
+    std::remove(cache.file_path(uuid).c_str());
+}
+
+TEST(ParamCache, IgnoresTruncatedFile)
+{
+    ParamCache cache{testing::TempDir()};
+    const uint64_t uuid = 42;
+
+    {
+        std::ofstream file(cache.file_path(uuid), std::ios::trunc);
+        file << "mavsdk-param-cache-1 abcd 3\n";
+        file << "SYS_AUTOSTART 6 4e20\n";
+    }
+
+    uint32_t hash = 0;
+    MAVLinkParameters::ParamSet params;
+    EXPECT_FALSE(cache.load(uuid, hash, params));
+    EXPECT_TRUE(params.empty());
+
+    std::remove(cache.file_path(uuid).c_str());
+}
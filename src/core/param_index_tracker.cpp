@@ -0,0 +1,70 @@
+#include "param_index_tracker.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+void ParamIndexTracker::reset(uint16_t count)
+{
+    _count = count;
+    _received.assign(count, false);
+    _received_count = 0;
+    _seen_up_to = 0;
+    _first_missing = 0;
+    _in_flight.clear();
+}
+
+bool ParamIndexTracker::set_received(uint16_t index)
+{
+    if (index >= _count) {
+        return false;
+    }
+
+    _in_flight.erase(std::remove(_in_flight.begin(), _in_flight.end(), index), _in_flight.end());
+
+    if (_received[index]) {
+        return false;
+    }
+
+    _received[index] = true;
+    ++_received_count;
+    _seen_up_to = std::max(_seen_up_to, static_cast<uint32_t>(index) + 1);
+    while (_first_missing < _count && _received[_first_missing]) {
+        ++_first_missing;
+    }
+    return true;
+}
+
+void ParamIndexTracker::set_stream_ended()
+{
+    _seen_up_to = _count;
+}
+
+void ParamIndexTracker::set_requests_timed_out()
+{
+    _in_flight.clear();
+}
+
+std::vector<uint16_t> ParamIndexTracker::next_requests()
+{
+    std::vector<uint16_t> requests;
+
+    for (uint32_t index = _first_missing;
+         index < _seen_up_to && _in_flight.size() + requests.size() < _max_in_flight;
+         ++index) {
+        const auto index16 = static_cast<uint16_t>(index);
+        if (!_received[index] && !is_in_flight(index16)) {
+            requests.push_back(index16);
+        }
+    }
+
+    _in_flight.insert(_in_flight.end(), requests.begin(), requests.end());
+    return requests;
+}
+
+bool ParamIndexTracker::is_in_flight(uint16_t index) const
+{
+    return std::find(_in_flight.begin(), _in_flight.end(), index) != _in_flight.end();
+}
+
+} // namespace mavsdk
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Keeps track of which params of a list download have arrived, so that the ones lost on the way
+// can be requested by index while the rest of the list is still coming in.
+//
+// The list is assumed to be sent in order of index, so an index which is skipped is missing.
+// Once the end of the list was seen, or the stream timed out, every index not received yet is
+// missing. At most max_in_flight requests are outstanding at any time.
+class ParamIndexTracker {
+public:
+    explicit ParamIndexTracker(std::size_t max_in_flight) : _max_in_flight(max_in_flight) {}
+    ~ParamIndexTracker() = default;
+
+    // Starts over with a list of this many params.
+    void reset(uint16_t count);
+
+    // Returns false if the index is out of range or was already received.
+    bool set_received(uint16_t index);
+
+    // Everything which hasn't arrived by now is missing.
+    void set_stream_ended();
+
+    // Requests in flight are considered lost and will be returned by next_requests() again.
+    void set_requests_timed_out();
+
+    // Missing indices to request now.
+    std::vector<uint16_t> next_requests();
+
+    bool complete() const { return _count != 0 && _received_count == _count; }
+    uint16_t count() const { return _count; }
+    std::size_t received_count() const { return _received_count; }
+    std::size_t in_flight_count() const { return _in_flight.size(); }
+
+private:
+    bool is_in_flight(uint16_t index) const;
+
+    const std::size_t _max_in_flight;
+    uint16_t _count{0};
+    std::vector<bool> _received{};
+    std::size_t _received_count{0};
+    // Indices below this are either received or missing.
+    uint32_t _seen_up_to{0};
+    // Everything below this is received, so there is no need to look at it again.
+    uint32_t _first_missing{0};
+    std::vector<uint16_t> _in_flight{};
+};
+
+} // namespace mavsdk
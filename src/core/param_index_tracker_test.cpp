@@ -0,0 +1,116 @@
+#include "param_index_tracker.h"
+
+#include <deque>
+#include <random>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(ParamIndexTracker, RequestsSkippedIndicesRightAway)
+{
+    ParamIndexTracker tracker{2};
+    tracker.reset(10);
+
+    EXPECT_TRUE(tracker.set_received(0));
+    EXPECT_TRUE(tracker.next_requests().empty());
+
+    // 1 to 3 got lost, but only two requests may be in flight.
+    EXPECT_TRUE(tracker.set_received(4));
+    EXPECT_EQ(tracker.next_requests(), (std::vector<uint16_t>{1, 2}));
+    EXPECT_TRUE(tracker.next_requests().empty());
+
+    EXPECT_TRUE(tracker.set_received(2));
+    EXPECT_EQ(tracker.next_requests(), (std::vector<uint16_t>{3}));
+
+    // Duplicates and indices out of range are ignored.
+    EXPECT_FALSE(tracker.set_received(2));
+    EXPECT_FALSE(tracker.set_received(10));
+    EXPECT_EQ(tracker.received_count(), 3);
+    EXPECT_EQ(tracker.in_flight_count(), 2);
+}
+
+TEST(ParamIndexTracker, RequestsTailOnlyAfterStreamEnded)
+{
+    ParamIndexTracker tracker{10};
+    tracker.reset(4);
+
+    EXPECT_TRUE(tracker.set_received(0));
+    EXPECT_TRUE(tracker.set_received(1));
+    EXPECT_TRUE(tracker.next_requests().empty());
+
+    tracker.set_stream_ended();
+    EXPECT_EQ(tracker.next_requests(), (std::vector<uint16_t>{2, 3}));
+
+    // Nothing came back, so ask again.
+    EXPECT_TRUE(tracker.next_requests().empty());
+    tracker.set_requests_timed_out();
+    EXPECT_EQ(tracker.next_requests(), (std::vector<uint16_t>{2, 3}));
+
+    EXPECT_TRUE(tracker.set_received(3));
+    EXPECT_TRUE(tracker.set_received(2));
+    EXPECT_TRUE(tracker.complete());
+    EXPECT_EQ(tracker.in_flight_count(), 0);
+}
+
+TEST(ParamIndexTracker, CompletesOverLossyLinkInOnePass)
+{
+    constexpr uint16_t count = 1000;
+    constexpr double loss = 0.05;
+    // How many messages of the stream go by until the answer to a request comes back.
+    constexpr std::size_t round_trip_messages = 5;
+
+    for (unsigned seed = 0; seed < 10; ++seed) {
+        std::mt19937 rng{seed};
+        std::bernoulli_distribution lost{loss};
+
+        ParamIndexTracker tracker{10};
+        tracker.reset(count);
+
+        // What the autopilot sends, starting with the whole list.
+        std::deque<uint16_t> link;
+        for (uint16_t i = 0; i < count; ++i) {
+            link.push_back(i);
+        }
+
+        unsigned requests = 0;
+        unsigned timeouts = 0;
+
+        auto send_requests = [&]() {
+            for (const auto index : tracker.next_requests()) {
+                ++requests;
+                if (!lost(rng)) {
+                    link.insert(link.begin() + std::min(link.size(), round_trip_messages), index);
+                }
+            }
+        };
+
+        while (!tracker.complete() && timeouts < 10) {
+            if (link.empty()) {
+                ++timeouts;
+                tracker.set_stream_ended();
+                tracker.set_requests_timed_out();
+                send_requests();
+                continue;
+            }
+
+            const auto index = link.front();
+            link.pop_front();
+            if (lost(rng)) {
+                continue;
+            }
+
+            tracker.set_received(index);
+            if (index + 1 == count) {
+                tracker.set_stream_ended();
+            }
+            send_requests();
+        }
+
+        EXPECT_TRUE(tracker.complete()) << "seed " << seed;
+        // Lost requests and a lost end of the list can only be noticed by a timeout,
+        // but they don't take more than a few.
+        EXPECT_LE(timeouts, 3u) << "seed " << seed;
+        // Only the lost params are requested again, not the whole list.
+        EXPECT_LT(requests, count / 5) << "seed " << seed;
+    }
+}
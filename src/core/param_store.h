@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mavsdk {
+
+// Name of a param, stored inline in the 16 chars MAVLink has for it, so that it can be
+// compared and hashed without allocating a string.
+class ParamId {
+public:
+    static constexpr std::size_t LENGTH = 16;
+
+    ParamId() = default;
+
+    // Names longer than LENGTH are cut off.
+    explicit ParamId(const std::string& name) : ParamId(name.c_str(), name.size()) {}
+
+    // From the param_id field of a MAVLink message, which is not 0-terminated if it uses
+    // all 16 chars.
+    static ParamId from_mavlink(const char* param_id) { return ParamId(param_id, LENGTH); }
+
+    std::string to_string() const
+    {
+        std::size_t length = 0;
+        while (length < LENGTH && _chars[length] != '\0') {
+            ++length;
+        }
+        return std::string(_chars.data(), length);
+    }
+
+    // The 16 chars as used by MAVLink, padded with 0.
+    const char* data() const { return _chars.data(); }
+
+    bool empty() const { return _chars[0] == '\0'; }
+
+    // FNV-1a
+    uint32_t hash() const
+    {
+        uint32_t result = 2166136261u;
+        for (const char c : _chars) {
+            result ^= static_cast<uint8_t>(c);
+            result *= 16777619u;
+        }
+        return result;
+    }
+
+    friend bool operator==(const ParamId& lhs, const ParamId& rhs)
+    {
+        return lhs._chars == rhs._chars;
+    }
+
+    friend bool operator!=(const ParamId& lhs, const ParamId& rhs) { return !(lhs == rhs); }
+
+    // Same order as the names as strings, as the padding 0 comes before any char.
+    friend bool operator<(const ParamId& lhs, const ParamId& rhs)
+    {
+        return lhs._chars < rhs._chars;
+    }
+
+private:
+    ParamId(const char* name, std::size_t max_length)
+    {
+        // Everything after the end of the name stays 0, so that equal names compare equal.
+        for (std::size_t i = 0; i < LENGTH && i < max_length && name[i] != '\0'; ++i) {
+            _chars[i] = name[i];
+        }
+    }
+
+    std::array<char, LENGTH> _chars{};
+};
+
+// Hash map from ParamId to T, using open addressing with linear probing. Entries can't be
+// removed, which a param set never needs.
+template<typename T> class ParamIdMap {
+public:
+    ParamIdMap() = default;
+    ~ParamIdMap() = default;
+
+    T* find(const ParamId& id)
+    {
+        if (_slots.empty()) {
+            return nullptr;
+        }
+        Slot& slot = _slots[find_slot(id)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    const T* find(const ParamId& id) const
+    {
+        if (_slots.empty()) {
+            return nullptr;
+        }
+        const Slot& slot = _slots[find_slot(id)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    // Inserts a default constructed T if the id is not there yet.
+    T& operator[](const ParamId& id)
+    {
+        // Keep at least half of the slots free, so that probing stays short.
+        if ((_size + 1) * 2 > _slots.size()) {
+            rehash(std::max<std::size_t>(MIN_SLOTS, _slots.size() * 2));
+        }
+
+        Slot& slot = _slots[find_slot(id)];
+        if (!slot.used) {
+            slot.used = true;
+            slot.id = id;
+            ++_size;
+        }
+        return slot.value;
+    }
+
+    void reserve(std::size_t count)
+    {
+        std::size_t slots = MIN_SLOTS;
+        while (slots < count * 2) {
+            slots *= 2;
+        }
+        if (slots > _slots.size()) {
+            rehash(slots);
+        }
+    }
+
+    void clear()
+    {
+        _slots.clear();
+        _size = 0;
+    }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+private:
+    static constexpr std::size_t MIN_SLOTS = 16;
+
+    struct Slot {
+        ParamId id{};
+        T value{};
+        bool used{false};
+    };
+
+    // Index of the slot with this id, or of the empty slot where it belongs.
+    std::size_t find_slot(const ParamId& id) const
+    {
+        // The number of slots is a power of two.
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t index = id.hash() & mask;
+        while (_slots[index].used && _slots[index].id != id) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void rehash(std::size_t slot_count)
+    {
+        std::vector<Slot> old_slots(slot_count);
+        old_slots.swap(_slots);
+
+        for (auto& old_slot : old_slots) {
+            if (old_slot.used) {
+                Slot& slot = _slots[find_slot(old_slot.id)];
+                slot.used = true;
+                slot.id = old_slot.id;
+                slot.value = std::move(old_slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> _slots{};
+    std::size_t _size{0};
+};
+
+// Set of params with their values, in the order they were added, which can be looked up by
+// name as well as by the index the autopilot uses for them.
+template<typename Value> class ParamStore {
+public:
+    struct Entry {
+        ParamId id{};
+        Value value{};
+    };
+
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    ParamStore() = default;
+    ~ParamStore() = default;
+
+    void reserve(std::size_t count)
+    {
+        _entries.reserve(count);
+        _by_id.reserve(count);
+        _by_index.reserve(count);
+    }
+
+    // Adds the param or replaces its value. The index is the one of the autopilot, if known.
+    void set(const ParamId& id, const Value& value, int index = -1)
+    {
+        // Positions are stored plus 1, so that 0 means none.
+        uint32_t& position = _by_id[id];
+        if (position == 0) {
+            _entries.push_back(Entry{id, value});
+            position = static_cast<uint32_t>(_entries.size());
+        } else {
+            _entries[position - 1].value = value;
+        }
+
+        if (index >= 0) {
+            const auto unsigned_index = static_cast<std::size_t>(index);
+            if (unsigned_index >= _by_index.size()) {
+                _by_index.resize(unsigned_index + 1, 0);
+            }
+            _by_index[unsigned_index] = position;
+        }
+    }
+
+    const Value* find(const ParamId& id) const
+    {
+        const uint32_t* position = _by_id.find(id);
+        return position != nullptr ? &_entries[*position - 1].value : nullptr;
+    }
+
+    const Value* find(const std::string& name) const { return find(ParamId(name)); }
+
+    const Entry* find_by_index(uint16_t index) const
+    {
+        if (index >= _by_index.size() || _by_index[index] == 0) {
+            return nullptr;
+        }
+        return &_entries[_by_index[index] - 1];
+    }
+
+    void clear()
+    {
+        _entries.clear();
+        _by_id.clear();
+        _by_index.clear();
+    }
+
+    std::size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+
+    const_iterator begin() const { return _entries.begin(); }
+    const_iterator end() const { return _entries.end(); }
+
+    // The entries sorted by name, e.g. to present them in a stable order.
+    std::vector<const Entry*> sorted_by_name() const
+    {
+        std::vector<const Entry*> sorted;
+        sorted.reserve(_entries.size());
+        for (const auto& entry : _entries) {
+            sorted.push_back(&entry);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Entry* lhs, const Entry* rhs) {
+            return lhs->id < rhs->id;
+        });
+        return sorted;
+    }
+
+private:
+    std::vector<Entry> _entries{};
+    ParamIdMap<uint32_t> _by_id{};
+    std::vector<uint32_t> _by_index{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,105 @@
+#include "param_store.h"
+
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(ParamId, IsPaddedAndCutOff)
+{
+    EXPECT_EQ(ParamId("SYS_AUTOSTART").to_string(), "SYS_AUTOSTART");
+    EXPECT_EQ(ParamId("SYS_AUTOSTART"), ParamId(std::string("SYS_AUTOSTART")));
+    EXPECT_NE(ParamId("SYS_AUTOSTART"), ParamId("SYS_AUTOCONFIG"));
+    EXPECT_TRUE(ParamId().empty());
+
+    // As in a MAVLink message, with all 16 chars used and no 0-termination.
+    const char mavlink_id[20] = "CAL_ACC0_XOFF_ABCDE";
+    EXPECT_EQ(ParamId::from_mavlink(mavlink_id).to_string(), "CAL_ACC0_XOFF_AB");
+    EXPECT_EQ(ParamId::from_mavlink(mavlink_id), ParamId("CAL_ACC0_XOFF_AB"));
+
+    // Anything after the 0-termination doesn't matter.
+    const char garbage_id[16] = {'M', 'C', '_', 'A', '\0', 'x', 'y'};
+    EXPECT_EQ(ParamId::from_mavlink(garbage_id), ParamId("MC_A"));
+}
+
+TEST(ParamIdMap, FindsWhatWasInserted)
+{
+    ParamIdMap<int> map;
+    EXPECT_EQ(map.find(ParamId("A")), nullptr);
+
+    // Enough to rehash a few times.
+    for (int i = 0; i < 1000; ++i) {
+        map[ParamId("PARAM_" + std::to_string(i))] = i;
+    }
+    EXPECT_EQ(map.size(), 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        const int* value = map.find(ParamId("PARAM_" + std::to_string(i)));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_EQ(map.find(ParamId("PARAM_1000")), nullptr);
+
+    map[ParamId("PARAM_5")] = 42;
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(*map.find(ParamId("PARAM_5")), 42);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(ParamId("PARAM_5")), nullptr);
+}
+
+TEST(ParamStore, LooksUpByNameAndIndex)
+{
+    ParamStore<float> store;
+    store.reserve(3);
+
+    store.set(ParamId("MPC_XY_VEL_MAX"), 12.0f, 1);
+    store.set(ParamId("MPC_Z_VEL_MAX_UP"), 3.0f, 0);
+    store.set(ParamId("MIS_TAKEOFF_ALT"), 2.5f);
+
+    ASSERT_EQ(store.size(), 3);
+    ASSERT_NE(store.find("MPC_XY_VEL_MAX"), nullptr);
+    EXPECT_EQ(*store.find("MPC_XY_VEL_MAX"), 12.0f);
+    EXPECT_EQ(store.find("MPC_XY_VEL_MIN"), nullptr);
+
+    const auto* entry = store.find_by_index(0);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->id, ParamId("MPC_Z_VEL_MAX_UP"));
+    EXPECT_EQ(entry->value, 3.0f);
+    EXPECT_EQ(store.find_by_index(2), nullptr);
+
+    // Setting it again only replaces the value.
+    store.set(ParamId("MPC_Z_VEL_MAX_UP"), 4.0f, 0);
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(store.find_by_index(0)->value, 4.0f);
+
+    // Entries stay in the order they were added.
+    std::vector<std::string> names;
+    for (const auto& param : store) {
+        names.push_back(param.id.to_string());
+    }
+    EXPECT_EQ(
+        names,
+        (std::vector<std::string>{"MPC_XY_VEL_MAX", "MPC_Z_VEL_MAX_UP", "MIS_TAKEOFF_ALT"}));
+}
+
+TEST(ParamStore, SortsByName)
+{
+    ParamStore<int> store;
+    store.set(ParamId("SYS_AUTOSTART"), 0);
+    store.set(ParamId("MPC_XY_VEL_MAX"), 1);
+    store.set(ParamId("MPC_XY"), 2);
+    store.set(ParamId("CAL_ACC0_XOFF_AB"), 3);
+
+    EXPECT_LT(ParamId("MPC_XY"), ParamId("MPC_XY_VEL_MAX"));
+    EXPECT_FALSE(ParamId("MPC_XY") < ParamId("MPC_XY"));
+
+    std::vector<std::string> names;
+    for (const auto* entry : store.sorted_by_name()) {
+        names.push_back(entry->id.to_string());
+    }
+    EXPECT_EQ(
+        names,
+        (std::vector<std::string>{
+            "CAL_ACC0_XOFF_AB", "MPC_XY", "MPC_XY_VEL_MAX", "SYS_AUTOSTART"}));
+}
@@ -68,6 +68,8 @@ void Ping::process_ping(const mavlink_message_t& message)
 
         auto now_us = static_cast<uint64_t>(_system_impl.get_time().elapsed_s() * 1e6);
         _last_ping_time_us = now_us - ping.time_usec;
+
+        _system_impl.rtt_estimator().add_sample_s(last_ping_time_s());
     }
 }
 
@@ -4,7 +4,23 @@
 
 namespace mavsdk {
 
-PluginImplBase::PluginImplBase(System& system) : _parent(system.system_impl()) {}
-PluginImplBase::PluginImplBase(std::shared_ptr<System> system) : _parent(system->system_impl()) {}
+PluginImplBase::PluginImplBase(System& system) :
+    _parent(system.system_impl()),
+    _queue_user_callback(make_queue_user_callback())
+{}
+
+PluginImplBase::PluginImplBase(std::shared_ptr<System> system) :
+    _parent(system->system_impl()),
+    _queue_user_callback(make_queue_user_callback())
+{}
+
+CallbackQueueFunc PluginImplBase::make_queue_user_callback()
+{
+    return [this](
+               UserCallbackQueue::Func func,
+               const std::shared_ptr<UserCallbackQueue::Subscription>& subscription) {
+        _parent->call_user_callback(std::move(func), subscription);
+    };
+}
 
 } // namespace mavsdk
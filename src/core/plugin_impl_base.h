@@ -1,4 +1,5 @@
 #pragma once
+#include "callback_list.h"
 #include "system_impl.h"
 #include <memory>
 
@@ -60,6 +61,13 @@ public:
 
 protected:
     std::shared_ptr<SystemImpl> _parent;
+
+    // Queues the callbacks of a CallbackList as user callbacks, e.g.
+    // `_position_subscriptions.queue(_queue_user_callback, position)`.
+    const CallbackQueueFunc _queue_user_callback;
+
+private:
+    CallbackQueueFunc make_queue_user_callback();
 };
 
 } // namespace mavsdk
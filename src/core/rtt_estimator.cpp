@@ -0,0 +1,56 @@
+#include "rtt_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+constexpr double RttEstimator::MIN_TIMEOUT_S;
+constexpr double RttEstimator::MAX_TIMEOUT_S;
+constexpr double RttEstimator::MAX_SAMPLE_S;
+constexpr double RttEstimator::MAX_BACKOFF_TIMEOUT_S;
+
+void RttEstimator::add_sample_s(double rtt_s)
+{
+    if (!(rtt_s > 0.0) || rtt_s > MAX_SAMPLE_S) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_smoothed_rtt_s < 0.0) {
+        _smoothed_rtt_s = rtt_s;
+        _rtt_variation_s = rtt_s / 2.0;
+        return;
+    }
+
+    // Gains of 1/4 and 1/8 as suggested by RFC 6298.
+    _rtt_variation_s = 0.75 * _rtt_variation_s + 0.25 * std::fabs(_smoothed_rtt_s - rtt_s);
+    _smoothed_rtt_s = 0.875 * _smoothed_rtt_s + 0.125 * rtt_s;
+}
+
+double RttEstimator::timeout_s(double default_s) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_smoothed_rtt_s < 0.0) {
+        return default_s;
+    }
+
+    return std::min(
+        std::max(_smoothed_rtt_s + 4.0 * _rtt_variation_s, MIN_TIMEOUT_S), MAX_TIMEOUT_S);
+}
+
+double RttEstimator::smoothed_rtt_s() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _smoothed_rtt_s;
+}
+
+double RttEstimator::backed_off_s(double timeout_s)
+{
+    // A timeout which is already longer than the limit is not cut short.
+    return std::max(timeout_s, std::min(2.0 * timeout_s, MAX_BACKOFF_TIMEOUT_S));
+}
+
+} // namespace mavsdk
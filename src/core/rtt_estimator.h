@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mutex>
+
+namespace mavsdk {
+
+// Estimates the round trip time to a system, the way TCP does (RFC 6298), so
+// that retransmission timeouts can follow the link instead of being fixed.
+//
+// Samples come from anything which is answered right away, e.g. pings,
+// timesync and command acks. Samples of retransmitted requests must not be
+// added, because it's unknown which transmission the answer was for.
+class RttEstimator {
+public:
+    RttEstimator() = default;
+    ~RttEstimator() = default;
+
+    // Ignores samples which are not positive or implausibly long.
+    void add_sample_s(double rtt_s);
+
+    // Smoothed RTT plus four times its variation, within reasonable bounds,
+    // or default_s as long as there is no sample yet.
+    double timeout_s(double default_s) const;
+
+    // Negative as long as there is no sample yet.
+    double smoothed_rtt_s() const;
+
+    // The timeout to use after one has expired without an answer: twice as long, as
+    // RFC 6298 (5.5) says, up to MAX_BACKOFF_TIMEOUT_S.
+    static double backed_off_s(double timeout_s);
+
+    static constexpr double MIN_TIMEOUT_S = 0.1;
+    static constexpr double MAX_TIMEOUT_S = 5.0;
+    static constexpr double MAX_SAMPLE_S = 10.0;
+    static constexpr double MAX_BACKOFF_TIMEOUT_S = 10.0;
+
+    // Non-copyable
+    RttEstimator(const RttEstimator&) = delete;
+    const RttEstimator& operator=(const RttEstimator&) = delete;
+
+private:
+    mutable std::mutex _mutex{};
+    double _smoothed_rtt_s{-1.0};
+    double _rtt_variation_s{0.0};
+};
+
+} // namespace mavsdk
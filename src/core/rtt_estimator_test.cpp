@@ -0,0 +1,67 @@
+#include "rtt_estimator.h"
+
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(RttEstimator, UsesDefaultWithoutSamples)
+{
+    RttEstimator rtt_estimator;
+    EXPECT_LT(rtt_estimator.smoothed_rtt_s(), 0.0);
+    EXPECT_DOUBLE_EQ(rtt_estimator.timeout_s(0.5), 0.5);
+
+    // Not plausible, so still nothing.
+    rtt_estimator.add_sample_s(0.0);
+    rtt_estimator.add_sample_s(-1.0);
+    rtt_estimator.add_sample_s(100.0);
+    EXPECT_DOUBLE_EQ(rtt_estimator.timeout_s(0.5), 0.5);
+}
+
+TEST(RttEstimator, FollowsTheLink)
+{
+    RttEstimator rtt_estimator;
+
+    // A slow radio link.
+    for (int i = 0; i < 50; ++i) {
+        rtt_estimator.add_sample_s(0.8);
+    }
+    EXPECT_NEAR(rtt_estimator.smoothed_rtt_s(), 0.8, 0.01);
+    EXPECT_GT(rtt_estimator.timeout_s(0.5), 0.8);
+
+    // Then a fast one, where the timeout goes down to the minimum.
+    for (int i = 0; i < 100; ++i) {
+        rtt_estimator.add_sample_s(0.002);
+    }
+    EXPECT_NEAR(rtt_estimator.smoothed_rtt_s(), 0.002, 0.001);
+    EXPECT_DOUBLE_EQ(rtt_estimator.timeout_s(0.5), RttEstimator::MIN_TIMEOUT_S);
+}
+
+TEST(RttEstimator, AllowsForJitter)
+{
+    RttEstimator steady;
+    RttEstimator jittery;
+
+    for (int i = 0; i < 50; ++i) {
+        steady.add_sample_s(0.3);
+        jittery.add_sample_s(i % 2 == 0 ? 0.1 : 0.5);
+    }
+
+    EXPECT_GT(jittery.timeout_s(0.5), steady.timeout_s(0.5));
+    EXPECT_LE(jittery.timeout_s(0.5), RttEstimator::MAX_TIMEOUT_S);
+}
+
+TEST(RttEstimator, BacksOffUpToLimit)
+{
+    double timeout_s = RttEstimator::MIN_TIMEOUT_S;
+    timeout_s = RttEstimator::backed_off_s(timeout_s);
+    EXPECT_DOUBLE_EQ(timeout_s, 2.0 * RttEstimator::MIN_TIMEOUT_S);
+    timeout_s = RttEstimator::backed_off_s(timeout_s);
+    EXPECT_DOUBLE_EQ(timeout_s, 4.0 * RttEstimator::MIN_TIMEOUT_S);
+
+    for (int i = 0; i < 10; ++i) {
+        timeout_s = RttEstimator::backed_off_s(timeout_s);
+    }
+    EXPECT_DOUBLE_EQ(timeout_s, RttEstimator::MAX_BACKOFF_TIMEOUT_S);
+
+    EXPECT_DOUBLE_EQ(RttEstimator::backed_off_s(30.0), 30.0);
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace mavsdk {
+
+// Holds a value which is read a lot more often than it is written, e.g. the
+// latest telemetry, without readers ever waiting for a mutex.
+//
+// Readers copy the value and try again if it was written meanwhile, which they
+// can tell from the sequence number. Writers only wait for each other.
+//
+// The value is kept as atomic words so that copying it while it is written is
+// not a data race. Therefore, T has to be trivially copyable.
+template<typename T> class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable T");
+
+public:
+    Seqlock() : Seqlock(T{}) {}
+    explicit Seqlock(const T& value) { write_bytes(0, sizeof(T), &value); }
+
+    T load() const
+    {
+        T value;
+        read_bytes(0, sizeof(T), &value);
+        return value;
+    }
+
+    // Only copies the member, not the whole value.
+    template<typename M> M load(M T::*member) const
+    {
+        M value;
+        read_bytes(offset_of(member), sizeof(M), &value);
+        return value;
+    }
+
+    void store(const T& value)
+    {
+        lock();
+        write_bytes(0, sizeof(T), &value);
+        unlock();
+    }
+
+    template<typename M> void store(M T::*member, const M& value)
+    {
+        lock();
+        write_bytes(offset_of(member), sizeof(M), &value);
+        unlock();
+    }
+
+    // Calls func with the member to change, without any other writer in between.
+    template<typename M, typename F> void update(M T::*member, F func)
+    {
+        const size_t offset = offset_of(member);
+
+        lock();
+        M value;
+        copy_bytes(offset, sizeof(M), &value);
+        func(value);
+        write_bytes(offset, sizeof(M), &value);
+        unlock();
+    }
+
+    // Non-copyable
+    Seqlock(const Seqlock&) = delete;
+    const Seqlock& operator=(const Seqlock&) = delete;
+
+private:
+    using Word = uintptr_t;
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    template<typename M> static size_t offset_of(M T::*member)
+    {
+        static const T dummy{};
+        return static_cast<size_t>(
+            reinterpret_cast<const char*>(&(dummy.*member)) -
+            reinterpret_cast<const char*>(&dummy));
+    }
+
+    void lock()
+    {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        while (true) {
+            // An odd sequence means that someone else is writing.
+            if ((sequence & 1) == 0 &&
+                _sequence.compare_exchange_weak(
+                    sequence, sequence + 1, std::memory_order_relaxed)) {
+                break;
+            }
+            if ((sequence & 1) != 0) {
+                std::this_thread::yield();
+                sequence = _sequence.load(std::memory_order_relaxed);
+            }
+        }
+        // Readers which see any of the words written after this also see the odd sequence.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void unlock() { _sequence.fetch_add(1, std::memory_order_release); }
+
+    void read_bytes(size_t offset, size_t len, void* dst) const
+    {
+        const size_t first = offset / sizeof(Word);
+        const size_t last = (offset + len - 1) / sizeof(Word);
+        Word buffer[NUM_WORDS];
+
+        while (true) {
+            const uint32_t sequence = _sequence.load(std::memory_order_acquire);
+            if ((sequence & 1) != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = first; i <= last; ++i) {
+                buffer[i - first] = _words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                break;
+            }
+        }
+
+        std::memcpy(dst, reinterpret_cast<const char*>(buffer) + offset % sizeof(Word), len);
+    }
+
+    // Only to be used while writing, so no one else can change the words.
+    void copy_bytes(size_t offset, size_t len, void* dst) const
+    {
+        const size_t first = offset / sizeof(Word);
+        const size_t last = (offset + len - 1) / sizeof(Word);
+        Word buffer[NUM_WORDS];
+
+        for (size_t i = first; i <= last; ++i) {
+            buffer[i - first] = _words[i].load(std::memory_order_relaxed);
+        }
+        std::memcpy(dst, reinterpret_cast<const char*>(buffer) + offset % sizeof(Word), len);
+    }
+
+    void write_bytes(size_t offset, size_t len, const void* src)
+    {
+        const size_t first = offset / sizeof(Word);
+        const size_t last = (offset + len - 1) / sizeof(Word);
+        Word buffer[NUM_WORDS];
+
+        // The words at either end can be shared with other members, which we keep.
+        buffer[0] = _words[first].load(std::memory_order_relaxed);
+        buffer[last - first] = _words[last].load(std::memory_order_relaxed);
+        std::memcpy(reinterpret_cast<char*>(buffer) + offset % sizeof(Word), src, len);
+
+        for (size_t i = first; i <= last; ++i) {
+            _words[i].store(buffer[i - first], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint32_t> _sequence{0};
+    std::atomic<Word> _words[NUM_WORDS]{};
+};
+
+} // namespace mavsdk
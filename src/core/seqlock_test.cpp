@@ -0,0 +1,120 @@
+#include "seqlock.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+struct State {
+    double a{1.0};
+    uint8_t b{2};
+    float c{3.0f};
+    bool d{true};
+    uint64_t e{5};
+};
+
+struct Counters {
+    uint32_t values[16]{};
+};
+
+} // namespace
+
+TEST(Seqlock, LoadsWhatWasStored)
+{
+    Seqlock<State> seqlock;
+
+    State state = seqlock.load();
+    EXPECT_EQ(state.a, 1.0);
+    EXPECT_EQ(state.e, 5);
+
+    state.a = 42.0;
+    state.e = 43;
+    seqlock.store(state);
+
+    state = seqlock.load();
+    EXPECT_EQ(state.a, 42.0);
+    EXPECT_EQ(state.b, 2);
+    EXPECT_EQ(state.e, 43);
+}
+
+TEST(Seqlock, StoresMemberWithoutTouchingOthers)
+{
+    Seqlock<State> seqlock;
+
+    seqlock.store(&State::b, uint8_t{20});
+    seqlock.store(&State::d, false);
+    seqlock.store(&State::c, 30.0f);
+
+    EXPECT_EQ(seqlock.load(&State::b), 20);
+    EXPECT_EQ(seqlock.load(&State::c), 30.0f);
+    EXPECT_EQ(seqlock.load(&State::d), false);
+
+    const State state = seqlock.load();
+    EXPECT_EQ(state.a, 1.0);
+    EXPECT_EQ(state.b, 20);
+    EXPECT_EQ(state.c, 30.0f);
+    EXPECT_EQ(state.d, false);
+    EXPECT_EQ(state.e, 5);
+}
+
+TEST(Seqlock, ReadersNeverSeeTornValues)
+{
+    Seqlock<Counters> seqlock;
+    std::atomic<bool> done{false};
+    std::atomic<unsigned> torn{0};
+
+    std::vector<std::thread> readers;
+    for (unsigned i = 0; i < 3; ++i) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                const Counters counters = seqlock.load();
+                for (auto value : counters.values) {
+                    if (value != counters.values[0]) {
+                        ++torn;
+                    }
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < 100000; ++i) {
+        Counters counters;
+        for (auto& value : counters.values) {
+            value = i;
+        }
+        seqlock.store(counters);
+    }
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(seqlock.load().values[15], 99999);
+}
+
+TEST(Seqlock, WritersDontLoseUpdates)
+{
+    Seqlock<State> seqlock;
+    seqlock.store(&State::e, uint64_t{0});
+
+    std::vector<std::thread> writers;
+    for (unsigned i = 0; i < 4; ++i) {
+        writers.emplace_back([&]() {
+            for (unsigned j = 0; j < 10000; ++j) {
+                seqlock.update(&State::e, [](uint64_t& value) { ++value; });
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    EXPECT_EQ(seqlock.load(&State::e), 40000);
+    EXPECT_EQ(seqlock.load(&State::a), 1.0);
+}
@@ -72,6 +72,12 @@ ConnectionResult SerialConnection::start()
         return ret;
     }
 
+#if defined(LINUX) || defined(APPLE)
+    if (add_to_io_reactor(_fd, [this]() { receive_once(); })) {
+        return ConnectionResult::Success;
+    }
+#endif
+
     start_recv_thread();
 
     return ConnectionResult::Success;
@@ -229,6 +235,11 @@ ConnectionResult SerialConnection::stop()
 {
     _should_exit = true;
 
+#if defined(LINUX) || defined(APPLE)
+    // The fd needs to be removed before it is closed and possibly reused.
+    remove_from_io_reactor(_fd);
+#endif
+
     if (_recv_thread) {
         _recv_thread->join();
         delete _recv_thread;
@@ -248,7 +259,7 @@ ConnectionResult SerialConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool SerialConnection::send_message(const mavlink_message_t& message)
+bool SerialConnection::send_bytes(const uint8_t* data, unsigned len)
 {
     if (_serial_node.empty()) {
         LogErr() << "Dev Path unknown";
@@ -260,20 +271,17 @@ bool SerialConnection::send_message(const mavlink_message_t& message)
         return false;
     }
 
-    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
     int send_len;
 #if defined(LINUX) || defined(APPLE)
-    send_len = static_cast<int>(write(_fd, buffer, buffer_len));
+    send_len = static_cast<int>(write(_fd, data, len));
 #else
-    if (!WriteFile(_handle, buffer, buffer_len, LPDWORD(&send_len), NULL)) {
+    if (!WriteFile(_handle, data, len, LPDWORD(&send_len), NULL)) {
         LogErr() << "WriteFile failure: " << GET_ERROR();
         return false;
     }
 #endif
 
-    if (send_len != buffer_len) {
+    if (send_len != static_cast<int>(len)) {
         LogErr() << "write failure: " << GET_ERROR();
         return false;
     }
@@ -283,9 +291,6 @@ bool SerialConnection::send_message(const mavlink_message_t& message)
 
 void SerialConnection::receive()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
-
 #if defined(LINUX) || defined(APPLE)
     struct pollfd fds[1];
     fds[0].fd = _fd;
@@ -293,7 +298,6 @@ void SerialConnection::receive()
 #endif
 
     while (!_should_exit) {
-        int recv_len;
 #if defined(LINUX) || defined(APPLE)
         int pollrc = poll(fds, 1, 1000);
         if (pollrc == 0 || !(fds[0].revents & POLLIN)) {
@@ -302,24 +306,35 @@ void SerialConnection::receive()
             LogErr() << "read poll failure: " << GET_ERROR();
         }
         // We enter here if (fds[0].revents & POLLIN) == true
-        recv_len = static_cast<int>(read(_fd, buffer, sizeof(buffer)));
-        if (recv_len < -1) {
-            LogErr() << "read failure: " << GET_ERROR();
-        }
+#endif
+        receive_once();
+    }
+}
+
+void SerialConnection::receive_once()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
+
+    int recv_len;
+#if defined(LINUX) || defined(APPLE)
+    recv_len = static_cast<int>(read(_fd, buffer, sizeof(buffer)));
+    if (recv_len < -1) {
+        LogErr() << "read failure: " << GET_ERROR();
+    }
 #else
-        if (!ReadFile(_handle, buffer, sizeof(buffer), LPDWORD(&recv_len), NULL)) {
-            LogErr() << "ReadFile failure: " << GET_ERROR();
-            continue;
-        }
+    if (!ReadFile(_handle, buffer, sizeof(buffer), LPDWORD(&recv_len), NULL)) {
+        LogErr() << "ReadFile failure: " << GET_ERROR();
+        return;
+    }
 #endif
-        if (recv_len > static_cast<int>(sizeof(buffer)) || recv_len == 0) {
-            continue;
-        }
-        _mavlink_receiver->set_new_datagram(buffer, recv_len);
-        // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            receive_message(_mavlink_receiver->get_last_message());
-        }
+    if (recv_len > static_cast<int>(sizeof(buffer)) || recv_len <= 0) {
+        return;
+    }
+    _mavlink_receiver->set_new_datagram(buffer, recv_len);
+    // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        receive_message(_mavlink_receiver->get_last_message());
     }
 }
 
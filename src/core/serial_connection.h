@@ -21,16 +21,18 @@ public:
     ConnectionResult stop() override;
     ~SerialConnection();
 
-    bool send_message(const mavlink_message_t& message) override;
-
     // Non-copyable
     SerialConnection(const SerialConnection&) = delete;
     const SerialConnection& operator=(const SerialConnection&) = delete;
 
+protected:
+    bool send_bytes(const uint8_t* data, unsigned len) override;
+
 private:
     ConnectionResult setup_port();
     void start_recv_thread();
     void receive();
+    void receive_once();
 
 #if defined(LINUX)
     static int define_from_baudrate(int baudrate);
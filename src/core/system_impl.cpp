@@ -25,7 +25,11 @@ SystemImpl::SystemImpl(MavsdkImpl& parent, uint8_t system_id, uint8_t comp_id, b
     _receive_commands(*this),
     _timesync(*this),
     _ping(*this),
-    _mission_transfer(*this, _message_handler, _parent.timeout_handler)
+    _mission_transfer(
+        *this,
+        _message_handler,
+        _parent.timeout_handler,
+        [this](double default_s) { return _rtt_estimator.timeout_s(default_s); })
 {
     _target_address.system_id = system_id;
     // FIXME: for now use this as a default.
@@ -37,6 +41,19 @@ SystemImpl::SystemImpl(MavsdkImpl& parent, uint8_t system_id, uint8_t comp_id, b
         _uuid_initialized = true;
         set_connected();
     }
+    _params.set_wakeup_callback([this]() { wake_system_thread(); });
+    _send_commands.set_wakeup_callback([this]() { wake_system_thread(); });
+    _mission_transfer.set_wakeup_callback([this]() { wake_system_thread(); });
+
+    add_call_every(
+        [this]() {
+            if (is_connected()) {
+                _ping.run_once();
+            }
+        },
+        _ping_interval_s,
+        &_ping_cookie);
+
     _system_thread = new std::thread(&SystemImpl::system_thread, this);
 
     _message_handler.register_one(
@@ -64,8 +81,10 @@ SystemImpl::~SystemImpl()
     if (!_always_connected) {
         unregister_timeout_handler(_heartbeat_timeout_cookie);
     }
+    remove_call_every(_ping_cookie);
 
     if (_system_thread != nullptr) {
+        wake_system_thread();
         _system_thread->join();
         delete _system_thread;
         _system_thread = nullptr;
@@ -239,29 +258,26 @@ void SystemImpl::heartbeats_timed_out()
 
 void SystemImpl::system_thread()
 {
-    dl_time_t last_ping_time{};
-
     while (!_should_exit) {
         _params.do_work();
         _send_commands.do_work();
-        _timesync.do_work();
         _mission_transfer.do_work();
 
-        if (_time.elapsed_since_s(last_ping_time) >= SystemImpl::_ping_interval_s) {
-            if (_connected) {
-                _ping.run_once();
-            }
-            last_ping_time = _time.steady_time();
-        }
+        // Sleep until any of the work queues changes instead of polling them.
+        std::unique_lock<std::mutex> lock(_system_thread_mutex);
+        _system_thread_cv.wait(
+            lock, [this]() { return _system_thread_work_pending || _should_exit; });
+        _system_thread_work_pending = false;
+    }
+}
 
-        if (_connected) {
-            // Work fairly fast if we're connected.
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        } else {
-            // Be less aggressive when unconnected.
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+void SystemImpl::wake_system_thread()
+{
+    {
+        std::lock_guard<std::mutex> lock(_system_thread_mutex);
+        _system_thread_work_pending = true;
     }
+    _system_thread_cv.notify_one();
 }
 
 std::string SystemImpl::component_name(uint8_t component_id)
@@ -586,7 +602,7 @@ MAVLinkParameters::Result SystemImpl::set_param_int(const std::string& name, int
     return _params.set_param(name, param_value, false);
 }
 
-std::map<std::string, MAVLinkParameters::ParamValue> SystemImpl::get_all_params()
+MAVLinkParameters::ParamSet SystemImpl::get_all_params()
 {
     return _params.get_all_params();
 }
@@ -1106,6 +1122,41 @@ void SystemImpl::set_msg_rate_async(
     send_command_async(command, callback);
 }
 
+MavlinkCommandSender::Result SystemImpl::set_msg_rates(
+    const std::vector<std::pair<uint16_t, double>>& rates, uint8_t component_id)
+{
+    if (_target_address.system_id == 0 && _components.size() == 0) {
+        return MavlinkCommandSender::Result::NoSystem;
+    }
+    return _send_commands.send_commands(make_commands_msg_rate(rates, component_id));
+}
+
+void SystemImpl::set_msg_rates_async(
+    const std::vector<std::pair<uint16_t, double>>& rates,
+    CommandResultCallback callback,
+    uint8_t component_id)
+{
+    if (_target_address.system_id == 0 && _components.size() == 0) {
+        if (callback) {
+            callback(MavlinkCommandSender::Result::NoSystem, NAN);
+        }
+        return;
+    }
+    _send_commands.queue_commands_async(make_commands_msg_rate(rates, component_id), callback);
+}
+
+std::vector<MavlinkCommandSender::CommandLong> SystemImpl::make_commands_msg_rate(
+    const std::vector<std::pair<uint16_t, double>>& rates, uint8_t component_id)
+{
+    std::vector<MavlinkCommandSender::CommandLong> commands;
+    commands.reserve(rates.size());
+    for (const auto& rate : rates) {
+        commands.push_back(make_command_msg_rate(rate.first, rate.second, component_id));
+        commands.back().target_system_id = get_system_id();
+    }
+    return commands;
+}
+
 MavlinkCommandSender::CommandLong
 SystemImpl::make_command_msg_rate(uint16_t message_id, double rate_hz, uint8_t component_id)
 {
@@ -1164,9 +1215,19 @@ void SystemImpl::unregister_plugin(PluginImplBase* plugin_impl)
 }
 
 void SystemImpl::call_user_callback_located(
-    const std::string& filename, const int linenumber, const std::function<void()>& func)
+    const char* filename, const int linenumber, UserCallbackQueue::Func func)
+{
+    _parent.call_user_callback_located(
+        filename, linenumber, std::move(func), _user_callback_strand);
+}
+
+void SystemImpl::call_user_callback_located(
+    const char* filename,
+    const int linenumber,
+    UserCallbackQueue::Func func,
+    const std::shared_ptr<UserCallbackQueue::Subscription>& subscription)
 {
-    _parent.call_user_callback_located(filename, linenumber, func);
+    _parent.call_user_callback_located(filename, linenumber, std::move(func), subscription);
 }
 
 void SystemImpl::param_changed(const std::string& name)
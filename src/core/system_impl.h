@@ -9,9 +9,11 @@
 #include "mavlink_mission_transfer.h"
 #include "mavlink_statustext_handler.h"
 #include "ping.h"
+#include "rtt_estimator.h"
 #include "timeout_handler.h"
 #include "safe_queue.h"
 #include "timesync.h"
+#include "user_callback_queue.h"
 #include "system.h"
 #include <cstdint>
 #include <functional>
@@ -21,6 +23,7 @@
 #include <unordered_map>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <future>
 
 namespace mavsdk {
@@ -101,6 +104,16 @@ public:
         CommandResultCallback callback,
         uint8_t component_id = MAV_COMP_ID_AUTOPILOT1);
 
+    // Sets several rates at once, as pairs of message id and rate.
+    MavlinkCommandSender::Result set_msg_rates(
+        const std::vector<std::pair<uint16_t, double>>& rates,
+        uint8_t component_id = MAV_COMP_ID_AUTOPILOT1);
+
+    void set_msg_rates_async(
+        const std::vector<std::pair<uint16_t, double>>& rates,
+        CommandResultCallback callback,
+        uint8_t component_id = MAV_COMP_ID_AUTOPILOT1);
+
     // Adds unique component ids
     void add_new_component(uint8_t component_id);
     size_t total_components() const;
@@ -133,7 +146,7 @@ public:
     MAVLinkParameters::Result set_param_int(const std::string& name, int32_t value);
     MAVLinkParameters::Result set_param_ext_float(const std::string& name, float value);
     MAVLinkParameters::Result set_param_ext_int(const std::string& name, int32_t value);
-    std::map<std::string, MAVLinkParameters::ParamValue> get_all_params();
+    MAVLinkParameters::ParamSet get_all_params();
 
     typedef std::function<void(MAVLinkParameters::Result result)> success_t;
     void set_param_float_async(
@@ -220,11 +233,19 @@ public:
 
     double get_ping_time_s() const { return _ping.last_ping_time_s(); }
 
+    // Retransmission timeouts towards this system are based on it.
+    RttEstimator& rtt_estimator() { return _rtt_estimator; }
+
     void register_plugin(PluginImplBase* plugin_impl);
     void unregister_plugin(PluginImplBase* plugin_impl);
 
     void call_user_callback_located(
-        const std::string& filename, const int linenumber, const std::function<void()>& func);
+        const char* filename, const int linenumber, UserCallbackQueue::Func func);
+    void call_user_callback_located(
+        const char* filename,
+        const int linenumber,
+        UserCallbackQueue::Func func,
+        const std::shared_ptr<UserCallbackQueue::Subscription>& subscription);
 
     void send_autopilot_version_request();
     void send_flight_information_request();
@@ -268,6 +289,7 @@ private:
     static ComponentType component_type(uint8_t component_id);
 
     void system_thread();
+    void wake_system_thread();
 
     // We use std::pair instead of a std::optional.
     std::pair<MavlinkCommandSender::Result, MavlinkCommandSender::CommandLong>
@@ -275,6 +297,8 @@ private:
 
     MavlinkCommandSender::CommandLong
     make_command_msg_rate(uint16_t message_id, double rate_hz, uint8_t component_id);
+    std::vector<MavlinkCommandSender::CommandLong> make_commands_msg_rate(
+        const std::vector<std::pair<uint16_t, double>>& rates, uint8_t component_id);
 
     static void receive_float_param(
         MAVLinkParameters::Result result,
@@ -310,10 +334,18 @@ private:
 
     MavsdkImpl& _parent;
 
+    // Callbacks of this system which don't have a subscription of their own are
+    // called in order on this strand, so they aren't held up by other systems.
+    std::shared_ptr<UserCallbackQueue::Subscription> _user_callback_strand{
+        UserCallbackQueue::make_subscription(UserCallbackQueue::OverflowPolicy::DropNewest)};
+
     CommandResultCallback _command_result_callback{nullptr};
 
     std::thread* _system_thread{nullptr};
     std::atomic<bool> _should_exit{false};
+    std::mutex _system_thread_mutex{};
+    std::condition_variable _system_thread_cv{};
+    bool _system_thread_work_pending{false};
 
     static constexpr double _HEARTBEAT_TIMEOUT_S = 3.0;
 
@@ -326,6 +358,9 @@ private:
     void* _autopilot_version_timed_out_cookie = nullptr;
 
     static constexpr double _ping_interval_s = 5.0;
+    void* _ping_cookie{nullptr};
+
+    RttEstimator _rtt_estimator{};
 
     MAVLinkParameters _params;
     MavlinkCommandSender _send_commands;
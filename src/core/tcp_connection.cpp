@@ -52,7 +52,9 @@ ConnectionResult TcpConnection::start()
         return ret;
     }
 
-    start_recv_thread();
+    if (!add_to_io_reactor(_socket_fd, [this]() { receive_from_io_reactor(); })) {
+        start_recv_thread();
+    }
 
     return ConnectionResult::Success;
 }
@@ -99,12 +101,19 @@ void TcpConnection::start_recv_thread()
 
 ConnectionResult TcpConnection::stop()
 {
-    _should_exit = true;
+    {
+        // Prevent a receive thread from being started while we stop.
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = true;
+    }
 
 #ifndef WINDOWS
     // This should interrupt a recv/recvfrom call.
     shutdown(_socket_fd, SHUT_RDWR);
 
+    // The fd needs to be removed before it is closed and possibly reused.
+    remove_from_io_reactor(_socket_fd);
+
     // But on Mac, closing is also needed to stop blocking recv/recvfrom.
     close(_socket_fd);
 #else
@@ -128,7 +137,7 @@ ConnectionResult TcpConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool TcpConnection::send_message(const mavlink_message_t& message)
+bool TcpConnection::send_bytes(const uint8_t* data, unsigned len)
 {
     if (_remote_ip.empty()) {
         LogErr() << "Remote IP unknown";
@@ -147,21 +156,15 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
 
     dest_addr.sin_port = htons(_remote_port_number);
 
-    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
-    // TODO: remove this assert again
-    assert(buffer_len <= MAVLINK_MAX_PACKET_LEN);
-
     const auto send_len = sendto(
         _socket_fd,
-        reinterpret_cast<char*>(buffer),
-        buffer_len,
+        reinterpret_cast<const char*>(data),
+        len,
         0,
         reinterpret_cast<const sockaddr*>(&dest_addr),
         sizeof(dest_addr));
 
-    if (send_len != buffer_len) {
+    if (send_len < 0 || static_cast<unsigned>(send_len) != len) {
         LogErr() << "sendto failure: " << GET_ERROR(errno);
         _is_ok = false;
         return false;
@@ -171,9 +174,6 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
 
 void TcpConnection::receive()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
-
     while (!_should_exit) {
         if (!_is_ok) {
             LogErr() << "TCP receive error, trying to reconnect...";
@@ -181,30 +181,53 @@ void TcpConnection::receive()
             setup_port();
         }
 
-        const auto recv_len = recv(_socket_fd, buffer, sizeof(buffer), 0);
+        receive_once();
+    }
+}
 
-        if (recv_len == 0) {
-            // This can happen when shutdown is called on the socket,
-            // therefore we check _should_exit again.
-            _is_ok = false;
-            continue;
+void TcpConnection::receive_from_io_reactor()
+{
+    receive_once();
+
+    if (!_is_ok) {
+        // Reconnecting blocks, so we leave that to our own receive thread
+        // rather than holding up the other connections.
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_should_exit) {
+            remove_from_io_reactor(_socket_fd);
+            start_recv_thread();
         }
+    }
+}
 
-        if (recv_len < 0) {
-            // This happens on desctruction when close(_socket_fd) is called,
-            // therefore be quiet.
-            // LogErr() << "recvfrom error: " << GET_ERROR(errno);
-            // Something went wrong, we should try to re-connect in next iteration.
-            _is_ok = false;
-            continue;
-        }
+void TcpConnection::receive_once()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
 
-        _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+    const auto recv_len = recv(_socket_fd, buffer, sizeof(buffer), 0);
 
-        // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            receive_message(_mavlink_receiver->get_last_message());
-        }
+    if (recv_len == 0) {
+        // This can happen when shutdown is called on the socket,
+        // therefore we check _should_exit again.
+        _is_ok = false;
+        return;
+    }
+
+    if (recv_len < 0) {
+        // This happens on desctruction when close(_socket_fd) is called,
+        // therefore be quiet.
+        // LogErr() << "recvfrom error: " << GET_ERROR(errno);
+        // Something went wrong, we should try to re-connect in next iteration.
+        _is_ok = false;
+        return;
+    }
+
+    _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+
+    // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        receive_message(_mavlink_receiver->get_last_message());
     }
 }
 
@@ -25,17 +25,20 @@ public:
     ConnectionResult start() override;
     ConnectionResult stop() override;
 
-    bool send_message(const mavlink_message_t& message) override;
-
     // Non-copyable
     TcpConnection(const TcpConnection&) = delete;
     const TcpConnection& operator=(const TcpConnection&) = delete;
 
+protected:
+    bool send_bytes(const uint8_t* data, unsigned len) override;
+
 private:
     ConnectionResult setup_port();
     void start_recv_thread();
     int resolve_address(const std::string& ip_address, int port, struct sockaddr_in* addr);
     void receive();
+    void receive_from_io_reactor();
+    void receive_once();
 
     std::string _remote_ip = {};
     int _remote_port_number;
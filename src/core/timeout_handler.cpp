@@ -1,5 +1,7 @@
 #include "timeout_handler.h"
 
+#include <algorithm>
+
 namespace mavsdk {
 
 TimeoutHandler::TimeoutHandler(Time& time) : _time(time) {}
@@ -15,14 +17,20 @@ void TimeoutHandler::add(std::function<void()> callback, double duration_s, void
 
     void* new_cookie = static_cast<void*>(new_timeout.get());
 
+    bool earliest = false;
     {
         std::lock_guard<std::mutex> lock(_timeouts_mutex);
         _timeouts.insert(std::pair<void*, std::shared_ptr<Timeout>>(new_cookie, new_timeout));
+        earliest = schedule(new_cookie, *new_timeout);
     }
 
     if (cookie != nullptr) {
         *cookie = new_cookie;
     }
+
+    if (earliest) {
+        wakeup();
+    }
 }
 
 void TimeoutHandler::refresh(const void* cookie)
@@ -33,6 +41,8 @@ void TimeoutHandler::refresh(const void* cookie)
     if (it != _timeouts.end()) {
         dl_time_t future_time = _time.steady_time_in_future(it->second->duration_s);
         it->second->time = future_time;
+        // This can only move the timeout later, so no need to wake anyone up.
+        schedule(it->first, *it->second);
     }
 }
 
@@ -40,46 +50,95 @@ void TimeoutHandler::remove(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_timeouts_mutex);
 
-    auto it = _timeouts.find(const_cast<void*>(cookie));
-    if (it != _timeouts.end()) {
-        _timeouts.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
-    }
+    _timeouts.erase(const_cast<void*>(cookie));
 }
 
 void TimeoutHandler::run_once()
 {
-    _timeouts_mutex.lock();
+    std::unique_lock<std::mutex> lock(_timeouts_mutex);
 
     dl_time_t now = _time.steady_time();
 
-    for (auto it = _timeouts.begin(); it != _timeouts.end(); /* no ++it */) {
-        // If time is passed, call timeout callback.
-        if (it->second->time < now) {
-            if (it->second->callback) {
-                // Get a copy for the callback because we will remove it.
-                std::function<void()> callback = it->second->callback;
+    while (!_heap.empty() && _heap.front().time < now) {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+        const Scheduled due = _heap.back();
+        _heap.pop_back();
+
+        if (!is_current(due)) {
+            continue;
+        }
 
-                // Self-destruct before calling to avoid locking issues.
-                _timeouts.erase(it++);
+        auto it = _timeouts.find(due.cookie);
+        // Get a copy for the callback because we will remove it.
+        std::function<void()> callback = it->second->callback;
 
-                // Unlock while we callback because it might in turn want to add timeouts.
-                _timeouts_mutex.unlock();
-                callback();
-                _timeouts_mutex.lock();
-            }
+        // Self-destruct before calling to avoid locking issues.
+        _timeouts.erase(it);
 
-        } else {
-            ++it;
+        if (callback) {
+            // Unlock while we callback because it might in turn want to add timeouts.
+            lock.unlock();
+            callback();
+            lock.lock();
         }
+    }
+}
+
+dl_time_t TimeoutHandler::next_deadline()
+{
+    std::lock_guard<std::mutex> lock(_timeouts_mutex);
+
+    drop_stale_entries();
+
+    return _heap.empty() ? dl_time_t::max() : _heap.front().time;
+}
 
-        // We start over if anyone has messed with this while we called the callback.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            it = _timeouts.begin();
+void TimeoutHandler::set_wakeup_callback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    _wakeup_callback = callback;
+}
+
+bool TimeoutHandler::schedule(void* cookie, Timeout& timeout)
+{
+    // Needs to be called with _timeouts_mutex locked.
+    timeout.schedule_id = _next_schedule_id++;
+
+    // Refreshing leaves stale entries behind, so once in a while we rebuild.
+    if (_heap.size() > 2 * _timeouts.size() + 16) {
+        _heap.clear();
+        for (const auto& entry : _timeouts) {
+            _heap.push_back({entry.second->time, entry.first, entry.second->schedule_id});
         }
+        std::make_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+    } else {
+        _heap.push_back({timeout.time, cookie, timeout.schedule_id});
+        std::push_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+    }
+
+    return _heap.front().schedule_id == timeout.schedule_id;
+}
+
+bool TimeoutHandler::is_current(const Scheduled& scheduled) const
+{
+    auto it = _timeouts.find(scheduled.cookie);
+    return it != _timeouts.end() && it->second->schedule_id == scheduled.schedule_id;
+}
+
+void TimeoutHandler::drop_stale_entries()
+{
+    while (!_heap.empty() && !is_current(_heap.front())) {
+        std::pop_heap(_heap.begin(), _heap.end(), std::greater<Scheduled>{});
+        _heap.pop_back();
+    }
+}
+
+void TimeoutHandler::wakeup()
+{
+    std::lock_guard<std::mutex> lock(_wakeup_callback_mutex);
+    if (_wakeup_callback) {
+        _wakeup_callback();
     }
-    _timeouts_mutex.unlock();
 }
 
 } // namespace mavsdk
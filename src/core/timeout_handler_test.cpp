@@ -169,3 +169,36 @@ TEST(TimeoutHandler, NextTimeoutRemovedDuringCallback)
     time.sleep_for(std::chrono::milliseconds(1000));
     th.run_once();
 }
+
+TEST(TimeoutHandler, NextDeadline)
+{
+    Time time{};
+    TimeoutHandler th(time);
+
+    unsigned wakeups = 0;
+    th.set_wakeup_callback([&wakeups]() { ++wakeups; });
+
+    EXPECT_EQ(th.next_deadline(), dl_time_t::max());
+
+    void* cookie1 = nullptr;
+    void* cookie2 = nullptr;
+    th.add([]() {}, 1.0, &cookie1);
+    EXPECT_EQ(wakeups, 1);
+    const auto deadline1 = th.next_deadline();
+    EXPECT_GT(deadline1, time.steady_time());
+
+    // An earlier timeout needs to wake up whoever waits for the next deadline.
+    th.add([]() {}, 0.5, &cookie2);
+    EXPECT_EQ(wakeups, 2);
+    EXPECT_LT(th.next_deadline(), deadline1);
+
+    // Refreshing only ever makes it later.
+    time.sleep_for(std::chrono::milliseconds(600));
+    th.refresh(cookie2);
+    EXPECT_EQ(wakeups, 2);
+    EXPECT_EQ(th.next_deadline(), deadline1);
+
+    th.remove(cookie1);
+    th.remove(cookie2);
+    EXPECT_EQ(th.next_deadline(), dl_time_t::max());
+}
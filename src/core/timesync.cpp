@@ -10,16 +10,24 @@ Timesync::Timesync(SystemImpl& parent) : _parent(parent) {}
 
 Timesync::~Timesync()
 {
+    if (_call_every_cookie != nullptr) {
+        _parent.remove_call_every(_call_every_cookie);
+    }
     _parent.unregister_all_mavlink_message_handlers(this);
 }
 
 void Timesync::enable()
 {
+    if (_is_enabled) {
+        return;
+    }
     _is_enabled = true;
     _parent.register_mavlink_message_handler(
         MAVLINK_MSG_ID_TIMESYNC,
         std::bind(&Timesync::process_timesync, this, std::placeholders::_1),
         this);
+    _parent.add_call_every(
+        [this]() { do_work(); }, _TIMESYNC_SEND_INTERVAL_S, &_call_every_cookie);
 }
 
 void Timesync::do_work()
@@ -28,16 +36,13 @@ void Timesync::do_work()
         return;
     }
 
-    if (_parent.get_time().elapsed_since_s(_last_time) >= _TIMESYNC_SEND_INTERVAL_S) {
-        if (_parent.is_connected()) {
-            uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                  _parent.get_autopilot_time().now().time_since_epoch())
-                                  .count();
-            send_timesync(0, now_ns);
-        } else {
-            _autopilot_timesync_acquired = false;
-        }
-        _last_time = _parent.get_time().steady_time();
+    if (_parent.is_connected()) {
+        uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              _parent.get_autopilot_time().now().time_since_epoch())
+                              .count();
+        send_timesync(0, now_ns);
+    } else {
+        _autopilot_timesync_acquired = false;
     }
 }
 
@@ -80,6 +85,9 @@ void Timesync::set_timesync_offset(int64_t offset_ns, uint64_t start_transfer_lo
     // remote system
     uint64_t rtt_ns = now_ns - start_transfer_local_time_ns;
 
+    // Implausible samples, e.g. if the time was shifted in between, are ignored.
+    _parent.rtt_estimator().add_sample_s(static_cast<double>(rtt_ns) * 1e-9);
+
     if (rtt_ns < _MAX_RTT_SAMPLE_MS * 1000000ULL) { // Only use samples with low RTT
 
         // Save time offset for other components to use
@@ -54,7 +54,9 @@ ConnectionResult UdpConnection::start()
         return ret;
     }
 
-    start_recv_thread();
+    if (!add_to_io_reactor(_socket_fd, [this]() { receive_once(); })) {
+        start_recv_thread();
+    }
 
     return ConnectionResult::Success;
 }
@@ -102,6 +104,9 @@ ConnectionResult UdpConnection::stop()
     // This should interrupt a recv/recvfrom call.
     shutdown(_socket_fd, SHUT_RDWR);
 
+    // The fd needs to be removed before it is closed and possibly reused.
+    remove_from_io_reactor(_socket_fd);
+
     // But on Mac, closing is also needed to stop blocking recv/recvfrom.
     close(_socket_fd);
 #else
@@ -125,7 +130,7 @@ ConnectionResult UdpConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool UdpConnection::send_message(const mavlink_message_t& message)
+bool UdpConnection::send_bytes(const uint8_t* data, unsigned len)
 {
     std::lock_guard<std::mutex> lock(_remote_mutex);
 
@@ -139,54 +144,87 @@ bool UdpConnection::send_message(const mavlink_message_t& message)
     // systems on two different endpoints, then messages directed towards
     // only one system will be sent to both remotes. The systems are
     // then expected to ignore messages that are not directed to them.
+#if defined(LINUX)
+    // All remotes get the same buffer, using one system call.
+    iovec iov{};
+    iov.iov_base = const_cast<uint8_t*>(data);
+    iov.iov_len = len;
+
+    _send_msgs.resize(_remotes.size());
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        _send_msgs[i] = mmsghdr{};
+        _send_msgs[i].msg_hdr.msg_name = &_remotes[i].address;
+        _send_msgs[i].msg_hdr.msg_namelen = sizeof(_remotes[i].address);
+        _send_msgs[i].msg_hdr.msg_iov = &iov;
+        _send_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    bool send_successful = true;
+    unsigned num_sent = 0;
+    while (num_sent < _send_msgs.size()) {
+        const int ret =
+            sendmmsg(_socket_fd, &_send_msgs[num_sent], _send_msgs.size() - num_sent, 0);
+        if (ret < 0) {
+            // Skip the remote which failed and carry on with the others.
+            LogErr() << "sendmmsg failure: " << GET_ERROR(errno);
+            send_successful = false;
+            ++num_sent;
+            continue;
+        }
+        for (int i = 0; i < ret; ++i) {
+            if (_send_msgs[num_sent + i].msg_len != len) {
+                LogErr() << "sendmmsg sent incomplete message";
+                send_successful = false;
+            }
+        }
+        num_sent += ret;
+    }
+#else
     bool send_successful = true;
     for (auto& remote : _remotes) {
-        struct sockaddr_in dest_addr {};
-        dest_addr.sin_family = AF_INET;
-
-        inet_pton(AF_INET, remote.ip.c_str(), &dest_addr.sin_addr.s_addr);
-        dest_addr.sin_port = htons(remote.port_number);
-
-        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-        uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
         const auto send_len = sendto(
             _socket_fd,
-            reinterpret_cast<char*>(buffer),
-            buffer_len,
+            reinterpret_cast<const char*>(data),
+            len,
             0,
-            reinterpret_cast<const sockaddr*>(&dest_addr),
-            sizeof(dest_addr));
+            reinterpret_cast<const sockaddr*>(&remote.address),
+            sizeof(remote.address));
 
-        if (send_len != buffer_len) {
+        if (send_len < 0 || static_cast<unsigned>(send_len) != len) {
             LogErr() << "sendto failure: " << GET_ERROR(errno);
             send_successful = false;
             continue;
         }
     }
+#endif
 
     return send_successful;
 }
 
 void UdpConnection::add_remote(const std::string& remote_ip, const int remote_port)
 {
-    add_remote_with_remote_sysid(remote_ip, remote_port, 0);
+    struct sockaddr_in address {};
+    address.sin_family = AF_INET;
+    inet_pton(AF_INET, remote_ip.c_str(), &address.sin_addr.s_addr);
+    address.sin_port = htons(remote_port);
+
+    add_remote_with_remote_sysid(address, 0);
 }
 
 void UdpConnection::add_remote_with_remote_sysid(
-    const std::string& remote_ip, const int remote_port, const uint8_t remote_sysid)
+    const sockaddr_in& address, const uint8_t remote_sysid)
 {
     std::lock_guard<std::mutex> lock(_remote_mutex);
-    Remote new_remote;
-    new_remote.ip = remote_ip;
-    new_remote.port_number = remote_port;
 
-    auto existing_remote =
-        std::find_if(_remotes.begin(), _remotes.end(), [&new_remote](Remote& remote) {
-            return remote == new_remote;
-        });
+    auto existing_remote = std::find_if(
+        _remotes.begin(), _remotes.end(), [&address](Remote& remote) { return remote == address; });
 
     if (existing_remote == _remotes.end()) {
+        Remote new_remote;
+        new_remote.ip = inet_ntoa(address.sin_addr);
+        new_remote.port_number = ntohs(address.sin_port);
+        new_remote.address = address;
+
         LogInfo() << "New system on: " << new_remote.ip << ":" << new_remote.port_number
                   << " (with sysid: " << (int)remote_sysid << ")";
         _remotes.push_back(new_remote);
@@ -194,50 +232,89 @@ void UdpConnection::add_remote_with_remote_sysid(
 }
 
 void UdpConnection::receive()
+{
+    while (!_should_exit) {
+        receive_once();
+    }
+}
+
+#if defined(LINUX)
+void UdpConnection::receive_once()
+{
+    for (unsigned i = 0; i < RECV_BATCH_SIZE; ++i) {
+        _recv_iovecs[i].iov_base = _recv_buffers[i];
+        _recv_iovecs[i].iov_len = RECV_BUFFER_LEN;
+        _recv_msgs[i].msg_hdr = msghdr{};
+        _recv_msgs[i].msg_hdr.msg_name = &_recv_addrs[i];
+        _recv_msgs[i].msg_hdr.msg_namelen = sizeof(_recv_addrs[i]);
+        _recv_msgs[i].msg_hdr.msg_iov = &_recv_iovecs[i];
+        _recv_msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Wait for the first datagram only, then take whatever else is there already.
+    const int num_received =
+        recvmmsg(_socket_fd, _recv_msgs, RECV_BATCH_SIZE, MSG_WAITFORONE, nullptr);
+
+    if (num_received <= 0) {
+        // This happens on destruction when shutdown or close is called,
+        // therefore be quiet.
+        return;
+    }
+
+    for (int i = 0; i < num_received; ++i) {
+        process_datagram(_recv_buffers[i], _recv_msgs[i].msg_len, _recv_addrs[i]);
+    }
+}
+#else
+void UdpConnection::receive_once()
 {
     // Enough for MTU 1500 bytes.
     char buffer[2048];
 
-    while (!_should_exit) {
-        struct sockaddr_in src_addr = {};
-        socklen_t src_addr_len = sizeof(src_addr);
-        const auto recv_len = recvfrom(
-            _socket_fd,
-            buffer,
-            sizeof(buffer),
-            0,
-            reinterpret_cast<struct sockaddr*>(&src_addr),
-            &src_addr_len);
-
-        if (recv_len == 0) {
-            // This can happen when shutdown is called on the socket,
-            // therefore we check _should_exit again.
-            continue;
-        }
+    struct sockaddr_in src_addr = {};
+    socklen_t src_addr_len = sizeof(src_addr);
+    const auto recv_len = recvfrom(
+        _socket_fd,
+        buffer,
+        sizeof(buffer),
+        0,
+        reinterpret_cast<struct sockaddr*>(&src_addr),
+        &src_addr_len);
+
+    if (recv_len == 0) {
+        // This can happen when shutdown is called on the socket,
+        // therefore we check _should_exit again.
+        return;
+    }
 
-        if (recv_len < 0) {
-            // This happens on destruction when close(_socket_fd) is called,
-            // therefore be quiet.
-            // LogErr() << "recvfrom error: " << GET_ERROR(errno);
-            continue;
-        }
+    if (recv_len < 0) {
+        // This happens on destruction when close(_socket_fd) is called,
+        // therefore be quiet.
+        // LogErr() << "recvfrom error: " << GET_ERROR(errno);
+        return;
+    }
 
-        _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+    process_datagram(buffer, static_cast<unsigned>(recv_len), src_addr);
+}
+#endif
 
-        bool saved_remote = false;
+void UdpConnection::process_datagram(
+    char* datagram, unsigned datagram_len, const sockaddr_in& src_addr)
+{
+    _mavlink_receiver->set_new_datagram(datagram, datagram_len);
 
-        // Parse all mavlink messages in one datagram. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            const uint8_t sysid = _mavlink_receiver->get_last_message().sysid;
+    bool saved_remote = false;
 
-            if (!saved_remote && sysid != 0) {
-                saved_remote = true;
-                add_remote_with_remote_sysid(
-                    inet_ntoa(src_addr.sin_addr), ntohs(src_addr.sin_port), sysid);
-            }
+    // Parse all mavlink messages in one datagram. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        const uint8_t sysid = _mavlink_receiver->get_last_message().sysid;
 
-            receive_message(_mavlink_receiver->get_last_message());
+        if (!saved_remote && sysid != 0) {
+            saved_remote = true;
+            add_remote_with_remote_sysid(src_addr, sysid);
         }
+
+        receive_message(_mavlink_receiver->get_last_message());
     }
 }
 
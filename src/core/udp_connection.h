@@ -7,6 +7,15 @@
 #include <vector>
 #include <cstdint>
 #include "connection.h"
+#include <sys/types.h>
+#ifndef WINDOWS
+#include <netinet/in.h>
+#include <sys/socket.h>
+#else
+#include <winsock2.h>
+#include <Ws2tcpip.h> // For InetPton
+#undef SOCKET_ERROR
+#endif
 
 namespace mavsdk {
 
@@ -20,22 +29,24 @@ public:
     ConnectionResult start() override;
     ConnectionResult stop() override;
 
-    bool send_message(const mavlink_message_t& message) override;
-
     void add_remote(const std::string& remote_ip, const int remote_port);
 
     // Non-copyable
     UdpConnection(const UdpConnection&) = delete;
     const UdpConnection& operator=(const UdpConnection&) = delete;
 
+protected:
+    bool send_bytes(const uint8_t* data, unsigned len) override;
+
 private:
     ConnectionResult setup_port();
     void start_recv_thread();
 
     void receive();
+    void receive_once();
+    void process_datagram(char* datagram, unsigned datagram_len, const sockaddr_in& src_addr);
 
-    void add_remote_with_remote_sysid(
-        const std::string& remote_ip, const int remote_port, const uint8_t remote_sysid);
+    void add_remote_with_remote_sysid(const sockaddr_in& address, const uint8_t remote_sysid);
 
     std::string _local_ip;
     int _local_port_number;
@@ -44,14 +55,30 @@ private:
     struct Remote {
         std::string ip{};
         int port_number{0};
+        // Resolved once so that sending doesn't need to do it every time.
+        sockaddr_in address{};
 
-        bool operator==(const UdpConnection::Remote& other)
+        bool operator==(const sockaddr_in& other) const
         {
-            return ip == other.ip && port_number == other.port_number;
+            return address.sin_addr.s_addr == other.sin_addr.s_addr &&
+                   address.sin_port == other.sin_port;
         }
     };
     std::vector<Remote> _remotes{};
 
+#if defined(LINUX)
+    // Receive and send as many datagrams as possible per system call.
+    static constexpr unsigned RECV_BATCH_SIZE = 16;
+    // Enough for MTU 1500 bytes.
+    static constexpr unsigned RECV_BUFFER_LEN = 2048;
+    char _recv_buffers[RECV_BATCH_SIZE][RECV_BUFFER_LEN]{};
+    sockaddr_in _recv_addrs[RECV_BATCH_SIZE]{};
+    iovec _recv_iovecs[RECV_BATCH_SIZE]{};
+    mmsghdr _recv_msgs[RECV_BATCH_SIZE]{};
+
+    std::vector<mmsghdr> _send_msgs{};
+#endif
+
     int _socket_fd{-1};
     std::thread* _recv_thread{nullptr};
     std::atomic_bool _should_exit{false};
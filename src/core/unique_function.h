@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mavsdk {
+
+template<typename Signature> class UniqueFunction;
+
+// Like std::function, but move-only, so that it can hold move-only callables as well.
+//
+// Callables of up to INLINE_SIZE bytes are kept inline instead of on the heap. Only bigger
+// ones are allocated. It fits a callback with a copy of the largest telemetry update, the
+// odometry, so that updates are passed on to user callbacks without allocating.
+template<typename R, typename... Args> class UniqueFunction<R(Args...)> {
+public:
+    static constexpr std::size_t INLINE_SIZE = 320;
+
+    UniqueFunction() = default;
+    UniqueFunction(std::nullptr_t) {}
+
+    template<
+        typename F,
+        typename = std::enable_if_t<
+            !std::is_same<std::decay_t<F>, UniqueFunction>::value &&
+            !std::is_same<std::decay_t<F>, std::nullptr_t>::value>>
+    UniqueFunction(F&& func)
+    {
+        using Func = std::decay_t<F>;
+        if (is_empty(func)) {
+            return;
+        }
+        if constexpr (fits_inline<Func>()) {
+            new (&_storage) Func(std::forward<F>(func));
+            _ops = &InlineOps<Func>::ops;
+        } else {
+            new (&_storage) Func*(new Func(std::forward<F>(func)));
+            _ops = &HeapOps<Func>::ops;
+        }
+    }
+
+    UniqueFunction(UniqueFunction&& other) noexcept { take(other); }
+
+    UniqueFunction& operator=(UniqueFunction&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    UniqueFunction& operator=(std::nullptr_t)
+    {
+        reset();
+        return *this;
+    }
+
+    ~UniqueFunction() { reset(); }
+
+    // Non-copyable
+    UniqueFunction(const UniqueFunction&) = delete;
+    UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+    R operator()(Args... args) { return _ops->invoke(&_storage, std::forward<Args>(args)...); }
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        // Move constructs into to, and destroys what's left in from.
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Func> struct InlineOps {
+        static R invoke(void* storage, Args&&... args)
+        {
+            return (*static_cast<Func*>(storage))(std::forward<Args>(args)...);
+        }
+        static void move(void* from, void* to)
+        {
+            new (to) Func(std::move(*static_cast<Func*>(from)));
+            static_cast<Func*>(from)->~Func();
+        }
+        static void destroy(void* storage) { static_cast<Func*>(storage)->~Func(); }
+
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    // The storage only holds a pointer to the callable.
+    template<typename Func> struct HeapOps {
+        static R invoke(void* storage, Args&&... args)
+        {
+            return (**static_cast<Func**>(storage))(std::forward<Args>(args)...);
+        }
+        static void move(void* from, void* to) { new (to) Func*(*static_cast<Func**>(from)); }
+        static void destroy(void* storage) { delete *static_cast<Func**>(storage); }
+
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    template<typename Func> static constexpr bool fits_inline()
+    {
+        return sizeof(Func) <= INLINE_SIZE && alignof(Func) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Func>::value;
+    }
+
+    // Empty std::functions and null function pointers give an empty UniqueFunction.
+    template<typename Func> static bool is_empty(const Func&) { return false; }
+    template<typename Signature> static bool is_empty(const std::function<Signature>& func)
+    {
+        return !func;
+    }
+    template<typename Result, typename... Params>
+    static bool is_empty(Result (*func)(Params...))
+    {
+        return func == nullptr;
+    }
+
+    void take(UniqueFunction& other)
+    {
+        if (other._ops != nullptr) {
+            other._ops->move(&other._storage, &_storage);
+            _ops = other._ops;
+            other._ops = nullptr;
+        }
+    }
+
+    void reset()
+    {
+        if (_ops != nullptr) {
+            _ops->destroy(&_storage);
+            _ops = nullptr;
+        }
+    }
+
+    std::aligned_storage_t<INLINE_SIZE, alignof(std::max_align_t)> _storage;
+    const Ops* _ops{nullptr};
+};
+
+} // namespace mavsdk
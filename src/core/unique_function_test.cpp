@@ -0,0 +1,76 @@
+#include "unique_function.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(UniqueFunction, CallsWhatItHolds)
+{
+    UniqueFunction<int(int, int)> add = [](int a, int b) { return a + b; };
+    ASSERT_TRUE(add);
+    EXPECT_EQ(add(2, 3), 5);
+
+    UniqueFunction<int(int, int)> empty;
+    EXPECT_FALSE(empty);
+}
+
+TEST(UniqueFunction, HoldsMoveOnlyCallables)
+{
+    auto value = std::make_unique<int>(42);
+    UniqueFunction<int()> func = [value = std::move(value)]() { return *value; };
+    EXPECT_EQ(func(), 42);
+
+    UniqueFunction<int()> moved = std::move(func);
+    EXPECT_FALSE(func);
+    EXPECT_EQ(moved(), 42);
+}
+
+TEST(UniqueFunction, HoldsCallablesTooBigToBeInline)
+{
+    std::array<int, UniqueFunction<int()>::INLINE_SIZE / sizeof(int) + 1> values{};
+    values.back() = 7;
+
+    UniqueFunction<int()> func = [values]() { return values.back(); };
+    UniqueFunction<int()> moved;
+    moved = std::move(func);
+    EXPECT_FALSE(func);
+    EXPECT_EQ(moved(), 7);
+}
+
+TEST(UniqueFunction, DestroysWhatItHoldsOnce)
+{
+    auto small = std::make_shared<int>(1);
+    auto big = std::make_shared<int>(2);
+
+    {
+        UniqueFunction<void()> inline_func = [small]() {};
+        std::array<char, UniqueFunction<void()>::INLINE_SIZE> padding{};
+        UniqueFunction<void()> heap_func = [big, padding]() {};
+        EXPECT_EQ(small.use_count(), 2);
+        EXPECT_EQ(big.use_count(), 2);
+
+        UniqueFunction<void()> moved_inline = std::move(inline_func);
+        UniqueFunction<void()> moved_heap = std::move(heap_func);
+        EXPECT_EQ(small.use_count(), 2);
+        EXPECT_EQ(big.use_count(), 2);
+
+        moved_inline = nullptr;
+        EXPECT_EQ(small.use_count(), 1);
+    }
+
+    EXPECT_EQ(big.use_count(), 1);
+}
+
+TEST(UniqueFunction, StaysEmptyForEmptyStdFunction)
+{
+    std::function<void()> empty_function;
+    UniqueFunction<void()> func = empty_function;
+    EXPECT_FALSE(func);
+
+    void (*null_pointer)() = nullptr;
+    UniqueFunction<void()> from_pointer = null_pointer;
+    EXPECT_FALSE(from_pointer);
+}
@@ -0,0 +1,270 @@
+#include "user_callback_queue.h"
+
+namespace mavsdk {
+
+namespace {
+
+size_t round_up_to_power_of_two(size_t value)
+{
+    size_t result = 2;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+} // namespace
+
+UserCallbackQueue::UserCallbackQueue(size_t capacity) :
+    _cells(new Cell[round_up_to_power_of_two(capacity)]),
+    _mask(round_up_to_power_of_two(capacity) - 1)
+{
+    for (size_t i = 0; i <= _mask; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+UserCallbackQueue::~UserCallbackQueue()
+{
+    Item item;
+    while (try_pop(item)) {
+        discard(item);
+    }
+}
+
+bool UserCallbackQueue::push(UserCallback callback, OverflowPolicy policy)
+{
+    Item item;
+    item.callback = std::move(callback);
+    return push_item(item, policy);
+}
+
+bool UserCallbackQueue::push(
+    UserCallback callback, const std::shared_ptr<Subscription>& subscription)
+{
+    if (!subscription) {
+        return push(std::move(callback));
+    }
+
+    Item item;
+    item.subscription = subscription;
+
+    if (subscription->policy != OverflowPolicy::CoalesceLatest) {
+        item.callback = std::move(callback);
+        return push_item(item, subscription->policy);
+    }
+
+    // If there is already one waiting, we just replace it, and the consumer
+    // will pick up the latest one.
+    UserCallback previous;
+    {
+        std::lock_guard<std::mutex> lock(subscription->_latest_mutex);
+        previous = std::move(subscription->_latest);
+        subscription->_latest = std::move(callback);
+        if (subscription->_has_latest) {
+            ++_coalesced;
+            ++subscription->_coalesced;
+            return true;
+        }
+        subscription->_has_latest = true;
+    }
+
+    return push_item(item, OverflowPolicy::DropNewest);
+}
+
+bool UserCallbackQueue::push_item(Item& item, OverflowPolicy policy)
+{
+    if (try_push(item)) {
+        wake_consumer();
+        return true;
+    }
+
+    if (policy == OverflowPolicy::DropOldest && push_dropping_oldest(item)) {
+        wake_consumer();
+        return true;
+    }
+
+    discard(item);
+    ++_dropped_newest;
+    return false;
+}
+
+bool UserCallbackQueue::push_dropping_oldest(Item& item)
+{
+    // Other producers can take the space we made, so we try a few times.
+    for (unsigned attempt = 0; attempt < 4; ++attempt) {
+        Item oldest;
+        if (try_pop(oldest)) {
+            discard(oldest);
+            ++_dropped_oldest;
+        }
+        if (try_push(item)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UserCallbackQueue::discard(Item& item)
+{
+    if (item.subscription) {
+        if (item.subscription->policy == OverflowPolicy::CoalesceLatest) {
+            UserCallback dropped;
+            take_latest(*item.subscription, dropped);
+        }
+        item.subscription.reset();
+    }
+    item.callback = UserCallback{};
+}
+
+bool UserCallbackQueue::pop(UserCallback& callback)
+{
+    std::shared_ptr<Subscription> subscription;
+    return pop(callback, subscription);
+}
+
+bool UserCallbackQueue::pop(UserCallback& callback, std::shared_ptr<Subscription>& subscription)
+{
+    Item item;
+
+    while (!_should_exit) {
+        if (try_pop(item)) {
+            subscription = std::move(item.subscription);
+
+            if (!subscription || subscription->policy != OverflowPolicy::CoalesceLatest) {
+                callback = std::move(item.callback);
+                return true;
+            }
+
+            if (!take_latest(*subscription, callback)) {
+                // It was dropped in the meantime.
+                continue;
+            }
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(_wait_mutex);
+        _consumer_waiting.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in wake_consumer(): either the producer sees that
+        // we're waiting, or we see what it has pushed.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _wait_cv.wait(lock, [this]() { return !is_empty() || _should_exit; });
+        _consumer_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    return false;
+}
+
+bool UserCallbackQueue::take_latest(Subscription& subscription, UserCallback& callback)
+{
+    std::lock_guard<std::mutex> lock(subscription._latest_mutex);
+    if (!subscription._has_latest) {
+        return false;
+    }
+    callback = std::move(subscription._latest);
+    subscription._has_latest = false;
+    return true;
+}
+
+void UserCallbackQueue::stop()
+{
+    _should_exit = true;
+
+    std::lock_guard<std::mutex> lock(_wait_mutex);
+    _wait_cv.notify_all();
+}
+
+void UserCallbackQueue::wake_consumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consumer_waiting.load(std::memory_order_relaxed)) {
+        // Taking the lock makes sure the consumer is either waiting already or
+        // has not checked for new items yet.
+        { std::lock_guard<std::mutex> lock(_wait_mutex); }
+        _wait_cv.notify_one();
+    }
+}
+
+size_t UserCallbackQueue::size() const
+{
+    const size_t dequeue_pos = _dequeue_pos.load(std::memory_order_relaxed);
+    const size_t enqueue_pos = _enqueue_pos.load(std::memory_order_relaxed);
+    return (enqueue_pos > dequeue_pos) ? enqueue_pos - dequeue_pos : 0;
+}
+
+UserCallbackQueue::Stats UserCallbackQueue::stats() const
+{
+    Stats stats;
+    stats.dropped_newest = _dropped_newest;
+    stats.dropped_oldest = _dropped_oldest;
+    stats.coalesced = _coalesced;
+    return stats;
+}
+
+// The ring buffer is based on Dmitry Vyukov's bounded MPMC queue: every cell
+// has a sequence number telling whether it is free to be written or read for
+// the current lap around the ring.
+bool UserCallbackQueue::try_push(Item& item)
+{
+    Cell* cell;
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &_cells[pos & _mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+        if (diff == 0) {
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full.
+            return false;
+        } else {
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->item = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool UserCallbackQueue::try_pop(Item& item)
+{
+    Cell* cell;
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &_cells[pos & _mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff =
+            static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if (diff == 0) {
+            if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Empty.
+            return false;
+        } else {
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    item = std::move(cell->item);
+    cell->item = Item{};
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+bool UserCallbackQueue::is_empty() const
+{
+    const size_t pos = _dequeue_pos.load(std::memory_order_acquire);
+    const Cell& cell = _cells[pos & _mask];
+    return cell.sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+} // namespace mavsdk
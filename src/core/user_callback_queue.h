@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "unique_function.h"
+
+namespace mavsdk {
+
+struct CallbackStrand;
+
+// Bounded queue of callbacks into user code, which are taken out by one
+// consumer thread, see CallbackExecutor.
+//
+// Pushing is lock-free, so that threads receiving messages don't contend on
+// a mutex with each other or with the consumer. Only an idle consumer is
+// woken up using a condition variable, and callbacks which coalesce take the
+// lock of their own subscription.
+//
+// What happens if the consumer (i.e. the user code) is too slow and the queue
+// runs full depends on the policy of the subscription the callback is for.
+class UserCallbackQueue {
+public:
+    enum class OverflowPolicy {
+        DropNewest, // The callback to be pushed is dropped.
+        DropOldest, // The oldest queued callback is dropped to make space.
+        CoalesceLatest, // Only the latest callback of the subscription is
+                        // queued, so it can't fill up the queue.
+    };
+
+    // Move-only, so callbacks can own what they capture, and small captures don't need
+    // to be allocated.
+    using Func = UniqueFunction<void()>;
+
+    struct UserCallback {
+        UserCallback() {}
+        explicit UserCallback(Func func_) : func(std::move(func_)) {}
+        UserCallback(Func func_, const char* filename_, const int linenumber_) :
+            func(std::move(func_)),
+            filename(filename_),
+            linenumber(linenumber_)
+        {}
+
+        Func func{};
+        // A string literal (__FILENAME__), so it doesn't need to be copied.
+        const char* filename{nullptr};
+        int linenumber{};
+    };
+
+    // Owned by whoever subscribes, e.g. one per telemetry subscription.
+    // Callbacks of the same subscription are called in order.
+    class Subscription {
+    public:
+        explicit Subscription(OverflowPolicy policy_) : policy(policy_) {}
+        ~Subscription() = default;
+
+        // Non-copyable
+        Subscription(const Subscription&) = delete;
+        const Subscription& operator=(const Subscription&) = delete;
+
+        const OverflowPolicy policy;
+
+        // Number of callbacks replaced by a later one before they were called.
+        uint64_t coalesced() const { return _coalesced; }
+
+    private:
+        friend class UserCallbackQueue;
+        friend class CallbackExecutor;
+        // The callback waiting to be called, if the policy is CoalesceLatest. It's kept
+        // here rather than allocated for every update.
+        std::mutex _latest_mutex{};
+        UserCallback _latest{};
+        bool _has_latest{false};
+        std::atomic<uint64_t> _coalesced{0};
+        // The strand of the CallbackExecutor while it has callbacks of this subscription,
+        // guarded by the mutex of the executor.
+        CallbackStrand* _strand{nullptr};
+    };
+
+    struct Stats {
+        uint64_t dropped_newest{0};
+        uint64_t dropped_oldest{0};
+        uint64_t coalesced{0};
+    };
+
+    // The capacity is rounded up to a power of two.
+    explicit UserCallbackQueue(size_t capacity);
+    ~UserCallbackQueue();
+
+    static std::shared_ptr<Subscription> make_subscription(OverflowPolicy policy)
+    {
+        return std::make_shared<Subscription>(policy);
+    }
+
+    // Returns false if the callback was dropped.
+    bool push(UserCallback callback, OverflowPolicy policy = OverflowPolicy::DropNewest);
+    bool push(UserCallback callback, const std::shared_ptr<Subscription>& subscription);
+
+    // Blocks until there is a callback or stop() is called, in which case it returns false.
+    // Only one thread must pop.
+    bool pop(UserCallback& callback);
+    // Also returns the subscription the callback was pushed with, if any.
+    bool pop(UserCallback& callback, std::shared_ptr<Subscription>& subscription);
+    void stop();
+
+    // Approximate number of callbacks queued.
+    size_t size() const;
+    size_t capacity() const { return _mask + 1; }
+
+    Stats stats() const;
+
+    // Non-copyable
+    UserCallbackQueue(const UserCallbackQueue&) = delete;
+    const UserCallbackQueue& operator=(const UserCallbackQueue&) = delete;
+
+private:
+    struct Item {
+        // Not set for subscriptions which coalesce, the callback is in the
+        // subscription instead.
+        UserCallback callback{};
+        std::shared_ptr<Subscription> subscription{};
+    };
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        Item item{};
+    };
+
+    bool try_push(Item& item);
+    bool try_pop(Item& item);
+    bool push_dropping_oldest(Item& item);
+    bool push_item(Item& item, OverflowPolicy policy);
+    void discard(Item& item);
+    static bool take_latest(Subscription& subscription, UserCallback& callback);
+    void wake_consumer();
+    bool is_empty() const;
+
+    std::unique_ptr<Cell[]> _cells;
+    const size_t _mask;
+
+    // On separate cache lines, so that producers and consumer don't slow each other down.
+    alignas(64) std::atomic<size_t> _enqueue_pos{0};
+    alignas(64) std::atomic<size_t> _dequeue_pos{0};
+
+    alignas(64) std::atomic<bool> _consumer_waiting{false};
+    std::mutex _wait_mutex{};
+    std::condition_variable _wait_cv{};
+    std::atomic<bool> _should_exit{false};
+
+    std::atomic<uint64_t> _dropped_newest{0};
+    std::atomic<uint64_t> _dropped_oldest{0};
+    std::atomic<uint64_t> _coalesced{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,150 @@
+#include "user_callback_queue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+namespace {
+
+using Policy = UserCallbackQueue::OverflowPolicy;
+
+UserCallbackQueue::UserCallback recording(std::vector<int>& calls, int value)
+{
+    return UserCallbackQueue::UserCallback{[&calls, value]() { calls.push_back(value); }};
+}
+
+void run_all(UserCallbackQueue& queue)
+{
+    while (queue.size() > 0) {
+        UserCallbackQueue::UserCallback callback;
+        ASSERT_TRUE(queue.pop(callback));
+        callback.func();
+    }
+}
+
+} // namespace
+
+TEST(UserCallbackQueue, CallsInOrder)
+{
+    UserCallbackQueue queue(8);
+    std::vector<int> calls;
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.push(recording(calls, i)));
+    }
+    run_all(queue);
+
+    EXPECT_EQ(calls, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(UserCallbackQueue, DropNewest)
+{
+    UserCallbackQueue queue(4);
+    std::vector<int> calls;
+
+    for (int i = 0; i < 6; ++i) {
+        queue.push(recording(calls, i), Policy::DropNewest);
+    }
+    run_all(queue);
+
+    EXPECT_EQ(calls, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(queue.stats().dropped_newest, 2);
+    EXPECT_EQ(queue.stats().dropped_oldest, 0);
+}
+
+TEST(UserCallbackQueue, DropOldest)
+{
+    UserCallbackQueue queue(4);
+    std::vector<int> calls;
+
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(queue.push(recording(calls, i), Policy::DropOldest));
+    }
+    run_all(queue);
+
+    EXPECT_EQ(calls, (std::vector<int>{2, 3, 4, 5}));
+    EXPECT_EQ(queue.stats().dropped_oldest, 2);
+    EXPECT_EQ(queue.stats().dropped_newest, 0);
+}
+
+TEST(UserCallbackQueue, CoalesceLatest)
+{
+    UserCallbackQueue queue(4);
+    std::vector<int> calls;
+
+    auto position = UserCallbackQueue::make_subscription(Policy::CoalesceLatest);
+    auto other = UserCallbackQueue::make_subscription(Policy::DropNewest);
+
+    queue.push(recording(calls, 1), position);
+    queue.push(recording(calls, 100), other);
+    queue.push(recording(calls, 2), position);
+    queue.push(recording(calls, 3), position);
+    run_all(queue);
+
+    // The position is only called once, with the latest value, but where the first one was queued.
+    EXPECT_EQ(calls, (std::vector<int>{3, 100}));
+    EXPECT_EQ(queue.stats().coalesced, 2);
+    EXPECT_EQ(position->coalesced(), 2);
+    EXPECT_EQ(other->coalesced(), 0);
+
+    // Once called, the next one is queued again.
+    calls.clear();
+    queue.push(recording(calls, 4), position);
+    run_all(queue);
+    EXPECT_EQ(calls, (std::vector<int>{4}));
+}
+
+TEST(UserCallbackQueue, StopUnblocksPop)
+{
+    UserCallbackQueue queue(4);
+
+    std::thread consumer([&queue]() {
+        UserCallbackQueue::UserCallback callback;
+        EXPECT_FALSE(queue.pop(callback));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.stop();
+    consumer.join();
+}
+
+TEST(UserCallbackQueue, MultipleProducers)
+{
+    constexpr unsigned num_producers = 4;
+    constexpr unsigned num_per_producer = 100000;
+
+    UserCallbackQueue queue(64);
+    std::atomic<unsigned> called{0};
+
+    std::thread consumer([&]() {
+        UserCallbackQueue::UserCallback callback;
+        while (queue.pop(callback)) {
+            callback.func();
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&]() {
+            for (unsigned i = 0; i < num_per_producer; ++i) {
+                queue.push(UserCallbackQueue::UserCallback{[&called]() { ++called; }});
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // Everything is either called or counted as dropped.
+    while (called + queue.stats().dropped_newest < num_producers * num_per_producer) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.stop();
+    consumer.join();
+
+    EXPECT_EQ(called + queue.stats().dropped_newest, num_producers * num_per_producer);
+    EXPECT_GT(called, 0);
+}
@@ -1,6 +1,8 @@
+#include <atomic>
 #include <iostream>
 #include "integration_test_helper.h"
 #include "mavsdk.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
 #include "plugins/param/param.h"
 
 using namespace mavsdk;
@@ -123,3 +125,43 @@ TEST_F(SitlTest, ParamHappy)
         EXPECT_FLOAT_EQ(get_result3.second, get_result1.second);
     }
 }
+
+TEST_F(SitlTest, ParamGetAllFirstRepliesLost)
+{
+    Mavsdk mavsdk;
+
+    ConnectionResult ret = mavsdk.add_udp_connection();
+    ASSERT_EQ(ret, ConnectionResult::Success);
+
+    // Wait for system to connect via heartbeat.
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+
+    auto system = mavsdk.systems().at(0);
+    ASSERT_TRUE(system->has_autopilot());
+
+    auto mavlink_passthrough = std::make_shared<MavlinkPassthrough>(system);
+    auto param = std::make_shared<Param>(system);
+
+    // Everything the autopilot sends in reply to the first list request gets lost, so the
+    // download only succeeds if the list is requested again.
+    std::atomic<unsigned> list_requests{0};
+    mavlink_passthrough->intercept_outgoing_messages_async(
+        [&list_requests](mavlink_message_t& message) {
+            if (message.msgid == MAVLINK_MSG_ID_PARAM_REQUEST_LIST) {
+                ++list_requests;
+            }
+            return true;
+        });
+    mavlink_passthrough->intercept_incoming_messages_async(
+        [&list_requests](mavlink_message_t& message) {
+            return message.msgid != MAVLINK_MSG_ID_PARAM_VALUE || list_requests > 1;
+        });
+
+    auto value = param->get_all_params();
+    EXPECT_GT(list_requests, 1);
+    EXPECT_GT(value.float_params.size(), 0);
+    EXPECT_GT(value.int_params.size(), 0);
+
+    mavlink_passthrough->intercept_outgoing_messages_async(nullptr);
+    mavlink_passthrough->intercept_incoming_messages_async(nullptr);
+}
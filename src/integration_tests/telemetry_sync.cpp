@@ -2,6 +2,7 @@
 #include "integration_test_helper.h"
 #include "mavsdk.h"
 #include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry/telemetry_extension.h"
 
 using namespace mavsdk;
 
@@ -49,3 +50,50 @@ TEST_F(SitlTest, TelemetrySync)
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 }
+
+// Only checks that setting the rates at once works. How long it takes either way is logged
+// for comparison, but not asserted, as it depends on the link and the autopilot.
+TEST_F(SitlTest, TelemetrySetRatesAtOnce)
+{
+    Mavsdk mavsdk;
+
+    ConnectionResult ret = mavsdk.add_udp_connection();
+    ASSERT_EQ(ret, ConnectionResult::Success);
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    auto system = mavsdk.systems().at(0);
+    ASSERT_TRUE(system->is_connected());
+
+    auto telemetry = std::make_shared<Telemetry>(system);
+
+    // First one after the other, to compare how long it takes.
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(telemetry->set_rate_position(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_home(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_in_air(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_attitude(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_velocity_ned(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_gps_info(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_battery(10.0), Telemetry::Result::Success);
+    EXPECT_EQ(telemetry->set_rate_fixedwing_metrics(10.0), Telemetry::Result::Success);
+    const auto one_by_one = std::chrono::steady_clock::now() - start;
+
+    TelemetryExtension::Rates rates{};
+    rates.position_hz = 5.0;
+    rates.home_hz = 5.0;
+    rates.landed_state_hz = 5.0;
+    rates.attitude_hz = 5.0;
+    rates.velocity_ned_hz = 5.0;
+    rates.gps_info_hz = 5.0;
+    rates.battery_hz = 5.0;
+    rates.fixedwing_metrics_hz = 5.0;
+
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(TelemetryExtension(*telemetry).set_rates(rates), Telemetry::Result::Success);
+    const auto at_once = std::chrono::steady_clock::now() - start;
+
+    LogInfo() << "Setting 8 rates one by one took "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(one_by_one).count()
+              << " ms, at once "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(at_once).count() << " ms";
+}
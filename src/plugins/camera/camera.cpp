@@ -102,6 +102,16 @@ void Camera::subscribe_mode(ModeCallback callback)
     _impl->mode_async(callback);
 }
 
+Camera::ModeHandle Camera::subscribe_mode(ModeCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_mode(callback, queue_policy);
+}
+
+void Camera::unsubscribe_mode(ModeHandle handle)
+{
+    _impl->unsubscribe_mode(handle);
+}
+
 Camera::Mode Camera::mode() const
 {
     return _impl->mode();
@@ -112,6 +122,17 @@ void Camera::subscribe_information(InformationCallback callback)
     _impl->information_async(callback);
 }
 
+Camera::InformationHandle Camera::subscribe_information(
+    InformationCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_information(callback, queue_policy);
+}
+
+void Camera::unsubscribe_information(InformationHandle handle)
+{
+    _impl->unsubscribe_information(handle);
+}
+
 Camera::Information Camera::information() const
 {
     return _impl->information();
@@ -122,6 +143,17 @@ void Camera::subscribe_video_stream_info(VideoStreamInfoCallback callback)
     _impl->video_stream_info_async(callback);
 }
 
+Camera::VideoStreamInfoHandle Camera::subscribe_video_stream_info(
+    VideoStreamInfoCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_video_stream_info(callback, queue_policy);
+}
+
+void Camera::unsubscribe_video_stream_info(VideoStreamInfoHandle handle)
+{
+    _impl->unsubscribe_video_stream_info(handle);
+}
+
 Camera::VideoStreamInfo Camera::video_stream_info() const
 {
     return _impl->video_stream_info();
@@ -132,11 +164,32 @@ void Camera::subscribe_capture_info(CaptureInfoCallback callback)
     _impl->capture_info_async(callback);
 }
 
+Camera::CaptureInfoHandle Camera::subscribe_capture_info(
+    CaptureInfoCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_capture_info(callback, queue_policy);
+}
+
+void Camera::unsubscribe_capture_info(CaptureInfoHandle handle)
+{
+    _impl->unsubscribe_capture_info(handle);
+}
+
 void Camera::subscribe_status(StatusCallback callback)
 {
     _impl->status_async(callback);
 }
 
+Camera::StatusHandle Camera::subscribe_status(StatusCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_status(callback, queue_policy);
+}
+
+void Camera::unsubscribe_status(StatusHandle handle)
+{
+    _impl->unsubscribe_status(handle);
+}
+
 Camera::Status Camera::status() const
 {
     return _impl->status();
@@ -147,11 +200,33 @@ void Camera::subscribe_current_settings(CurrentSettingsCallback callback)
     _impl->current_settings_async(callback);
 }
 
+Camera::CurrentSettingsHandle Camera::subscribe_current_settings(
+    CurrentSettingsCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_current_settings(callback, queue_policy);
+}
+
+void Camera::unsubscribe_current_settings(CurrentSettingsHandle handle)
+{
+    _impl->unsubscribe_current_settings(handle);
+}
+
 void Camera::subscribe_possible_setting_options(PossibleSettingOptionsCallback callback)
 {
     _impl->possible_setting_options_async(callback);
 }
 
+Camera::PossibleSettingOptionsHandle Camera::subscribe_possible_setting_options(
+    PossibleSettingOptionsCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_possible_setting_options(callback, queue_policy);
+}
+
+void Camera::unsubscribe_possible_setting_options(PossibleSettingOptionsHandle handle)
+{
+    _impl->unsubscribe_possible_setting_options(handle);
+}
+
 std::vector<Camera::SettingOptions> Camera::possible_setting_options() const
 {
     return _impl->possible_setting_options();
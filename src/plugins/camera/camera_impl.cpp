@@ -77,40 +77,13 @@ void CameraImpl::deinit()
     _parent->unregister_all_mavlink_message_handlers(this);
     _parent->cancel_all_param(this);
 
-    {
-        std::lock_guard<std::mutex> lock(_status.mutex);
-        _status.subscription_callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_mode.mutex);
-        _mode.subscription_callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_capture_info.mutex);
-        _capture_info.callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_video_stream_info.mutex);
-        _video_stream_info.subscription_callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_information.mutex);
-        _information.subscription_callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_subscribe_current_settings.mutex);
-        _subscribe_current_settings.callback = nullptr;
-    }
-
-    {
-        std::lock_guard<std::mutex> lock(_subscribe_possible_setting_options.mutex);
-        _subscribe_possible_setting_options.callback = nullptr;
-    }
+    _status.subscriptions.clear();
+    _mode.subscriptions.clear();
+    _capture_info.subscriptions.clear();
+    _video_stream_info.subscriptions.clear();
+    _information.subscriptions.clear();
+    _subscribe_current_settings.subscriptions.clear();
+    _subscribe_possible_setting_options.subscriptions.clear();
 
     _camera_found = false;
 }
@@ -459,14 +432,22 @@ Camera::Information CameraImpl::information() const
 
 void CameraImpl::information_async(const Camera::InformationCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_information.mutex);
-    _information.subscription_callback = callback;
+    _information.subscriptions.set(callback);
+    update_status_requests();
+}
 
-    if (callback) {
-        _parent->add_call_every([this]() { request_status(); }, 1.0, &_status.call_every_cookie);
-    } else {
-        _parent->remove_call_every(_status.call_every_cookie);
-    }
+Camera::InformationHandle CameraImpl::subscribe_information(
+    const Camera::InformationCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle = _information.subscriptions.subscribe(callback, queue_policy);
+    update_status_requests();
+    return handle;
+}
+
+void CameraImpl::unsubscribe_information(Camera::InformationHandle handle)
+{
+    _information.subscriptions.unsubscribe(handle);
+    update_status_requests();
 }
 
 Camera::Result CameraImpl::start_video_streaming()
@@ -520,16 +501,31 @@ Camera::VideoStreamInfo CameraImpl::video_stream_info()
 
 void CameraImpl::video_stream_info_async(const Camera::VideoStreamInfoCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_video_stream_info.mutex);
+    _video_stream_info.subscriptions.set(callback);
+    update_video_stream_info_requests();
+}
+
+Camera::VideoStreamInfoHandle CameraImpl::subscribe_video_stream_info(
+    const Camera::VideoStreamInfoCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle = _video_stream_info.subscriptions.subscribe(callback, queue_policy);
+    update_video_stream_info_requests();
+    return handle;
+}
 
-    _video_stream_info.subscription_callback = callback;
+void CameraImpl::unsubscribe_video_stream_info(Camera::VideoStreamInfoHandle handle)
+{
+    _video_stream_info.subscriptions.unsubscribe(handle);
+    update_video_stream_info_requests();
+}
 
-    if (callback) {
-        _parent->add_call_every(
-            [this]() { request_video_stream_info(); }, 1.0, &_video_stream_info.call_every_cookie);
-    } else {
-        _parent->remove_call_every(_video_stream_info.call_every_cookie);
-    }
+void CameraImpl::update_video_stream_info_requests()
+{
+    std::lock_guard<std::mutex> lock(_video_stream_info.mutex);
+    update_requests(
+        !_video_stream_info.subscriptions.empty(),
+        [this]() { request_video_stream_info(); },
+        &_video_stream_info.call_every_cookie);
 }
 
 Camera::Result
@@ -656,18 +652,43 @@ Camera::Mode CameraImpl::mode()
 
 void CameraImpl::mode_async(const Camera::ModeCallback callback)
 {
-    {
-        std::lock_guard<std::mutex> lock(_mode.mutex);
-        _mode.subscription_callback = callback;
-    }
+    _mode.subscriptions.set(callback);
+    notify_mode();
+    update_mode_requests();
+}
 
+Camera::ModeHandle CameraImpl::subscribe_mode(
+    const Camera::ModeCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle = _mode.subscriptions.subscribe(callback, queue_policy);
     notify_mode();
+    update_mode_requests();
+    return handle;
+}
 
-    if (callback) {
-        _parent->add_call_every(
-            [this]() { request_camera_settings(); }, 1.0, &_mode.call_every_cookie);
-    } else {
-        _parent->remove_call_every(_mode.call_every_cookie);
+void CameraImpl::unsubscribe_mode(Camera::ModeHandle handle)
+{
+    _mode.subscriptions.unsubscribe(handle);
+    update_mode_requests();
+}
+
+void CameraImpl::update_mode_requests()
+{
+    std::lock_guard<std::mutex> lock(_mode.mutex);
+    update_requests(
+        !_mode.subscriptions.empty(),
+        [this]() { request_camera_settings(); },
+        &_mode.call_every_cookie);
+}
+
+void CameraImpl::update_requests(
+    bool subscribed, const std::function<void()>& request, void** call_every_cookie)
+{
+    if (!subscribed) {
+        _parent->remove_call_every(*call_every_cookie);
+        *call_every_cookie = nullptr;
+    } else if (*call_every_cookie == nullptr) {
+        _parent->add_call_every(request, 1.0, call_every_cookie);
     }
 }
 
@@ -690,15 +711,32 @@ void CameraImpl::request_status()
 
 void CameraImpl::status_async(const Camera::StatusCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_status.mutex);
+    _status.subscriptions.set(callback);
+    update_status_requests();
+}
 
-    _status.subscription_callback = callback;
+Camera::StatusHandle CameraImpl::subscribe_status(
+    const Camera::StatusCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle = _status.subscriptions.subscribe(callback, queue_policy);
+    update_status_requests();
+    return handle;
+}
 
-    if (callback) {
-        _parent->add_call_every([this]() { request_status(); }, 1.0, &_status.call_every_cookie);
-    } else {
-        _parent->remove_call_every(_status.call_every_cookie);
-    }
+void CameraImpl::unsubscribe_status(Camera::StatusHandle handle)
+{
+    _status.subscriptions.unsubscribe(handle);
+    update_status_requests();
+}
+
+void CameraImpl::update_status_requests()
+{
+    // The status is also requested for the information subscribers.
+    std::lock_guard<std::mutex> lock(_status.mutex);
+    update_requests(
+        !_status.subscriptions.empty() || !_information.subscriptions.empty(),
+        [this]() { request_status(); },
+        &_status.call_every_cookie);
 }
 
 Camera::Status CameraImpl::status()
@@ -709,8 +747,18 @@ Camera::Status CameraImpl::status()
 
 void CameraImpl::capture_info_async(Camera::CaptureInfoCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_capture_info.mutex);
-    _capture_info.callback = callback;
+    _capture_info.subscriptions.set(callback);
+}
+
+Camera::CaptureInfoHandle CameraImpl::subscribe_capture_info(
+    const Camera::CaptureInfoCallback& callback, QueuePolicy queue_policy)
+{
+    return _capture_info.subscriptions.subscribe(callback, queue_policy);
+}
+
+void CameraImpl::unsubscribe_capture_info(Camera::CaptureInfoHandle handle)
+{
+    _capture_info.subscriptions.unsubscribe(handle);
 }
 
 void CameraImpl::process_camera_capture_status(const mavlink_message_t& message)
@@ -759,30 +807,24 @@ void CameraImpl::process_camera_image_captured(const mavlink_message_t& message)
     mavlink_camera_image_captured_t image_captured;
     mavlink_msg_camera_image_captured_decode(&message, &image_captured);
 
-    {
-        std::lock_guard<std::mutex> lock(_capture_info.mutex);
-
-        if (_capture_info.callback) {
-            Camera::CaptureInfo capture_info = {};
-            capture_info.position.latitude_deg = image_captured.lat / 1e7;
-            capture_info.position.longitude_deg = image_captured.lon / 1e7;
-            capture_info.position.absolute_altitude_m = image_captured.alt / 1e3f;
-            capture_info.position.relative_altitude_m = image_captured.relative_alt / 1e3f;
-            capture_info.time_utc_us = image_captured.time_utc;
-            capture_info.attitude_quaternion.w = image_captured.q[0];
-            capture_info.attitude_quaternion.x = image_captured.q[1];
-            capture_info.attitude_quaternion.y = image_captured.q[2];
-            capture_info.attitude_quaternion.z = image_captured.q[3];
-            capture_info.attitude_euler_angle =
-                to_euler_angle_from_quaternion(capture_info.attitude_quaternion);
-            capture_info.file_url = std::string(image_captured.file_url);
-            capture_info.is_success = (image_captured.capture_result == 1);
-            capture_info.index = image_captured.image_index;
-
-            const auto temp_callback = _capture_info.callback;
-            _parent->call_user_callback(
-                [temp_callback, capture_info]() { temp_callback(capture_info); });
-        }
+    if (!_capture_info.subscriptions.empty()) {
+        Camera::CaptureInfo capture_info = {};
+        capture_info.position.latitude_deg = image_captured.lat / 1e7;
+        capture_info.position.longitude_deg = image_captured.lon / 1e7;
+        capture_info.position.absolute_altitude_m = image_captured.alt / 1e3f;
+        capture_info.position.relative_altitude_m = image_captured.relative_alt / 1e3f;
+        capture_info.time_utc_us = image_captured.time_utc;
+        capture_info.attitude_quaternion.w = image_captured.q[0];
+        capture_info.attitude_quaternion.x = image_captured.q[1];
+        capture_info.attitude_quaternion.y = image_captured.q[2];
+        capture_info.attitude_quaternion.z = image_captured.q[3];
+        capture_info.attitude_euler_angle =
+            to_euler_angle_from_quaternion(capture_info.attitude_quaternion);
+        capture_info.file_url = std::string(image_captured.file_url);
+        capture_info.is_success = (image_captured.capture_result == 1);
+        capture_info.index = image_captured.image_index;
+
+        _capture_info.subscriptions.queue(_queue_user_callback, capture_info);
     }
 }
 
@@ -840,12 +882,7 @@ void CameraImpl::process_camera_information(const mavlink_message_t& message)
         _information.data.vendor_name = (char*)(camera_information.vendor_name);
         _information.data.model_name = (char*)(camera_information.model_name);
 
-        if (_information.subscription_callback) {
-            const auto temp_callback = _information.subscription_callback;
-            const auto temp_information = _information.data;
-            _parent->call_user_callback(
-                [temp_callback, temp_information]() { temp_callback(temp_information); });
-        }
+        _information.subscriptions.queue(_queue_user_callback, _information.data);
     }
 
     if (!_camera_definition) {
@@ -981,11 +1018,7 @@ void CameraImpl::process_flight_information(const mavlink_message_t& message)
 void CameraImpl::notify_video_stream_info()
 {
     std::lock_guard<std::mutex> lock(_video_stream_info.mutex);
-    if (_video_stream_info.subscription_callback) {
-        const auto temp_callback = _video_stream_info.subscription_callback;
-        const auto temp_info = _video_stream_info.data;
-        _parent->call_user_callback([temp_callback, temp_info]() { temp_callback(temp_info); });
-    }
+    _video_stream_info.subscriptions.queue(_queue_user_callback, _video_stream_info.data);
 }
 
 void CameraImpl::check_status()
@@ -993,11 +1026,7 @@ void CameraImpl::check_status()
     std::lock_guard<std::mutex> lock(_status.mutex);
 
     if (_status.received_camera_capture_status && _status.received_storage_information) {
-        if (_status.subscription_callback) {
-            const auto temp_callback = _status.subscription_callback;
-            const auto temp_data = _status.data;
-            _parent->call_user_callback([temp_callback, temp_data]() { temp_callback(temp_data); });
-        }
+        _status.subscriptions.queue(_queue_user_callback, _status.data);
 
         _status.received_camera_capture_status = false;
         _status.received_storage_information = false;
@@ -1048,16 +1077,8 @@ void CameraImpl::receive_set_mode_command_result(
 
 void CameraImpl::notify_mode()
 {
-    // Make a copy because it is passed to the thread pool
-    const auto temp_callback = _mode.subscription_callback;
-
-    if (temp_callback == nullptr) {
-        return;
-    }
-
     std::lock_guard<std::mutex> lock(_mode.mutex);
-    auto mode = _mode.data;
-    _parent->call_user_callback([mode, temp_callback]() { temp_callback(mode); });
+    _mode.subscriptions.queue(_queue_user_callback, _mode.data);
 }
 
 bool CameraImpl::get_possible_setting_options(std::vector<std::string>& settings)
@@ -1349,28 +1370,49 @@ void CameraImpl::get_option_async(
 
 void CameraImpl::current_settings_async(const Camera::CurrentSettingsCallback& callback)
 {
-    {
-        std::lock_guard<std::mutex> lock(_subscribe_current_settings.mutex);
-        _subscribe_current_settings.callback = callback;
-    }
+    _subscribe_current_settings.subscriptions.set(callback);
     notify_current_settings();
 }
 
+Camera::CurrentSettingsHandle CameraImpl::subscribe_current_settings(
+    const Camera::CurrentSettingsCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle = _subscribe_current_settings.subscriptions.subscribe(callback, queue_policy);
+    notify_current_settings();
+    return handle;
+}
+
+void CameraImpl::unsubscribe_current_settings(Camera::CurrentSettingsHandle handle)
+{
+    _subscribe_current_settings.subscriptions.unsubscribe(handle);
+}
+
 void CameraImpl::possible_setting_options_async(
     const Camera::PossibleSettingOptionsCallback& callback)
 {
-    {
-        std::lock_guard<std::mutex> lock(_subscribe_possible_setting_options.mutex);
-        _subscribe_possible_setting_options.callback = callback;
-    }
+    _subscribe_possible_setting_options.subscriptions.set(callback);
+    notify_possible_setting_options();
+}
+
+Camera::PossibleSettingOptionsHandle CameraImpl::subscribe_possible_setting_options(
+    const Camera::PossibleSettingOptionsCallback& callback, QueuePolicy queue_policy)
+{
+    auto handle =
+        _subscribe_possible_setting_options.subscriptions.subscribe(callback, queue_policy);
     notify_possible_setting_options();
+    return handle;
+}
+
+void CameraImpl::unsubscribe_possible_setting_options(Camera::PossibleSettingOptionsHandle handle)
+{
+    _subscribe_possible_setting_options.subscriptions.unsubscribe(handle);
 }
 
 void CameraImpl::notify_current_settings()
 {
     std::lock_guard<std::mutex> lock(_subscribe_current_settings.mutex);
 
-    if (!_subscribe_current_settings.callback) {
+    if (_subscribe_current_settings.subscriptions.empty()) {
         return;
     }
 
@@ -1405,20 +1447,14 @@ void CameraImpl::notify_current_settings()
         }
     }
 
-    const auto temp_callback = _subscribe_current_settings.callback;
-
-    // We create a function object in order to move be able to move the settings into it.
-    // FIXME: Use C++14 where this is not necessary anymore.
-    _parent->call_user_callback(std::bind(
-        [temp_callback](const std::vector<Camera::Setting>& settings) { temp_callback(settings); },
-        std::move(current_settings)));
+    _subscribe_current_settings.subscriptions.queue(_queue_user_callback, current_settings);
 }
 
 void CameraImpl::notify_possible_setting_options()
 {
     std::lock_guard<std::mutex> lock(_subscribe_possible_setting_options.mutex);
 
-    if (!_subscribe_possible_setting_options.callback) {
+    if (_subscribe_possible_setting_options.subscriptions.empty()) {
         return;
     }
 
@@ -1432,15 +1468,8 @@ void CameraImpl::notify_possible_setting_options()
         return;
     }
 
-    const auto temp_callback = _subscribe_possible_setting_options.callback;
-
-    // We create a function object in order to move be able to move the settings into it.
-    // FIXME: Use C++14 where this is not necessary anymore.
-    _parent->call_user_callback(std::bind(
-        [temp_callback](const std::vector<Camera::SettingOptions>& options) {
-            temp_callback(options);
-        },
-        std::move(setting_options)));
+    _subscribe_possible_setting_options.subscriptions.queue(
+        _queue_user_callback, setting_options);
 }
 
 std::vector<Camera::SettingOptions> CameraImpl::possible_setting_options()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "callback_list.h"
 #include "camera_definition.h"
 #include "mavlink_include.h"
 #include "plugins/camera/camera.h"
@@ -38,11 +39,17 @@ public:
 
     Camera::Information information() const;
     void information_async(const Camera::InformationCallback& callback);
+    Camera::InformationHandle subscribe_information(
+        const Camera::InformationCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_information(Camera::InformationHandle handle);
 
     std::pair<Camera::Result, Camera::VideoStreamInfo> get_video_stream_info();
 
     Camera::VideoStreamInfo video_stream_info();
     void video_stream_info_async(Camera::VideoStreamInfoCallback callback);
+    Camera::VideoStreamInfoHandle subscribe_video_stream_info(
+        const Camera::VideoStreamInfoCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_video_stream_info(Camera::VideoStreamInfoHandle handle);
 
     Camera::Result start_video_streaming();
     Camera::Result stop_video_streaming();
@@ -52,11 +59,20 @@ public:
 
     Camera::Mode mode();
     void mode_async(const Camera::ModeCallback callback);
+    Camera::ModeHandle subscribe_mode(
+        const Camera::ModeCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_mode(Camera::ModeHandle handle);
 
     void capture_info_async(Camera::CaptureInfoCallback callback);
+    Camera::CaptureInfoHandle subscribe_capture_info(
+        const Camera::CaptureInfoCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_capture_info(Camera::CaptureInfoHandle handle);
 
     Camera::Status status();
     void status_async(const Camera::StatusCallback callback);
+    Camera::StatusHandle subscribe_status(
+        const Camera::StatusCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_status(Camera::StatusHandle handle);
 
     Camera::Result set_setting(Camera::Setting setting);
     void set_setting_async(Camera::Setting setting, const Camera::ResultCallback callback);
@@ -69,7 +85,14 @@ public:
     bool is_setting_range(const std::string& setting_id);
 
     void current_settings_async(const Camera::CurrentSettingsCallback& callback);
+    Camera::CurrentSettingsHandle subscribe_current_settings(
+        const Camera::CurrentSettingsCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_current_settings(Camera::CurrentSettingsHandle handle);
+
     void possible_setting_options_async(const Camera::PossibleSettingOptionsCallback& callback);
+    Camera::PossibleSettingOptionsHandle subscribe_possible_setting_options(
+        const Camera::PossibleSettingOptionsCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_possible_setting_options(Camera::PossibleSettingOptionsHandle handle);
 
     Camera::Result format_storage();
     void format_storage_async(Camera::ResultCallback callback);
@@ -129,6 +152,12 @@ private:
 
     void check_status();
 
+    void update_status_requests();
+    void update_mode_requests();
+    void update_video_stream_info_requests();
+    void update_requests(
+        bool subscribed, const std::function<void()>& request, void** call_every_cookie);
+
     bool fetch_camera_definition(
         const mavlink_camera_information_t& camera_information, std::string& camera_definition_out);
     bool download_definition_file(const std::string& uri, std::string& camera_definition_out);
@@ -181,7 +210,7 @@ private:
         bool received_camera_capture_status{false};
         bool received_storage_information{false};
 
-        Camera::StatusCallback subscription_callback{nullptr};
+        CallbackList<Camera::Status> subscriptions{};
         void* call_every_cookie{nullptr};
     } _status{};
 
@@ -190,7 +219,7 @@ private:
     struct {
         std::mutex mutex{};
         Camera::Mode data{};
-        Camera::ModeCallback subscription_callback{nullptr};
+        CallbackList<Camera::Mode> subscriptions{};
         void* call_every_cookie{nullptr};
     } _mode{};
 
@@ -200,8 +229,7 @@ private:
     } _capture{};
 
     struct {
-        std::mutex mutex{};
-        Camera::CaptureInfoCallback callback{nullptr};
+        CallbackList<Camera::CaptureInfo> subscriptions{};
     } _capture_info{};
 
     struct {
@@ -209,23 +237,23 @@ private:
         Camera::VideoStreamInfo data{};
         bool available{false};
         void* call_every_cookie{nullptr};
-        Camera::VideoStreamInfoCallback subscription_callback{nullptr};
+        CallbackList<Camera::VideoStreamInfo> subscriptions{};
     } _video_stream_info{};
 
     struct {
         mutable std::mutex mutex{};
         Camera::Information data{};
-        Camera::InformationCallback subscription_callback{nullptr};
+        CallbackList<Camera::Information> subscriptions{};
     } _information{};
 
     struct {
         std::mutex mutex{};
-        Camera::CurrentSettingsCallback callback{nullptr};
+        CallbackList<std::vector<Camera::Setting>> subscriptions{};
     } _subscribe_current_settings{};
 
     struct {
         std::mutex mutex{};
-        Camera::PossibleSettingOptionsCallback callback{nullptr};
+        CallbackList<std::vector<Camera::SettingOptions>> subscriptions{};
     } _subscribe_possible_setting_options{};
 };
 
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "handle.h"
 #include "plugin_base.h"
 
 namespace mavsdk {
@@ -548,11 +549,31 @@ public:
 
     using ModeCallback = std::function<void(Mode)>;
 
+    /**
+     * @brief Handle type for subscribe_mode.
+     */
+    using ModeHandle = Handle<Mode>;
+
     /**
      * @brief Subscribe to camera mode updates.
      */
     void subscribe_mode(ModeCallback callback);
 
+    /**
+     * @brief Subscribe to camera mode updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ModeHandle subscribe_mode(ModeCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_mode.
+     */
+    void unsubscribe_mode(ModeHandle handle);
+
     /**
      * @brief Poll for 'Mode' (blocking).
      *
@@ -566,11 +587,31 @@ public:
 
     using InformationCallback = std::function<void(Information)>;
 
+    /**
+     * @brief Handle type for subscribe_information.
+     */
+    using InformationHandle = Handle<Information>;
+
     /**
      * @brief Subscribe to camera information updates.
      */
     void subscribe_information(InformationCallback callback);
 
+    /**
+     * @brief Subscribe to camera information updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    InformationHandle subscribe_information(InformationCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_information.
+     */
+    void unsubscribe_information(InformationHandle handle);
+
     /**
      * @brief Poll for 'Information' (blocking).
      *
@@ -584,11 +625,32 @@ public:
 
     using VideoStreamInfoCallback = std::function<void(VideoStreamInfo)>;
 
+    /**
+     * @brief Handle type for subscribe_video_stream_info.
+     */
+    using VideoStreamInfoHandle = Handle<VideoStreamInfo>;
+
     /**
      * @brief Subscribe to video stream info updates.
      */
     void subscribe_video_stream_info(VideoStreamInfoCallback callback);
 
+    /**
+     * @brief Subscribe to video stream info updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    VideoStreamInfoHandle subscribe_video_stream_info(
+        VideoStreamInfoCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_video_stream_info.
+     */
+    void unsubscribe_video_stream_info(VideoStreamInfoHandle handle);
+
     /**
      * @brief Poll for 'VideoStreamInfo' (blocking).
      *
@@ -602,22 +664,63 @@ public:
 
     using CaptureInfoCallback = std::function<void(CaptureInfo)>;
 
+    /**
+     * @brief Handle type for subscribe_capture_info.
+     */
+    using CaptureInfoHandle = Handle<CaptureInfo>;
+
     /**
      * @brief Subscribe to capture info updates.
      */
     void subscribe_capture_info(CaptureInfoCallback callback);
 
+    /**
+     * @brief Subscribe to capture info updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    CaptureInfoHandle subscribe_capture_info(
+        CaptureInfoCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_capture_info.
+     */
+    void unsubscribe_capture_info(CaptureInfoHandle handle);
+
     /**
      * @brief Callback type for subscribe_status.
      */
 
     using StatusCallback = std::function<void(Status)>;
 
+    /**
+     * @brief Handle type for subscribe_status.
+     */
+    using StatusHandle = Handle<Status>;
+
     /**
      * @brief Subscribe to camera status updates.
      */
     void subscribe_status(StatusCallback callback);
 
+    /**
+     * @brief Subscribe to camera status updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    StatusHandle subscribe_status(StatusCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_status.
+     */
+    void unsubscribe_status(StatusHandle handle);
+
     /**
      * @brief Poll for 'Status' (blocking).
      *
@@ -631,22 +734,64 @@ public:
 
     using CurrentSettingsCallback = std::function<void(std::vector<Setting>)>;
 
+    /**
+     * @brief Handle type for subscribe_current_settings.
+     */
+    using CurrentSettingsHandle = Handle<std::vector<Setting>>;
+
     /**
      * @brief Get the list of current camera settings.
      */
     void subscribe_current_settings(CurrentSettingsCallback callback);
 
+    /**
+     * @brief Get the list of current camera settings.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    CurrentSettingsHandle subscribe_current_settings(
+        CurrentSettingsCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_current_settings.
+     */
+    void unsubscribe_current_settings(CurrentSettingsHandle handle);
+
     /**
      * @brief Callback type for subscribe_possible_setting_options.
      */
 
     using PossibleSettingOptionsCallback = std::function<void(std::vector<SettingOptions>)>;
 
+    /**
+     * @brief Handle type for subscribe_possible_setting_options.
+     */
+    using PossibleSettingOptionsHandle = Handle<std::vector<SettingOptions>>;
+
     /**
      * @brief Get the list of settings that can be changed.
      */
     void subscribe_possible_setting_options(PossibleSettingOptionsCallback callback);
 
+    /**
+     * @brief Get the list of settings that can be changed.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    PossibleSettingOptionsHandle subscribe_possible_setting_options(
+        PossibleSettingOptionsCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_possible_setting_options.
+     */
+    void unsubscribe_possible_setting_options(PossibleSettingOptionsHandle handle);
+
     /**
      * @brief Poll for 'std::vector<SettingOptions>' (blocking).
      *
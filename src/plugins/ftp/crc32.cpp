@@ -38,7 +38,7 @@
 
 namespace mavsdk {
 
-static const uint32_t crc32_tab[] = {
+static constexpr uint32_t crc32_tab[256] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
     0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
     0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
@@ -72,12 +72,53 @@ static const uint32_t crc32_tab[] = {
     0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
     0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
 
+// For slicing-by-8: crc32_tables[k][i] is the CRC of byte i followed by k zero bytes, so
+// that 8 bytes can be looked up at once instead of one after the other.
+struct Crc32Tables {
+    uint32_t entries[8][256];
+};
+
+static constexpr Crc32Tables make_crc32_tables()
+{
+    Crc32Tables tables{};
+    for (unsigned i = 0; i < 256; i++) {
+        tables.entries[0][i] = crc32_tab[i];
+    }
+    for (unsigned k = 1; k < 8; k++) {
+        for (unsigned i = 0; i < 256; i++) {
+            const uint32_t previous = tables.entries[k - 1][i];
+            tables.entries[k][i] = crc32_tab[previous & 0xff] ^ (previous >> 8);
+        }
+    }
+    return tables;
+}
+
+static constexpr Crc32Tables crc32_tables = make_crc32_tables();
+
+static inline uint32_t load_le32(const uint8_t* src)
+{
+    return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+}
+
 uint32_t Crc32::add(const uint8_t* src, uint32_t len)
 {
+    const auto& t = crc32_tables.entries;
+
+    while (len >= 8) {
+        const uint32_t one = load_le32(src) ^ val;
+        const uint32_t two = load_le32(src + 4);
+        val = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^ t[5][(one >> 16) & 0xff] ^
+              t[4][one >> 24] ^ t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^
+              t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+        src += 8;
+        len -= 8;
+    }
+
     for (uint32_t i = 0; i < len; i++) {
         val = crc32_tab[(val ^ src[i]) & 0xff] ^ (val >> 8);
     }
     return val;
 }
 
-} // namespace mavsdk
\ No newline at end of file
+} // namespace mavsdk
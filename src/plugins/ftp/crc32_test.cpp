@@ -0,0 +1,110 @@
+#include "crc32.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+// The CRC32 as calculated one bit at a time, to compare against.
+uint32_t reference_crc32(uint32_t crc, const uint8_t* src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; ++i) {
+        crc ^= src[i];
+        for (unsigned bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320u : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+std::vector<uint8_t> make_random_data(std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<unsigned> distribution(0, 255);
+    std::vector<uint8_t> data(size);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(distribution(generator));
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(Crc32, MatchesKnownValue)
+{
+    // No initial value or final xor, so this is not the usual 0xcbf43926.
+    const char text[] = "123456789";
+    Crc32 checksum;
+    checksum.add(reinterpret_cast<const uint8_t*>(text), 9);
+    EXPECT_EQ(static_cast<uint32_t>(checksum.get()), 0x2dfd2d88u);
+}
+
+TEST(Crc32, MatchesReferenceForAnyLengthAndAlignment)
+{
+    const auto data = make_random_data(4096);
+
+    for (uint32_t offset = 0; offset < 8; ++offset) {
+        for (uint32_t len : {0u, 1u, 7u, 8u, 9u, 15u, 16u, 17u, 239u, 1000u, 4000u}) {
+            Crc32 checksum;
+            checksum.add(data.data() + offset, len);
+            EXPECT_EQ(
+                static_cast<uint32_t>(checksum.get()),
+                reference_crc32(0, data.data() + offset, len));
+        }
+    }
+}
+
+TEST(Crc32, AddsUpInPieces)
+{
+    const auto data = make_random_data(4096);
+    const uint32_t expected = reference_crc32(0, data.data(), data.size());
+
+    for (uint32_t piece : {1u, 3u, 8u, 13u, 239u, 1024u}) {
+        Crc32 checksum;
+        for (uint32_t offset = 0; offset < data.size(); offset += piece) {
+            const uint32_t len = std::min<uint32_t>(piece, data.size() - offset);
+            checksum.add(data.data() + offset, len);
+        }
+        EXPECT_EQ(static_cast<uint32_t>(checksum.get()), expected);
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests to compare against one byte at a time.
+TEST(Crc32, DISABLED_Benchmark)
+{
+    constexpr uint32_t size = 64 * 1024 * 1024;
+    const auto data = make_random_data(size);
+
+    // The table lookup per byte, as Crc32 used to do it.
+    uint32_t table[256];
+    for (uint32_t i = 0; i < 256; ++i) {
+        const uint8_t byte = static_cast<uint8_t>(i);
+        table[i] = reference_crc32(0, &byte, 1);
+    }
+
+    const auto before_bytewise = std::chrono::steady_clock::now();
+    uint32_t bytewise = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        bytewise = table[(bytewise ^ data[i]) & 0xff] ^ (bytewise >> 8);
+    }
+    const auto after_bytewise = std::chrono::steady_clock::now();
+
+    Crc32 checksum;
+    checksum.add(data.data(), size);
+    const auto after_crc32 = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(static_cast<uint32_t>(checksum.get()), bytewise);
+
+    const double megabytes = size / (1024.0 * 1024.0);
+    std::cout << "byte-wise: "
+              << megabytes / std::chrono::duration<double>(after_bytewise - before_bytewise).count()
+              << " MiB/s, Crc32: "
+              << megabytes / std::chrono::duration<double>(after_crc32 - after_bytewise).count()
+              << " MiB/s" << std::endl;
+}
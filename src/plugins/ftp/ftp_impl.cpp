@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <iostream>
 
 #if defined(WINDOWS)
@@ -50,68 +52,138 @@ void FtpImpl::enable() {}
 
 void FtpImpl::disable() {}
 
+FtpImpl::ClientOp* FtpImpl::_add_client_op(std::unique_ptr<ClientOp> op)
+{
+    // Needs to be called with _client_ops_mutex locked.
+    if (_client_ops.size() >= max_client_ops) {
+        return nullptr;
+    }
+    op->id = _next_client_op_id++;
+    _client_ops.push_back(std::move(op));
+    return _client_ops.back().get();
+}
+
+FtpImpl::ClientOp* FtpImpl::_find_client_op(const PayloadHeader& payload)
+{
+    // Needs to be called with _client_ops_mutex locked.
+    switch (payload.req_opcode) {
+        case CMD_READ_FILE:
+        case CMD_BURST_READ_FILE:
+        case CMD_WRITE_FILE:
+        case CMD_TERMINATE_SESSION:
+            // Replies within a session are told apart by the session, as there can be many
+            // requests in flight for one.
+            for (auto& op : _client_ops) {
+                if (op->session_valid && op->session == payload.session) {
+                    return op.get();
+                }
+            }
+            return nullptr;
+
+        default:
+            // Everything else has one request in flight at a time.
+            for (auto& op : _client_ops) {
+                if (op->opcode == payload.req_opcode &&
+                    static_cast<uint16_t>(op->last_seq_number + 1) == payload.seq_number) {
+                    return op.get();
+                }
+            }
+            return nullptr;
+    }
+}
+
+FtpImpl::ClientOp* FtpImpl::_find_client_op(uint32_t id)
+{
+    // Needs to be called with _client_ops_mutex locked.
+    for (auto& op : _client_ops) {
+        if (op->id == id) {
+            return op.get();
+        }
+    }
+    return nullptr;
+}
+
+void FtpImpl::_remove_finished_client_ops()
+{
+    // Needs to be called with _client_ops_mutex locked.
+    for (auto it = _client_ops.begin(); it != _client_ops.end();) {
+        if ((*it)->opcode == CMD_NONE) {
+            _stop_timer(**it);
+            it = _client_ops.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void FtpImpl::_process_ack(PayloadHeader* payload)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
 
-    if (_curr_op != payload->req_opcode) {
-        LogWarn() << "Received ACK not matching our current operation";
+    ClientOp* op = _find_client_op(*payload);
+    if (op == nullptr) {
+        LogWarn() << "Received ACK not matching any operation";
         return;
     }
 
-    switch (_curr_op) {
-        case CMD_NONE:
-            LogWarn() << "Received ACK without active operation";
-            break;
+    // Chunks of a download are taken, no matter if they come from a burst or a read.
+    if ((op->opcode == CMD_BURST_READ_FILE || op->opcode == CMD_READ_FILE) &&
+        (payload->req_opcode == CMD_BURST_READ_FILE || payload->req_opcode == CMD_READ_FILE)) {
+        _process_download_ack(*op, payload);
+        _remove_finished_client_ops();
+        return;
+    }
 
-        case CMD_OPEN_FILE_RO:
-            _curr_op = CMD_NONE;
-            _session_valid = true;
-            _session = payload->session;
-            _bytes_transferred = 0;
-            _file_size = *(reinterpret_cast<uint32_t*>(payload->data));
-            _call_op_progress_callback(_bytes_transferred, _file_size);
-            _read();
-            break;
+    if (op->opcode != payload->req_opcode) {
+        LogWarn() << "Received ACK not matching our current operation";
+        return;
+    }
 
-        case CMD_READ_FILE:
-            _ofstream.stream.write(reinterpret_cast<const char*>(payload->data), payload->size);
-            if (!_ofstream.stream) {
-                _session_result = ServerResult::ERR_FILE_IO_ERROR;
-                _end_read_session();
-                return;
+    switch (op->opcode) {
+        case CMD_OPEN_FILE_RO:
+            op->opcode = CMD_NONE;
+            op->session_valid = true;
+            op->session = payload->session;
+            op->bytes_transferred = 0;
+            op->file_size = *(reinterpret_cast<uint32_t*>(payload->data));
+            op->download = DownloadState{};
+            op->download.chunks_missing = (op->file_size + max_data_length - 1) / max_data_length;
+            op->download.chunk_received.assign(op->download.chunks_missing, false);
+            _call_op_progress_callback(*op);
+            if (op->download.chunks_missing == 0) {
+                op->session_result = ServerResult::SUCCESS;
+                _end_read_session(*op);
+            } else {
+                _request_burst(*op);
             }
-            _bytes_transferred += payload->size;
-            _call_op_progress_callback(_bytes_transferred, _file_size);
-            _read();
             break;
 
         case CMD_OPEN_FILE_WO:
-            _curr_op = CMD_NONE;
-            _session_valid = true;
-            _session = payload->session;
-            _bytes_transferred = 0;
-            _call_op_progress_callback(_bytes_transferred, _file_size);
-            _write();
+            op->opcode = CMD_NONE;
+            op->session_valid = true;
+            op->session = payload->session;
+            op->bytes_transferred = 0;
+            op->upload = UploadState{};
+            _call_op_progress_callback(*op);
+            _fill_upload_window(*op);
             break;
 
         case CMD_WRITE_FILE:
-            _call_op_progress_callback(_bytes_transferred, _file_size);
-            _write();
+            _process_upload_ack(*op, payload);
             break;
 
         case CMD_TERMINATE_SESSION:
-            _curr_op = CMD_NONE;
-            _session_valid = false;
-            _stop_timer();
-            _call_op_result_callback(_session_result);
+            op->opcode = CMD_NONE;
+            op->session_valid = false;
+            _stop_timer(*op);
+            _call_op_result_callback(*op, op->session_result);
             break;
 
         case CMD_RESET_SESSIONS:
-            _curr_op = CMD_NONE;
-            _session_valid = false;
-            _stop_timer();
-            _call_op_result_callback(_session_result);
+            op->opcode = CMD_NONE;
+            op->session_valid = false;
+            _stop_timer(*op);
+            _call_op_result_callback(*op, op->session_result);
             break;
 
         case CMD_LIST_DIRECTORY: {
@@ -122,37 +194,39 @@ void FtpImpl::_process_ack(PayloadHeader* payload)
                     std::string entry = std::string(reinterpret_cast<char*>(&payload->data[start]));
                     if (entry.length() > 0) {
                         added = true;
-                        _curr_directory_list.emplace_back(entry);
+                        op->directory_list.emplace_back(entry);
                     }
                     start = i + 1;
                 }
             }
             if (added) {
                 // Ask for next batch of file names
-                _list_directory(_curr_directory_list.size());
+                _list_directory(*op, op->directory_list.size());
             } else {
                 // We came to end - report entire list
-                _curr_op = CMD_NONE;
-                _stop_timer();
-                _call_dir_items_result_callback(ServerResult::SUCCESS, _curr_directory_list);
+                op->opcode = CMD_NONE;
+                _stop_timer(*op);
+                _call_dir_items_result_callback(*op, ServerResult::SUCCESS);
             }
             break;
         }
 
         case CMD_CALC_FILE_CRC32: {
-            _curr_op = CMD_NONE;
+            op->opcode = CMD_NONE;
             uint32_t checksum = *reinterpret_cast<uint32_t*>(payload->data);
-            _stop_timer();
-            _call_crc32_result_callback(ServerResult::SUCCESS, checksum);
+            _stop_timer(*op);
+            _call_crc32_result_callback(*op, ServerResult::SUCCESS, checksum);
             break;
         }
 
         default:
-            _curr_op = CMD_NONE;
-            _stop_timer();
-            _call_op_result_callback(ServerResult::SUCCESS);
+            op->opcode = CMD_NONE;
+            _stop_timer(*op);
+            _call_op_result_callback(*op, ServerResult::SUCCESS);
             break;
     }
+
+    _remove_finished_client_ops();
 }
 
 void FtpImpl::_process_nak(PayloadHeader* payload)
@@ -163,104 +237,127 @@ void FtpImpl::_process_nak(PayloadHeader* payload)
         if (sr == ServerResult::ERR_FAIL_ERRNO && payload->data[1] == ENOENT) {
             sr = ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST;
         }
-        _process_nak(sr);
+
+        std::lock_guard<std::mutex> lock(_client_ops_mutex);
+        ClientOp* op = _find_client_op(*payload);
+        if (op == nullptr) {
+            LogWarn() << "Received NAK not matching any operation";
+            return;
+        }
+        _process_nak(*op, sr);
+        _remove_finished_client_ops();
     }
 }
 
-void FtpImpl::_process_nak(ServerResult result)
+void FtpImpl::_process_nak(ClientOp& op, ServerResult result)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    switch (_curr_op) {
+    // Needs to be called with _client_ops_mutex locked.
+
+    // Ending a session sets the operation to CMD_TERMINATE_SESSION.
+    const Opcode opcode = op.opcode;
+    op.opcode = CMD_NONE;
+
+    switch (opcode) {
         case CMD_NONE:
             LogWarn() << "Received NAK without active operation";
             break;
 
+        case CMD_BURST_READ_FILE:
+            if (result == ServerResult::ERR_EOF) {
+                // The burst went up to the end of the file, now get what got lost on the way.
+                _reset_timer(op);
+                _continue_download(op);
+                break;
+            }
+            // FALLTHROUGH
         case CMD_OPEN_FILE_RO:
         case CMD_READ_FILE:
-            _session_result = result;
-            if (_session_valid) {
+            op.session_result = result;
+            if (op.session_valid) {
                 const bool delete_file = (result == ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST);
-                _end_read_session(delete_file);
+                _end_read_session(op, delete_file);
             } else {
-                _stop_timer();
-                _call_op_result_callback(_session_result);
+                _stop_timer(op);
+                _call_op_result_callback(op, op.session_result);
             }
             break;
 
         case CMD_OPEN_FILE_WO:
         case CMD_WRITE_FILE:
-            _session_result = result;
-            if (_session_valid) {
-                _end_write_session();
+            op.session_result = result;
+            if (op.session_valid) {
+                _end_write_session(op);
             } else {
-                _stop_timer();
-                _call_op_result_callback(_session_result);
+                _stop_timer(op);
+                _call_op_result_callback(op, op.session_result);
             }
             break;
 
         case CMD_TERMINATE_SESSION:
-            _session_valid = false;
-            _stop_timer();
-            _call_op_result_callback(_session_result);
+            op.session_valid = false;
+            _stop_timer(op);
+            _call_op_result_callback(op, op.session_result);
             break;
 
         case CMD_LIST_DIRECTORY:
-            _stop_timer();
-            if (!_curr_directory_list.empty()) {
-                _call_dir_items_result_callback(ServerResult::SUCCESS, _curr_directory_list);
+            _stop_timer(op);
+            if (!op.directory_list.empty()) {
+                _call_dir_items_result_callback(op, ServerResult::SUCCESS);
             } else {
-                _call_dir_items_result_callback(result, _curr_directory_list);
+                _call_dir_items_result_callback(op, result);
             }
             break;
 
         case CMD_CALC_FILE_CRC32:
-            _stop_timer();
-            _call_crc32_result_callback(result, 0);
+            _stop_timer(op);
+            _call_crc32_result_callback(op, result, 0);
             break;
 
         default:
-            _stop_timer();
-            _call_op_result_callback(result);
+            _stop_timer(op);
+            _call_op_result_callback(op, result);
             break;
     }
-    _curr_op = CMD_NONE;
 }
 
-void FtpImpl::_call_op_result_callback(ServerResult result)
+void FtpImpl::_call_op_result_callback(const ClientOp& op, ServerResult result)
 {
-    if (_curr_op_result_callback) {
-        const auto temp_callback = _curr_op_result_callback;
+    if (op.result_callback) {
+        const auto temp_callback = op.result_callback;
         _parent->call_user_callback(
             [temp_callback, result]() { temp_callback(_translate(result)); });
     }
 }
 
-void FtpImpl::_call_op_progress_callback(uint32_t bytes_read, uint32_t total_bytes)
+void FtpImpl::_call_op_progress_callback(const ClientOp& op)
 {
-    if (_curr_op_progress_callback) {
-        const auto temp_callback = _curr_op_progress_callback;
-        _parent->call_user_callback([temp_callback, bytes_read, total_bytes]() {
+    if (op.progress_callback) {
+        const auto temp_callback = op.progress_callback;
+        const uint32_t bytes_transferred = op.bytes_transferred;
+        const uint32_t total_bytes = op.file_size;
+        _parent->call_user_callback([temp_callback, bytes_transferred, total_bytes]() {
             Ftp::ProgressData progress;
-            progress.bytes_transferred = bytes_read;
+            progress.bytes_transferred = bytes_transferred;
             progress.total_bytes = total_bytes;
             temp_callback(Ftp::Result::Next, progress);
         });
     }
 }
 
-void FtpImpl::_call_dir_items_result_callback(ServerResult result, std::vector<std::string> list)
+void FtpImpl::_call_dir_items_result_callback(const ClientOp& op, ServerResult result)
 {
-    if (_curr_dir_items_result_callback) {
-        const auto temp_callback = _curr_dir_items_result_callback;
+    if (op.dir_items_result_callback) {
+        const auto temp_callback = op.dir_items_result_callback;
+        const auto list = op.directory_list;
         _parent->call_user_callback(
             [temp_callback, result, list]() { temp_callback(_translate(result), list); });
     }
 }
 
-void FtpImpl::_call_crc32_result_callback(ServerResult result, uint32_t crc32)
+void FtpImpl::_call_crc32_result_callback(const ClientOp& op, ServerResult result, uint32_t crc32)
 {
-    if (_current_crc32_result_callback) {
-        const auto temp_callback = _current_crc32_result_callback;
+    if (op.crc32_result_callback) {
+        const auto temp_callback = op.crc32_result_callback;
         _parent->call_user_callback(
             [temp_callback, result, crc32]() { temp_callback(_translate(result), crc32); });
     }
@@ -283,6 +380,8 @@ Ftp::Result FtpImpl::_translate(ServerResult result)
             return Ftp::Result::Unsupported;
         case ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST:
             return Ftp::Result::FileDoesNotExist;
+        case ServerResult::ERR_NO_SESSIONS_AVAILABLE:
+            return Ftp::Result::Busy;
         default:
             return Ftp::Result::ProtocolError;
     }
@@ -290,8 +389,9 @@ Ftp::Result FtpImpl::_translate(ServerResult result)
 
 void FtpImpl::reset_async(Ftp::ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE) {
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::make_unique<ClientOp>());
+    if (op == nullptr) {
         callback(Ftp::Result::Busy);
         return;
     }
@@ -299,74 +399,226 @@ void FtpImpl::reset_async(Ftp::ResultCallback callback)
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
-    payload->session = _session;
-    payload->opcode = _curr_op = CMD_RESET_SESSIONS;
+    payload->session = 0;
+    payload->opcode = op->opcode = CMD_RESET_SESSIONS;
     payload->offset = 0;
     payload->size = 0;
-    _curr_op_result_callback = callback;
-    _send_mavlink_ftp_message(raw_payload);
+    op->result_callback = callback;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
 void FtpImpl::download_async(
     const std::string& remote_path, const std::string& local_folder, Ftp::DownloadCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE) {
+    if (remote_path.length() >= max_data_length) {
         Ftp::ProgressData empty{};
-        callback(Ftp::Result::Busy, empty);
+        callback(Ftp::Result::InvalidParameter, empty);
         return;
     }
 
     std::string local_path = local_folder + path_separator + fs_filename(remote_path);
 
-    _ofstream.stream.open(local_path, std::fstream::trunc | std::fstream::binary);
-    _ofstream.path = local_path;
-    if (!_ofstream.stream) {
-        _end_read_session();
+    auto new_op = std::make_unique<ClientOp>();
+    new_op->ofstream.stream.open(local_path, std::fstream::trunc | std::fstream::binary);
+    new_op->ofstream.path = local_path;
+    if (!new_op->ofstream.stream) {
         Ftp::ProgressData empty{};
         callback(Ftp::Result::FileIoError, empty);
         return;
     }
 
-    _curr_op_progress_callback = callback;
-
-    const auto result_callback = [callback](Ftp::Result result) {
+    new_op->progress_callback = callback;
+    new_op->result_callback = [callback](Ftp::Result result) {
         Ftp::ProgressData empty{};
         callback(result, empty);
     };
 
-    _generic_command_async(CMD_OPEN_FILE_RO, 0, remote_path, result_callback);
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::move(new_op));
+    if (op == nullptr) {
+        Ftp::ProgressData empty{};
+        callback(Ftp::Result::Busy, empty);
+        return;
+    }
+
+    uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
+    PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
+    payload->seq_number = _seq_number++;
+    payload->session = 0;
+    payload->opcode = op->opcode = CMD_OPEN_FILE_RO;
+    payload->offset = 0;
+    strncpy(reinterpret_cast<char*>(payload->data), remote_path.c_str(), max_data_length - 1);
+    payload->size = remote_path.length() + 1;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
-void FtpImpl::_end_read_session(bool delete_file)
+void FtpImpl::_end_read_session(ClientOp& op, bool delete_file)
 {
-    _curr_op = CMD_NONE;
-    if (_ofstream.stream.is_open()) {
-        _ofstream.stream.close();
+    op.opcode = CMD_NONE;
+    if (op.ofstream.stream.is_open()) {
+        op.ofstream.stream.close();
 
         if (delete_file) {
-            fs_remove(_ofstream.path);
+            fs_remove(op.ofstream.path);
         }
     }
-    _terminate_session();
+    _terminate_session(op);
 }
 
-void FtpImpl::_read()
+void FtpImpl::_request_burst(ClientOp& op, bool is_retry)
 {
-    if (_bytes_transferred >= _file_size) {
-        _session_result = ServerResult::SUCCESS;
-        _end_read_session();
-        return;
-    }
-
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
-    payload->session = _session;
-    payload->opcode = _curr_op = CMD_READ_FILE;
-    payload->offset = _bytes_transferred;
+    payload->session = op.session;
+    payload->opcode = op.opcode = CMD_BURST_READ_FILE;
+    payload->offset = op.download.received_up_to;
     payload->size = 0;
-    _send_mavlink_ftp_message(raw_payload);
+    _send_mavlink_ftp_message(op, raw_payload, is_retry);
+}
+
+void FtpImpl::_request_missing_chunks(ClientOp& op, bool is_retry)
+{
+    DownloadState& download = op.download;
+    const auto chunk_count = static_cast<uint32_t>(download.chunk_received.size());
+
+    while (download.first_missing_chunk < chunk_count &&
+           download.chunk_received[download.first_missing_chunk]) {
+        ++download.first_missing_chunk;
+    }
+
+    for (uint32_t chunk = download.first_missing_chunk;
+         chunk < chunk_count && download.reads_in_flight.size() < download_read_window;
+         ++chunk) {
+        if (download.chunk_received[chunk] ||
+            std::find(download.reads_in_flight.begin(), download.reads_in_flight.end(), chunk) !=
+                download.reads_in_flight.end()) {
+            continue;
+        }
+
+        uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
+        PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
+        payload->seq_number = _seq_number++;
+        payload->session = op.session;
+        payload->opcode = op.opcode = CMD_READ_FILE;
+        payload->offset = chunk * max_data_length;
+        payload->size = 0;
+        download.reads_in_flight.push_back(chunk);
+        _send_mavlink_ftp_message(op, raw_payload, is_retry);
+    }
+}
+
+void FtpImpl::_continue_download(ClientOp& op)
+{
+    if (op.download.chunks_missing == 0) {
+        op.session_result = ServerResult::SUCCESS;
+        _end_read_session(op);
+        return;
+    }
+
+    op.opcode = CMD_READ_FILE;
+    _request_missing_chunks(op);
+}
+
+void FtpImpl::_process_download_ack(ClientOp& op, PayloadHeader* payload)
+{
+    // Any data coming in means the server is still there.
+    _reset_timer(op);
+
+    if (!_write_downloaded_chunk(op, payload)) {
+        op.session_result = ServerResult::ERR_FILE_IO_ERROR;
+        _end_read_session(op);
+        return;
+    }
+
+    if (op.download.chunks_missing == 0) {
+        op.session_result = ServerResult::SUCCESS;
+        _end_read_session(op);
+        return;
+    }
+
+    if (op.opcode == CMD_READ_FILE) {
+        _request_missing_chunks(op);
+        return;
+    }
+
+    if (payload->req_opcode == CMD_BURST_READ_FILE && payload->burst_complete) {
+        if (op.download.received_up_to < op.file_size) {
+            _request_burst(op);
+        } else {
+            _continue_download(op);
+        }
+    }
+}
+
+bool FtpImpl::_write_downloaded_chunk(ClientOp& op, PayloadHeader* payload)
+{
+    DownloadState& download = op.download;
+
+    // Chunks always start at a multiple of max_data_length, because that's how they are
+    // requested, anything else can't be tracked.
+    if (payload->size == 0 || payload->offset % max_data_length != 0) {
+        return true;
+    }
+
+    const uint32_t chunk = payload->offset / max_data_length;
+
+    download.reads_in_flight.erase(
+        std::remove(download.reads_in_flight.begin(), download.reads_in_flight.end(), chunk),
+        download.reads_in_flight.end());
+
+    if (chunk >= download.chunk_received.size() || download.chunk_received[chunk]) {
+        return true;
+    }
+
+    op.ofstream.stream.seekp(payload->offset);
+    op.ofstream.stream.write(reinterpret_cast<const char*>(payload->data), payload->size);
+    if (!op.ofstream.stream) {
+        return false;
+    }
+
+    download.chunk_received[chunk] = true;
+    --download.chunks_missing;
+    download.received_up_to = std::max(download.received_up_to, payload->offset + payload->size);
+
+    op.bytes_transferred += payload->size;
+    _call_op_progress_callback(op);
+    return true;
+}
+
+bool FtpImpl::_resend_requests(ClientOp& op)
+{
+    switch (op.opcode) {
+        case CMD_BURST_READ_FILE:
+            // Continue after the last chunk we got, everything lost before is fetched at the end.
+            if (op.download.received_up_to < op.file_size) {
+                _request_burst(op, true);
+            } else {
+                op.download.reads_in_flight.clear();
+                op.opcode = CMD_READ_FILE;
+                _request_missing_chunks(op, true);
+            }
+            return true;
+
+        case CMD_READ_FILE:
+            op.download.reads_in_flight.clear();
+            _request_missing_chunks(op, true);
+            return true;
+
+        case CMD_WRITE_FILE:
+            // Only the writes not acked yet, and fewer of them from now on.
+            op.upload.window = std::max<std::size_t>(1, op.upload.window / 2);
+            op.upload.acks_since_loss = 0;
+            for (const uint32_t offset : op.upload.writes_in_flight) {
+                if (!_send_write(op, offset, true)) {
+                    break;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
 }
 
 void FtpImpl::upload_async(
@@ -374,87 +626,146 @@ void FtpImpl::upload_async(
     const std::string& remote_folder,
     Ftp::UploadCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE) {
+    if (!fs_exists(local_file_path)) {
         Ftp::ProgressData empty{};
-        callback(Ftp::Result::Busy, empty);
+        callback(Ftp::Result::FileDoesNotExist, empty);
         return;
     }
 
-    if (!fs_exists(local_file_path)) {
+    std::string local_path(local_file_path);
+    std::string remote_file_path = remote_folder + path_separator + fs_filename(local_path);
+    if (remote_file_path.length() >= max_data_length) {
         Ftp::ProgressData empty{};
-        callback(Ftp::Result::FileDoesNotExist, empty);
+        callback(Ftp::Result::InvalidParameter, empty);
         return;
     }
 
-    _ifstream.open(local_file_path, std::fstream::binary);
-    if (!_ifstream) {
-        _end_write_session();
+    auto new_op = std::make_unique<ClientOp>();
+    new_op->ifstream.open(local_file_path, std::fstream::binary);
+    if (!new_op->ifstream) {
         Ftp::ProgressData empty{};
         callback(Ftp::Result::FileIoError, empty);
         return;
     }
 
-    _file_size = fs_file_size(local_file_path);
-    _curr_op_progress_callback = callback;
-    std::string local_path(local_file_path);
-    std::string remote_file_path = remote_folder + path_separator + fs_filename(local_path);
-
-    const auto result_callback = [callback](Ftp::Result result) {
+    new_op->file_size = fs_file_size(local_file_path);
+    new_op->progress_callback = callback;
+    new_op->result_callback = [callback](Ftp::Result result) {
         Ftp::ProgressData empty{};
         callback(result, empty);
     };
 
-    _generic_command_async(CMD_OPEN_FILE_WO, 0, remote_file_path, result_callback);
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::move(new_op));
+    if (op == nullptr) {
+        Ftp::ProgressData empty{};
+        callback(Ftp::Result::Busy, empty);
+        return;
+    }
+
+    uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
+    PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
+    payload->seq_number = _seq_number++;
+    payload->session = 0;
+    payload->opcode = op->opcode = CMD_OPEN_FILE_WO;
+    payload->offset = 0;
+    strncpy(reinterpret_cast<char*>(payload->data), remote_file_path.c_str(), max_data_length - 1);
+    payload->size = remote_file_path.length() + 1;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
-void FtpImpl::_end_write_session()
+void FtpImpl::_end_write_session(ClientOp& op)
 {
-    _curr_op = CMD_NONE;
-    if (_ifstream) {
-        _ifstream.close();
+    op.opcode = CMD_NONE;
+    if (op.ifstream) {
+        op.ifstream.close();
     }
-    _terminate_session();
+    _terminate_session(op);
 }
 
-void FtpImpl::_write()
+void FtpImpl::_fill_upload_window(ClientOp& op)
 {
-    if (_bytes_transferred >= _file_size) {
-        _session_result = ServerResult::SUCCESS;
-        _end_write_session();
+    UploadState& upload = op.upload;
+
+    if (upload.writes_in_flight.empty() && upload.next_offset >= op.file_size) {
+        op.session_result = ServerResult::SUCCESS;
+        _end_write_session(op);
         return;
     }
 
+    while (upload.writes_in_flight.size() < upload.window && upload.next_offset < op.file_size) {
+        const uint32_t offset = upload.next_offset;
+        if (!_send_write(op, offset)) {
+            return;
+        }
+        upload.writes_in_flight.push_back(offset);
+        upload.next_offset += max_data_length;
+    }
+}
+
+bool FtpImpl::_send_write(ClientOp& op, uint32_t offset, bool is_retry)
+{
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
-    payload->session = _session;
-    payload->opcode = _curr_op = CMD_WRITE_FILE;
-    payload->offset = _bytes_transferred;
-    int bytes_read = _ifstream.readsome(reinterpret_cast<char*>(payload->data), max_data_length);
-    if (!_ifstream) {
-        _end_write_session();
-        _call_op_result_callback(ServerResult::ERR_FILE_IO_ERROR);
+    payload->session = op.session;
+    payload->opcode = op.opcode = CMD_WRITE_FILE;
+    payload->offset = offset;
+
+    // Chunks are read again when they have to be resent, the last one ends up short and
+    // sets eof, which is not an error.
+    op.ifstream.clear();
+    op.ifstream.seekg(offset);
+    op.ifstream.read(reinterpret_cast<char*>(payload->data), max_data_length);
+    if (op.ifstream.bad() || op.ifstream.gcount() <= 0) {
+        // The result is reported once the session is terminated.
+        op.session_result = ServerResult::ERR_FILE_IO_ERROR;
+        _end_write_session(op);
+        return false;
+    }
+    payload->size = static_cast<uint8_t>(op.ifstream.gcount());
+    _send_mavlink_ftp_message(op, raw_payload, is_retry);
+    return true;
+}
+
+void FtpImpl::_process_upload_ack(ClientOp& op, PayloadHeader* payload)
+{
+    UploadState& upload = op.upload;
+
+    _reset_timer(op);
+
+    const auto it =
+        std::find(upload.writes_in_flight.begin(), upload.writes_in_flight.end(), payload->offset);
+    if (it == upload.writes_in_flight.end()) {
+        // ACK of a write we had resent already.
         return;
     }
-    payload->size = bytes_read;
-    _bytes_transferred += bytes_read;
-    _send_mavlink_ftp_message(raw_payload);
+    upload.writes_in_flight.erase(it);
+
+    op.bytes_transferred += std::min<uint32_t>(max_data_length, op.file_size - payload->offset);
+    _call_op_progress_callback(op);
+
+    if (++upload.acks_since_loss >= upload.window) {
+        upload.acks_since_loss = 0;
+        upload.window = std::min(upload.window + 1, upload_max_window);
+    }
+
+    _fill_upload_window(op);
 }
 
-void FtpImpl::_terminate_session()
+void FtpImpl::_terminate_session(ClientOp& op)
 {
-    if (!_session_valid) {
+    if (!op.session_valid) {
         return;
     }
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
-    payload->session = _session;
-    payload->opcode = _curr_op = CMD_TERMINATE_SESSION;
+    payload->session = op.session;
+    payload->opcode = op.opcode = CMD_TERMINATE_SESSION;
     payload->offset = 0;
     payload->size = 0;
-    _send_mavlink_ftp_message(raw_payload);
+    _send_mavlink_ftp_message(op, raw_payload);
 }
 
 std::pair<Ftp::Result, std::vector<std::string>> FtpImpl::list_directory(const std::string& path)
@@ -473,62 +784,63 @@ std::pair<Ftp::Result, std::vector<std::string>> FtpImpl::list_directory(const s
 void FtpImpl::list_directory_async(
     const std::string& path, Ftp::ListDirectoryCallback callback, uint32_t offset)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE && offset == 0) {
-        callback(Ftp::Result::Busy, std::vector<std::string>());
-        return;
-    }
     if (path.length() >= max_data_length) {
         callback(Ftp::Result::InvalidParameter, std::vector<std::string>());
         return;
     }
 
-    _last_path = path;
-    // TODOTODO
-    _curr_dir_items_result_callback = callback;
-    _list_directory(offset);
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::make_unique<ClientOp>());
+    if (op == nullptr) {
+        callback(Ftp::Result::Busy, std::vector<std::string>());
+        return;
+    }
+
+    op->path = path;
+    op->dir_items_result_callback = callback;
+    _list_directory(*op, offset);
 }
 
-void FtpImpl::_list_directory(uint32_t offset)
+void FtpImpl::_list_directory(ClientOp& op, uint32_t offset)
 {
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
     payload->session = 0;
-    payload->opcode = _curr_op = CMD_LIST_DIRECTORY;
+    payload->opcode = op.opcode = CMD_LIST_DIRECTORY;
     payload->offset = offset;
-    strncpy(reinterpret_cast<char*>(payload->data), _last_path.c_str(), max_data_length - 1);
-    payload->size = _last_path.length() + 1;
+    strncpy(reinterpret_cast<char*>(payload->data), op.path.c_str(), max_data_length - 1);
+    payload->size = op.path.length() + 1;
 
-    if (offset == 0) {
-        _curr_directory_list.clear();
-    }
-    _send_mavlink_ftp_message(raw_payload);
+    _send_mavlink_ftp_message(op, raw_payload);
 }
 
 void FtpImpl::_generic_command_async(
     Opcode opcode, uint32_t offset, const std::string& path, Ftp::ResultCallback callback)
 {
-    if (_curr_op != CMD_NONE) {
-        callback(Ftp::Result::Busy);
-        return;
-    }
     if (path.length() >= max_data_length) {
         callback(Ftp::Result::InvalidParameter);
         return;
     }
 
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::make_unique<ClientOp>());
+    if (op == nullptr) {
+        callback(Ftp::Result::Busy);
+        return;
+    }
+
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
     payload->session = 0;
-    payload->opcode = _curr_op = opcode;
+    payload->opcode = op->opcode = opcode;
     payload->offset = offset;
     strncpy(reinterpret_cast<char*>(payload->data), path.c_str(), max_data_length - 1);
     payload->size = path.length() + 1;
 
-    _curr_op_result_callback = callback;
-    _send_mavlink_ftp_message(raw_payload);
+    op->result_callback = callback;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
 Ftp::Result FtpImpl::create_directory(const std::string& path)
@@ -543,7 +855,6 @@ Ftp::Result FtpImpl::create_directory(const std::string& path)
 
 void FtpImpl::create_directory_async(const std::string& path, Ftp::ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
     _generic_command_async(CMD_CREATE_DIRECTORY, 0, path, callback);
 }
 
@@ -559,7 +870,6 @@ Ftp::Result FtpImpl::remove_directory(const std::string& path)
 
 void FtpImpl::remove_directory_async(const std::string& path, Ftp::ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
     _generic_command_async(CMD_REMOVE_DIRECTORY, 0, path, callback);
 }
 
@@ -575,7 +885,6 @@ Ftp::Result FtpImpl::remove_file(const std::string& path)
 
 void FtpImpl::remove_file_async(const std::string& path, Ftp::ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
     _generic_command_async(CMD_REMOVE_FILE, 0, path, callback);
 }
 
@@ -592,21 +901,23 @@ Ftp::Result FtpImpl::rename(const std::string& from_path, const std::string& to_
 void FtpImpl::rename_async(
     const std::string& from_path, const std::string& to_path, Ftp::ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE) {
-        callback(Ftp::Result::Busy);
-        return;
-    }
     if (from_path.length() + to_path.length() + 1 >= max_data_length) {
         callback(Ftp::Result::InvalidParameter);
         return;
     }
 
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::make_unique<ClientOp>());
+    if (op == nullptr) {
+        callback(Ftp::Result::Busy);
+        return;
+    }
+
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
     payload->session = 0;
-    payload->opcode = _curr_op = CMD_RENAME;
+    payload->opcode = op->opcode = CMD_RENAME;
     payload->offset = 0;
     strncpy(reinterpret_cast<char*>(&payload->data[0]), from_path.c_str(), max_data_length - 1);
     payload->size = from_path.length() + 1;
@@ -615,8 +926,8 @@ void FtpImpl::rename_async(
         to_path.c_str(),
         max_data_length - payload->size);
     payload->size += to_path.length() + 1;
-    _curr_op_result_callback = callback;
-    _send_mavlink_ftp_message(raw_payload);
+    op->result_callback = callback;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
 std::pair<Ftp::Result, bool>
@@ -668,88 +979,111 @@ void FtpImpl::are_files_identical_async(
 
 void FtpImpl::_calc_file_crc32_async(const std::string& path, file_crc32_ResultCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_curr_op_mutex);
-    if (_curr_op != CMD_NONE) {
-        callback(Ftp::Result::Busy, 0);
-        return;
-    }
     if (path.length() >= max_data_length) {
         callback(Ftp::Result::InvalidParameter, 0);
         return;
     }
 
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+    ClientOp* op = _add_client_op(std::make_unique<ClientOp>());
+    if (op == nullptr) {
+        callback(Ftp::Result::Busy, 0);
+        return;
+    }
+
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
     payload->session = 0;
-    payload->opcode = _curr_op = CMD_CALC_FILE_CRC32;
+    payload->opcode = op->opcode = CMD_CALC_FILE_CRC32;
     payload->offset = 0;
     strncpy(reinterpret_cast<char*>(payload->data), path.c_str(), max_data_length - 1);
     payload->size = path.length() + 1;
-    _current_crc32_result_callback = callback;
-    _send_mavlink_ftp_message(raw_payload);
+    op->crc32_result_callback = callback;
+    _send_mavlink_ftp_message(*op, raw_payload);
 }
 
-void FtpImpl::_send_mavlink_ftp_message(uint8_t* raw_payload)
+void FtpImpl::_send_mavlink_ftp_message(ClientOp& op, uint8_t* raw_payload, bool is_retry)
 {
+    // Needs to be called with _client_ops_mutex locked.
+    op.last_seq_number = reinterpret_cast<PayloadHeader*>(raw_payload)->seq_number;
+
     mavlink_msg_file_transfer_protocol_pack(
         _parent->get_own_system_id(),
         _parent->get_own_component_id(),
-        &_last_command,
+        &op.last_command,
         _network_id,
         _parent->get_system_id(),
         _get_target_component_id(),
         raw_payload);
-    _parent->send_message(_last_command);
+    _parent->send_message(op.last_command);
 
-    _reset_timer();
-    std::lock_guard<std::mutex> lock(_timer_mutex);
-    if (!_last_command_timer_running) {
-        _last_command_timer_running = true;
-        _parent->register_timeout_handler(
-            std::bind(&FtpImpl::_command_timeout, this),
-            static_cast<double>(_last_command_timeout) / 1000.0,
-            &_last_command_timeout_cookie);
+    if (is_retry) {
+        // The timeout is taken care of by _command_timeout().
+        return;
     }
+
+    _reset_timer(op);
+    _start_timer(op);
 }
 
-void FtpImpl::_command_timeout()
+void FtpImpl::_command_timeout(uint32_t op_id)
 {
-    if (_last_command_retries >= _max_last_command_retries) {
-        LogErr() << "Response timeout " << _curr_op;
-        _timer_mutex.lock();
-        _last_command_timer_running = false;
-        _session_result = ServerResult::ERR_TIMEOUT;
-        _session_valid = false;
-        _timer_mutex.unlock();
-        _process_nak(ServerResult::ERR_TIMEOUT);
+    std::lock_guard<std::mutex> lock(_client_ops_mutex);
+
+    ClientOp* op = _find_client_op(op_id);
+    if (op == nullptr) {
+        return;
+    }
+
+    // The timeout is gone once it has fired.
+    op->timer_running = false;
+
+    if (op->retries >= _max_last_command_retries) {
+        LogErr() << "Response timeout " << op->opcode;
+        op->session_result = ServerResult::ERR_TIMEOUT;
+        op->session_valid = false;
+        _process_nak(*op, ServerResult::ERR_TIMEOUT);
     } else {
-        _last_command_retries++;
-        LogWarn() << "Response timeout. Retry: " << _last_command_retries;
-        _parent->send_message(_last_command);
-        _parent->register_timeout_handler(
-            std::bind(&FtpImpl::_command_timeout, this),
-            static_cast<double>(_last_command_timeout) / 1000.0,
-            &_last_command_timeout_cookie);
+        op->retries++;
+        LogWarn() << "Response timeout. Retry: " << op->retries;
+        if (!_resend_requests(*op)) {
+            _parent->send_message(op->last_command);
+        }
+        _start_timer(*op);
     }
+
+    _remove_finished_client_ops();
 }
 
-void FtpImpl::_reset_timer()
+void FtpImpl::_start_timer(ClientOp& op)
 {
-    _parent->refresh_timeout_handler(_last_command_timeout_cookie);
-    _last_command_retries = 0;
+    if (op.timer_running) {
+        return;
+    }
+    op.timer_running = true;
+    op.timeout_s = (op.retries == 0) ?
+                       _parent->rtt_estimator().timeout_s(_default_command_timeout_s) :
+                       RttEstimator::backed_off_s(op.timeout_s);
+    _parent->register_timeout_handler(
+        std::bind(&FtpImpl::_command_timeout, this, op.id), op.timeout_s, &op.timeout_cookie);
 }
 
-void FtpImpl::_stop_timer()
+void FtpImpl::_reset_timer(ClientOp& op)
 {
-    {
-        std::lock_guard<std::mutex> lock(_timer_mutex);
-        if (!_last_command_timer_running) {
-            return;
-        }
-        _last_command_timer_running = false;
+    if (op.timer_running) {
+        _parent->refresh_timeout_handler(op.timeout_cookie);
+    }
+    op.retries = 0;
+}
+
+void FtpImpl::_stop_timer(ClientOp& op)
+{
+    if (!op.timer_running) {
+        return;
     }
-    _parent->unregister_timeout_handler(_last_command_timeout_cookie);
+    op.timer_running = false;
+    _parent->unregister_timeout_handler(op.timeout_cookie);
 }
 
 void FtpImpl::process_mavlink_ftp_message(const mavlink_message_t& msg)
@@ -781,13 +1115,15 @@ void FtpImpl::process_mavlink_ftp_message(const mavlink_message_t& msg)
         payload->seq_number;
         */
 
-        // check the sequence number: if this is a resent request, resend the last response
-        if (_last_reply_valid) {
-            if (payload->seq_number + 1 == _last_reply_seq) {
-                // This is the same request as the one we replied to last.
-                LogWarn() << "Wrong sequence - resend last response";
-                _parent->send_message(_last_reply);
-                return;
+        // check the sequence number: if this is a resent request, resend the response
+        if (payload->opcode != RSP_ACK && payload->opcode != RSP_NAK) {
+            for (auto& reply : _server_replies) {
+                if (reply.valid && payload->seq_number + 1 == reply.seq_number) {
+                    // This is the same request as one we replied to already.
+                    LogWarn() << "Wrong sequence - resend last response";
+                    _parent->send_message(reply.message);
+                    return;
+                }
             }
         }
 
@@ -909,28 +1245,28 @@ void FtpImpl::process_mavlink_ftp_message(const mavlink_message_t& msg)
         }
     }
 
-    _last_reply_valid = false;
-
     // Stream download replies are sent through mavlink stream mechanism. Unless we need to Nack.
     if (!stream_send || error_code != ServerResult::SUCCESS) {
-        // keep a copy of the last sent response ((n)ack), so that if it gets lost and the GCS
+        // keep a copy of the sent response ((n)ack), so that if it gets lost and the GCS
         // resends the request, we can simply resend the response.
-        _last_reply_valid = true;
-        _last_reply_seq = payload->seq_number;
+        ServerReply& reply = _server_replies[_next_server_reply];
+        _next_server_reply = (_next_server_reply + 1) % _server_replies.size();
+        reply.valid = true;
+        reply.seq_number = payload->seq_number;
         mavlink_msg_file_transfer_protocol_pack(
             _parent->get_own_system_id(),
             _parent->get_own_component_id(),
-            &_last_reply,
+            &reply.message,
             _network_id,
             _parent->get_system_id(),
             _get_target_component_id(),
             reinterpret_cast<const uint8_t*>(payload));
-        _parent->send_message(_last_reply);
+        _parent->send_message(reply.message);
+    } else {
+        _send_stream(payload->session);
     }
 }
 
-/// @brief Guarantees that the payload data is null terminated.
-/// @return Returns payload data as a std string
 std::string FtpImpl::_data_as_string(PayloadHeader* payload)
 {
     // guarantee null termination
@@ -1031,9 +1367,68 @@ FtpImpl::ServerResult FtpImpl::_work_list(PayloadHeader* payload, bool list_hidd
     return error_code;
 }
 
+FtpImpl::SessionInfo* FtpImpl::_get_server_session(uint8_t session)
+{
+    if (session >= _server_sessions.size() || _server_sessions[session].fd < 0) {
+        return nullptr;
+    }
+    return &_server_sessions[session];
+}
+
+void FtpImpl::_close_server_session(SessionInfo& session_info)
+{
+    close(session_info.fd);
+    session_info.fd = -1;
+    session_info.stream_download = false;
+    // Give the memory back, sessions are mostly idle.
+    std::vector<uint8_t>().swap(session_info.prefetch);
+}
+
+int FtpImpl::_read_server_session(SessionInfo& session_info, uint32_t offset, uint8_t* data)
+{
+    const uint32_t prefetch_end =
+        session_info.prefetch_offset + static_cast<uint32_t>(session_info.prefetch.size());
+    const uint32_t chunk_end = std::min<uint32_t>(offset + max_data_length, session_info.file_size);
+
+    // Chunks are mostly asked for in order, so reading ahead a lot at once saves a read for
+    // nearly every one of them.
+    if (offset < session_info.prefetch_offset || chunk_end > prefetch_end) {
+        session_info.prefetch.resize(server_prefetch_size);
+#if defined(WINDOWS)
+        if (lseek(session_info.fd, offset, SEEK_SET) < 0) {
+            session_info.prefetch.clear();
+            return -1;
+        }
+        const int bytes_read = ::read(
+            session_info.fd,
+            session_info.prefetch.data(),
+            static_cast<unsigned>(session_info.prefetch.size()));
+#else
+        const auto bytes_read = ::pread(
+            session_info.fd, session_info.prefetch.data(), session_info.prefetch.size(), offset);
+#endif
+        if (bytes_read < 0) {
+            session_info.prefetch.clear();
+            return -1;
+        }
+        session_info.prefetch.resize(static_cast<std::size_t>(bytes_read));
+        session_info.prefetch_offset = offset;
+    }
+
+    const uint32_t start = offset - session_info.prefetch_offset;
+    const auto length =
+        std::min<std::size_t>(max_data_length, session_info.prefetch.size() - start);
+    memcpy(data, session_info.prefetch.data() + start, length);
+    return static_cast<int>(length);
+}
+
 FtpImpl::ServerResult FtpImpl::_work_open(PayloadHeader* payload, int oflag)
 {
-    if (_session_info.fd >= 0) {
+    const auto free_session = std::find_if(
+        _server_sessions.begin(), _server_sessions.end(), [](const SessionInfo& session_info) {
+            return session_info.fd < 0;
+        });
+    if (free_session == _server_sessions.end()) {
         return ServerResult::ERR_NO_SESSIONS_AVAILABLE;
     }
 
@@ -1062,11 +1457,13 @@ FtpImpl::ServerResult FtpImpl::_work_open(PayloadHeader* payload, int oflag)
                                    ServerResult::ERR_FAIL;
     }
 
-    _session_info.fd = fd;
-    _session_info.file_size = file_size;
-    _session_info.stream_download = false;
+    free_session->fd = fd;
+    free_session->file_size = file_size;
+    free_session->stream_download = false;
+    free_session->prefetch.clear();
+    free_session->prefetch_offset = 0;
 
-    payload->session = 0;
+    payload->session = static_cast<uint8_t>(free_session - _server_sessions.begin());
     payload->size = sizeof(uint32_t);
     memcpy(payload->data, &file_size, payload->size);
 
@@ -1075,20 +1472,17 @@ FtpImpl::ServerResult FtpImpl::_work_open(PayloadHeader* payload, int oflag)
 
 FtpImpl::ServerResult FtpImpl::_work_read(PayloadHeader* payload)
 {
-    if (payload->session != 0 || _session_info.fd < 0) {
+    SessionInfo* session_info = _get_server_session(payload->session);
+    if (session_info == nullptr) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
     // We have to test seek past EOF ourselves, lseek will allow seek past EOF
-    if (payload->offset >= _session_info.file_size) {
+    if (payload->offset >= session_info->file_size) {
         return ServerResult::ERR_EOF;
     }
 
-    if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-        return ServerResult::ERR_FAIL;
-    }
-
-    int bytes_read = ::read(_session_info.fd, &payload->data[0], max_data_length);
+    int bytes_read = _read_server_session(*session_info, payload->offset, &payload->data[0]);
 
     if (bytes_read < 0) {
         // Negative return indicates error other than eof
@@ -1102,32 +1496,37 @@ FtpImpl::ServerResult FtpImpl::_work_read(PayloadHeader* payload)
 
 FtpImpl::ServerResult FtpImpl::_work_burst(PayloadHeader* payload)
 {
-    if (payload->session != 0 && _session_info.fd < 0) {
+    SessionInfo* session_info = _get_server_session(payload->session);
+    if (session_info == nullptr) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
     // Setup for streaming sends
-    _session_info.stream_download = true;
-    _session_info.stream_offset = payload->offset;
-    _session_info.stream_chunk_transmitted = 0;
-    _session_info.stream_seq_number = payload->seq_number + 1;
-    _session_info.stream_target_system_id = _parent->get_system_id();
+    session_info->stream_download = true;
+    session_info->stream_offset = payload->offset;
+    session_info->stream_chunk_transmitted = 0;
+    session_info->stream_seq_number = payload->seq_number + 1;
+    session_info->stream_target_system_id = _parent->get_system_id();
 
     return ServerResult::SUCCESS;
 }
 
 FtpImpl::ServerResult FtpImpl::_work_write(PayloadHeader* payload)
 {
-    if (payload->session != 0 && _session_info.fd < 0) {
+    SessionInfo* session_info = _get_server_session(payload->session);
+    if (session_info == nullptr) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
-    if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+    // What was read ahead might be overwritten.
+    session_info->prefetch.clear();
+
+    if (lseek(session_info->fd, payload->offset, SEEK_SET) < 0) {
         // Unable to see to the specified location
         return ServerResult::ERR_FAIL;
     }
 
-    int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
+    int bytes_written = ::write(session_info->fd, &payload->data[0], payload->size);
 
     if (bytes_written < 0) {
         // Negative return indicates error other than eof
@@ -1142,13 +1541,12 @@ FtpImpl::ServerResult FtpImpl::_work_write(PayloadHeader* payload)
 
 FtpImpl::ServerResult FtpImpl::_work_terminate(PayloadHeader* payload)
 {
-    if (payload->session != 0 || _session_info.fd < 0) {
+    SessionInfo* session_info = _get_server_session(payload->session);
+    if (session_info == nullptr) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
-    close(_session_info.fd);
-    _session_info.fd = -1;
-    _session_info.stream_download = false;
+    _close_server_session(*session_info);
 
     payload->size = 0;
 
@@ -1157,10 +1555,10 @@ FtpImpl::ServerResult FtpImpl::_work_terminate(PayloadHeader* payload)
 
 FtpImpl::ServerResult FtpImpl::_work_reset(PayloadHeader* payload)
 {
-    if (_session_info.fd != -1) {
-        close(_session_info.fd);
-        _session_info.fd = -1;
-        _session_info.stream_download = false;
+    for (auto& session_info : _server_sessions) {
+        if (session_info.fd != -1) {
+            _close_server_session(session_info);
+        }
     }
 
     payload->size = 0;
@@ -1260,12 +1658,13 @@ Ftp::Result FtpImpl::_calc_local_file_crc32(const std::string& path, uint32_t& c
         return Ftp::Result::FileIoError;
     }
 
-    // Read whole file in buffer size chunks
+    // Read whole file in large chunks, so that the checksum and not the syscalls take the time.
+    // A short read is not the end of the file, only a read of 0 is.
     Crc32 checksum;
-    char buffer[18392];
+    std::vector<uint8_t> buffer(crc32_read_size);
     ssize_t bytes_read;
     do {
-        bytes_read = ::read(fd, buffer, sizeof(buffer));
+        bytes_read = ::read(fd, buffer.data(), buffer.size());
 
         if (bytes_read < 0) {
             int r_errno = errno;
@@ -1274,8 +1673,8 @@ Ftp::Result FtpImpl::_calc_local_file_crc32(const std::string& path, uint32_t& c
             return Ftp::Result::FileIoError;
         }
 
-        checksum.add((uint8_t*)buffer, bytes_read);
-    } while (bytes_read == sizeof(buffer));
+        checksum.add(buffer.data(), static_cast<uint32_t>(bytes_read));
+    } while (bytes_read > 0);
 
     close(fd);
 
@@ -1309,10 +1708,73 @@ FtpImpl::ServerResult FtpImpl::_work_calc_file_CRC32(PayloadHeader* payload)
 
 void FtpImpl::send()
 {
+    for (std::size_t session = 0; session < _server_sessions.size(); ++session) {
+        _send_stream(static_cast<uint8_t>(session));
+    }
+}
+
+void FtpImpl::_send_stream(uint8_t session)
+{
+    SessionInfo* session_info = _get_server_session(session);
+
     // Anything to stream?
-    if (!_session_info.stream_download) {
+    if (session_info == nullptr || !session_info->stream_download) {
         return;
     }
+
+    uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
+    PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
+
+    while (session_info->stream_download) {
+        payload->seq_number = session_info->stream_seq_number++;
+        payload->session = session;
+        payload->req_opcode = CMD_BURST_READ_FILE;
+        payload->burst_complete = 0;
+        payload->padding = 0;
+        payload->offset = session_info->stream_offset;
+
+        ServerResult result = ServerResult::SUCCESS;
+        int bytes_read = 0;
+        if (session_info->stream_offset >= session_info->file_size) {
+            result = ServerResult::ERR_EOF;
+        } else {
+            bytes_read = _read_server_session(
+                *session_info, session_info->stream_offset, &payload->data[0]);
+            if (bytes_read < 0) {
+                result = ServerResult::ERR_FAIL;
+            }
+        }
+
+        if (result != ServerResult::SUCCESS) {
+            // The client knows from the NAK that there is nothing more to come.
+            payload->opcode = RSP_NAK;
+            payload->size = 1;
+            *reinterpret_cast<ServerResult*>(payload->data) = result;
+            session_info->stream_download = false;
+        } else {
+            payload->opcode = RSP_ACK;
+            payload->size = static_cast<uint8_t>(bytes_read);
+            session_info->stream_offset += bytes_read;
+            ++session_info->stream_chunk_transmitted;
+
+            if (session_info->stream_chunk_transmitted >= burst_max_chunks ||
+                session_info->stream_offset >= session_info->file_size) {
+                payload->burst_complete = 1;
+                session_info->stream_download = false;
+            }
+        }
+
+        mavlink_message_t message;
+        mavlink_msg_file_transfer_protocol_pack(
+            _parent->get_own_system_id(),
+            _parent->get_own_component_id(),
+            &message,
+            _network_id,
+            session_info->stream_target_system_id,
+            _get_target_component_id(),
+            raw_payload);
+        _parent->send_message(message);
+    }
 }
 
 } // namespace mavsdk
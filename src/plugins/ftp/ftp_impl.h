@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "mavlink_include.h"
 #include "plugins/ftp/ftp.h"
@@ -151,71 +154,147 @@ private:
         uint16_t stream_seq_number{0};
         uint8_t stream_target_system_id{0};
         unsigned stream_chunk_transmitted{0};
+        std::vector<uint8_t> prefetch{}; ///< Content of the file from prefetch_offset on
+        uint32_t prefetch_offset{0};
     };
 
+    /// @brief Bytes the server reads from a file at once, to serve the chunks from memory.
+    static constexpr std::size_t server_prefetch_size = 64 * 1024;
+
+    /// @brief Bytes read from a local file at once to calculate its CRC32.
+    static constexpr std::size_t crc32_read_size = 256 * 1024;
+
     struct OfstreamWithPath {
         std::ofstream stream;
         std::string path;
     };
 
-    struct SessionInfo _session_info {}; ///< Session info, fd=-1 for no active session
+    /// @brief Downloads are requested in bursts. Chunks of max_data_length bytes which get
+    /// lost on the way are requested again one by one, with a window of reads in flight.
+    struct DownloadState {
+        std::vector<bool> chunk_received{};
+        uint32_t chunks_missing{0};
+        uint32_t first_missing_chunk{0};
+        uint32_t received_up_to{0}; ///< End of the furthest chunk received
+        std::vector<uint32_t> reads_in_flight{}; ///< Chunks requested with CMD_READ_FILE
+    };
+
+    /// @brief Reads in flight when requesting chunks lost during a burst.
+    static constexpr std::size_t download_read_window = 8;
+
+    /// @brief Chunks the server sends per burst before setting burst_complete.
+    static constexpr unsigned burst_max_chunks = 64;
+
+    static constexpr std::size_t upload_initial_window = 4;
+    static constexpr std::size_t upload_max_window = 16;
+
+    /// @brief Uploads keep a window of writes in flight, at distinct offsets. The window
+    /// shrinks by half on a timeout and grows by one after a window of ACKs without loss.
+    struct UploadState {
+        uint32_t next_offset{0}; ///< Offset of the next chunk not sent yet
+        std::vector<uint32_t> writes_in_flight{}; ///< Offsets of writes not acked yet
+        std::size_t window{upload_initial_window};
+        std::size_t acks_since_loss{0};
+    };
+
+    /// @brief State of one operation of the client. Operations run concurrently, each with
+    /// its own session on the server, its own files and its own timeout.
+    struct ClientOp {
+        uint32_t id{0};
+        Opcode opcode{CMD_NONE}; ///< Request in progress, CMD_NONE once the operation is done
+        uint16_t last_seq_number{0}; ///< Replies come with this plus 1
+        mavlink_message_t last_command{};
+        void* timeout_cookie{nullptr};
+        bool timer_running{false};
+        uint32_t retries{0};
+        double timeout_s{0.0}; ///< Of the last request sent, doubled for every retry
+        std::string path{};
+        std::ifstream ifstream{};
+        OfstreamWithPath ofstream{};
+        DownloadState download{};
+        UploadState upload{};
+        bool session_valid{false};
+        uint8_t session{0};
+        ServerResult session_result{ServerResult::SUCCESS};
+        uint32_t bytes_transferred{0};
+        uint32_t file_size{0};
+        std::vector<std::string> directory_list{};
+
+        Ftp::ResultCallback result_callback{};
+        // progress_callback is used for download_callback_t as well as upload_callback_t
+        Ftp::DownloadCallback progress_callback{};
+        Ftp::ListDirectoryCallback dir_items_result_callback{};
+        file_crc32_ResultCallback crc32_result_callback{};
+    };
+
+    static_assert(
+        std::is_same<Ftp::DownloadCallback, Ftp::UploadCallback>::value,
+        "callback types don't match");
+
+    /// @brief Operations of the client running at the same time, beyond that it's busy.
+    static constexpr std::size_t max_client_ops = 8;
+
+    /// @brief Sessions the server can have open at the same time.
+    static constexpr std::size_t max_server_sessions = 4;
+
+    /// @brief Replies the server keeps, to send them again when a request is repeated.
+    static constexpr std::size_t server_reply_cache_size = 8;
+
+    struct ServerReply {
+        bool valid{false};
+        uint16_t seq_number{0};
+        mavlink_message_t message{};
+    };
+
+    std::array<SessionInfo, max_server_sessions> _server_sessions{};
+    std::array<ServerReply, server_reply_cache_size> _server_replies{};
+    std::size_t _next_server_reply{0};
 
     uint8_t _network_id = 0;
     uint8_t _target_component_id = 0;
     bool _target_component_id_set{false};
-    Opcode _curr_op = CMD_NONE;
-    std::mutex _curr_op_mutex{};
-    mavlink_message_t _last_command{};
-    void* _last_command_timeout_cookie = nullptr;
-    bool _last_command_timer_running{false};
-    std::mutex _timer_mutex{};
-    static constexpr uint32_t _last_command_timeout{200};
+    std::vector<std::unique_ptr<ClientOp>> _client_ops{};
+    std::mutex _client_ops_mutex{};
+    uint32_t _next_client_op_id{1};
+    static constexpr double _default_command_timeout_s{0.2};
     uint32_t _max_last_command_retries{5};
-    uint32_t _last_command_retries = 0;
-    std::string _last_path{};
     uint16_t _seq_number = 0;
-    std::ifstream _ifstream{};
-    OfstreamWithPath _ofstream{};
-    bool _session_valid = false;
-    uint8_t _session = 0;
-    ServerResult _session_result = ServerResult::SUCCESS;
-    uint32_t _bytes_transferred = 0;
-    uint32_t _file_size = 0;
-    std::vector<std::string> _curr_directory_list{};
-
-    Ftp::ResultCallback _curr_op_result_callback{};
-    // _curr_op_progress_callback is used for download_callback_t as well as upload_callback_t
-    static_assert(
-        std::is_same<Ftp::DownloadCallback, Ftp::UploadCallback>::value,
-        "callback types don't match");
-    Ftp::DownloadCallback _curr_op_progress_callback{};
-    Ftp::ListDirectoryCallback _curr_dir_items_result_callback{};
-
-    file_crc32_ResultCallback _current_crc32_result_callback{};
 
     void _calc_file_crc32_async(const std::string& path, file_crc32_ResultCallback callback);
     Ftp::Result _calc_local_file_crc32(const std::string& path, uint32_t& csum);
 
+    ClientOp* _add_client_op(std::unique_ptr<ClientOp> op);
+    ClientOp* _find_client_op(const PayloadHeader& payload);
+    ClientOp* _find_client_op(uint32_t id);
+    void _remove_finished_client_ops();
     void _process_ack(PayloadHeader* payload);
     void _process_nak(PayloadHeader* payload);
-    void _process_nak(ServerResult result);
+    void _process_nak(ClientOp& op, ServerResult result);
     static Ftp::Result _translate(ServerResult result);
-    void _call_op_result_callback(ServerResult result);
-    void _call_op_progress_callback(uint32_t bytes_written, uint32_t total_bytes);
-    void _call_dir_items_result_callback(ServerResult result, std::vector<std::string> list);
-    void _call_crc32_result_callback(ServerResult result, uint32_t crc32);
+    void _call_op_result_callback(const ClientOp& op, ServerResult result);
+    void _call_op_progress_callback(const ClientOp& op);
+    void _call_dir_items_result_callback(const ClientOp& op, ServerResult result);
+    void _call_crc32_result_callback(const ClientOp& op, ServerResult result, uint32_t crc32);
     void _generic_command_async(
         Opcode opcode, uint32_t offset, const std::string& path, Ftp::ResultCallback callback);
-    void _read();
-    void _write();
-    void _end_read_session(bool delete_file = false);
-    void _end_write_session();
-    void _terminate_session();
-    void _send_mavlink_ftp_message(uint8_t* raw_payload);
-    void _command_timeout();
-    void _reset_timer();
-    void _stop_timer();
-    void _list_directory(uint32_t offset);
+    void _request_burst(ClientOp& op, bool is_retry = false);
+    void _request_missing_chunks(ClientOp& op, bool is_retry = false);
+    void _continue_download(ClientOp& op);
+    void _process_download_ack(ClientOp& op, PayloadHeader* payload);
+    bool _write_downloaded_chunk(ClientOp& op, PayloadHeader* payload);
+    bool _resend_requests(ClientOp& op);
+    void _fill_upload_window(ClientOp& op);
+    bool _send_write(ClientOp& op, uint32_t offset, bool is_retry = false);
+    void _process_upload_ack(ClientOp& op, PayloadHeader* payload);
+    void _end_read_session(ClientOp& op, bool delete_file = false);
+    void _end_write_session(ClientOp& op);
+    void _terminate_session(ClientOp& op);
+    void _send_mavlink_ftp_message(ClientOp& op, uint8_t* raw_payload, bool is_retry = false);
+    void _command_timeout(uint32_t op_id);
+    void _start_timer(ClientOp& op);
+    void _reset_timer(ClientOp& op);
+    void _stop_timer(ClientOp& op);
+    void _list_directory(ClientOp& op, uint32_t offset);
     uint8_t _get_target_component_id()
     {
         return _target_component_id_set ? _target_component_id : _parent->get_autopilot_id();
@@ -224,10 +303,6 @@ private:
     // prepend a root directory to each file/dir access to avoid enumerating the full FS tree
     std::string _root_dir{"/"};
 
-    bool _last_reply_valid = false;
-    uint16_t _last_reply_seq = 0;
-    mavlink_message_t _last_reply{};
-
     void process_mavlink_ftp_message(const mavlink_message_t& msg);
 
     std::string _data_as_string(PayloadHeader* payload);
@@ -247,6 +322,10 @@ private:
     ServerResult _work_remove_file(PayloadHeader* payload);
     ServerResult _work_rename(PayloadHeader* payload);
     ServerResult _work_calc_file_CRC32(PayloadHeader* payload);
+    SessionInfo* _get_server_session(uint8_t session);
+    static void _close_server_session(SessionInfo& session_info);
+    static int _read_server_session(SessionInfo& session_info, uint32_t offset, uint8_t* data);
+    void _send_stream(uint8_t session);
 };
 
 } // namespace mavsdk
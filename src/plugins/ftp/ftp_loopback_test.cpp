@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "fs.h"
+#include "mavsdk.h"
+#include "plugins/ftp/ftp.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
+
+using namespace mavsdk;
+
+// A client and a server in the same process, connected over UDP on localhost. The link
+// is made lossy by dropping messages as they arrive at the client.
+
+namespace {
+
+// Offsets and opcodes of the payload of FILE_TRANSFER_PROTOCOL, as given by the protocol.
+constexpr uint8_t CMD_READ_FILE = 5;
+constexpr uint8_t CMD_WRITE_FILE = 7;
+constexpr uint8_t CMD_BURST_READ_FILE = 15;
+constexpr uint8_t RSP_ACK = 128;
+constexpr uint32_t CHUNK_SIZE = 239;
+
+struct FtpHeader {
+    uint8_t opcode{0};
+    uint8_t req_opcode{0};
+    uint32_t offset{0};
+};
+
+FtpHeader decode_header(const mavlink_message_t& message)
+{
+    mavlink_file_transfer_protocol_t ftp;
+    mavlink_msg_file_transfer_protocol_decode(&message, &ftp);
+
+    FtpHeader header;
+    header.opcode = ftp.payload[3];
+    header.req_opcode = ftp.payload[5];
+    std::memcpy(&header.offset, &ftp.payload[8], sizeof(header.offset));
+    return header;
+}
+
+bool is_ftp(const mavlink_message_t& message)
+{
+    return message.msgid == MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL;
+}
+
+void create_random_file(const std::string& path, std::size_t size, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::string content(size, '\0');
+    for (auto& c : content) {
+        c = static_cast<char>(generator() & 0xff);
+    }
+    std::ofstream file(path, std::fstream::trunc | std::fstream::binary);
+    file << content;
+}
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream file(path, std::fstream::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::future<Ftp::Result>
+download(Ftp& ftp, const std::string& remote_file_path, const std::string& local_dir)
+{
+    auto prom = std::make_shared<std::promise<Ftp::Result>>();
+    auto future_result = prom->get_future();
+    ftp.download_async(remote_file_path, local_dir, [prom](Ftp::Result result, Ftp::ProgressData) {
+        if (result != Ftp::Result::Next) {
+            prom->set_value(result);
+        }
+    });
+    return future_result;
+}
+
+std::future<Ftp::Result>
+upload(Ftp& ftp, const std::string& local_file_path, const std::string& remote_dir)
+{
+    auto prom = std::make_shared<std::promise<Ftp::Result>>();
+    auto future_result = prom->get_future();
+    ftp.upload_async(local_file_path, remote_dir, [prom](Ftp::Result result, Ftp::ProgressData) {
+        if (result != Ftp::Result::Next) {
+            prom->set_value(result);
+        }
+    });
+    return future_result;
+}
+
+Ftp::Result wait_for(std::future<Ftp::Result>& future_result)
+{
+    if (future_result.wait_for(std::chrono::seconds(20)) != std::future_status::ready) {
+        return Ftp::Result::Timeout;
+    }
+    return future_result.get();
+}
+
+class FtpLoopback : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        fs_create_directory(_test_dir);
+        fs_create_directory(_server_dir);
+        fs_create_directory(_client_dir);
+    }
+
+    void TearDown() override
+    {
+        for (const auto& path : _created_files) {
+            fs_remove(path);
+        }
+    }
+
+    void connect()
+    {
+        auto prom = std::make_shared<std::promise<void>>();
+        auto future_result = prom->get_future();
+        auto connected = std::make_shared<bool>(false);
+        _mavsdk_client.subscribe_on_new_system([this, prom, connected]() {
+            if (!*connected && _mavsdk_client.systems().at(0)->is_connected()) {
+                *connected = true;
+                prom->set_value();
+            }
+        });
+
+        // Tests may run in parallel, so the client takes the first port nobody else is bound to.
+        int port = 0;
+        for (int candidate = 14620; candidate < 14720 && port == 0; ++candidate) {
+            if (_mavsdk_client.add_udp_connection(candidate) == ConnectionResult::Success) {
+                port = candidate;
+            }
+        }
+        ASSERT_NE(port, 0);
+
+        Mavsdk::Configuration configuration(Mavsdk::Configuration::UsageType::CompanionComputer);
+        _mavsdk_server.set_configuration(configuration);
+        ASSERT_EQ(_mavsdk_server.setup_udp_remote("127.0.0.1", port), ConnectionResult::Success);
+
+        _ftp_server = std::make_shared<Ftp>(_mavsdk_server.systems().at(0));
+        ASSERT_EQ(_ftp_server->set_root_directory(_server_dir), Ftp::Result::Success);
+
+        ASSERT_EQ(future_result.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        _mavsdk_client.subscribe_on_new_system(nullptr);
+
+        auto system = _mavsdk_client.systems().at(0);
+        _ftp_client = std::make_shared<Ftp>(system);
+        _ftp_client->set_target_compid(_ftp_server->get_our_compid());
+        _mavlink_passthrough = std::make_shared<MavlinkPassthrough>(system);
+    }
+
+    std::string server_file(const std::string& name, std::size_t size, unsigned seed)
+    {
+        const auto path = _server_dir + path_separator + name;
+        create_random_file(path, size, seed);
+        _created_files.push_back(path);
+        _created_files.push_back(_client_dir + path_separator + name);
+        return path;
+    }
+
+    std::string client_file(const std::string& name, std::size_t size, unsigned seed)
+    {
+        const auto path = _client_dir + path_separator + name;
+        create_random_file(path, size, seed);
+        _created_files.push_back(path);
+        _created_files.push_back(_server_dir + path_separator + name);
+        return path;
+    }
+
+    bool same_on_both_sides(const std::string& name) const
+    {
+        const auto on_server = read_file(_server_dir + path_separator + name);
+        return !on_server.empty() && on_server == read_file(_client_dir + path_separator + name);
+    }
+
+    const std::string _test_dir{"ftp_loopback_test"};
+    const std::string _server_dir{_test_dir + path_separator + "server"};
+    const std::string _client_dir{_test_dir + path_separator + "client"};
+    std::vector<std::string> _created_files{};
+
+    // Declared first, so that the plugins are gone before them.
+    Mavsdk _mavsdk_server{};
+    Mavsdk _mavsdk_client{};
+    std::shared_ptr<Ftp> _ftp_server{};
+    std::shared_ptr<Ftp> _ftp_client{};
+    std::shared_ptr<MavlinkPassthrough> _mavlink_passthrough{};
+};
+
+} // namespace
+
+TEST_F(FtpLoopback, DownloadsWhileListing)
+{
+    connect();
+    server_file("first.bin", 100000, 1);
+    server_file("second.bin", 50000, 2);
+
+    auto first = download(*_ftp_client, "/first.bin", _client_dir);
+    auto second = download(*_ftp_client, "/second.bin", _client_dir);
+
+    auto prom = std::make_shared<std::promise<std::pair<Ftp::Result, std::vector<std::string>>>>();
+    auto listed = prom->get_future();
+    _ftp_client->list_directory_async(
+        "/", [prom](Ftp::Result result, std::vector<std::string> list) {
+            prom->set_value(std::make_pair(result, list));
+        });
+
+    EXPECT_EQ(wait_for(first), Ftp::Result::Success);
+    EXPECT_EQ(wait_for(second), Ftp::Result::Success);
+    ASSERT_EQ(listed.wait_for(std::chrono::seconds(20)), std::future_status::ready);
+
+    const auto list = listed.get();
+    EXPECT_EQ(list.first, Ftp::Result::Success);
+    const auto lists = [&list](const std::string& name) {
+        return std::any_of(
+            list.second.begin(), list.second.end(), [&name](const std::string& entry) {
+                return entry.find(name) != std::string::npos;
+            });
+    };
+    EXPECT_TRUE(lists("first.bin"));
+    EXPECT_TRUE(lists("second.bin"));
+
+    EXPECT_TRUE(same_on_both_sides("first.bin"));
+    EXPECT_TRUE(same_on_both_sides("second.bin"));
+}
+
+TEST_F(FtpLoopback, DownloadsWithLostBurstChunks)
+{
+    connect();
+    server_file("burst.bin", 200000, 3);
+
+    struct Loss {
+        std::mutex mutex{};
+        std::set<uint32_t> dropped{};
+        unsigned reads_requested{0};
+    };
+    auto loss = std::make_shared<Loss>();
+
+    // Every fifth chunk of a burst is lost, but only the first time, as are the chunks
+    // completing a burst which happen to be among them.
+    _mavlink_passthrough->intercept_incoming_messages_async([loss](mavlink_message_t& message) {
+        if (!is_ftp(message)) {
+            return true;
+        }
+        const auto header = decode_header(message);
+        if (header.opcode != RSP_ACK || header.req_opcode != CMD_BURST_READ_FILE ||
+            (header.offset / CHUNK_SIZE) % 5 != 2) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(loss->mutex);
+        return !loss->dropped.insert(header.offset).second;
+    });
+
+    _mavlink_passthrough->intercept_outgoing_messages_async([loss](mavlink_message_t& message) {
+        if (is_ftp(message) && decode_header(message).opcode == CMD_READ_FILE) {
+            std::lock_guard<std::mutex> lock(loss->mutex);
+            ++loss->reads_requested;
+        }
+        return true;
+    });
+
+    auto result = download(*_ftp_client, "/burst.bin", _client_dir);
+    EXPECT_EQ(wait_for(result), Ftp::Result::Success);
+    EXPECT_TRUE(same_on_both_sides("burst.bin"));
+
+    std::lock_guard<std::mutex> lock(loss->mutex);
+    EXPECT_GT(loss->dropped.size(), 0);
+    // What got lost is read chunk by chunk instead of downloading it all again.
+    EXPECT_GT(loss->reads_requested, 0);
+}
+
+TEST_F(FtpLoopback, UploadShrinksWindowOnLostWriteAcks)
+{
+    connect();
+    const auto local_path = client_file("upload.bin", 50000, 4);
+
+    struct Loss {
+        std::mutex mutex{};
+        unsigned acks_to_drop{4};
+        std::set<uint32_t> sent{};
+        std::set<uint32_t> in_flight{};
+        bool resent{false};
+        std::size_t max_in_flight_before_loss{0};
+        std::size_t in_flight_at_first_write_after_loss{0};
+        bool written_after_loss{false};
+    };
+    auto loss = std::make_shared<Loss>();
+
+    // The ACKs of the first window of writes are lost, so they all time out and are resent.
+    _mavlink_passthrough->intercept_incoming_messages_async([loss](mavlink_message_t& message) {
+        if (!is_ftp(message)) {
+            return true;
+        }
+        const auto header = decode_header(message);
+        if (header.opcode != RSP_ACK || header.req_opcode != CMD_WRITE_FILE) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(loss->mutex);
+        if (loss->acks_to_drop > 0) {
+            --loss->acks_to_drop;
+            return false;
+        }
+        loss->in_flight.erase(header.offset);
+        return true;
+    });
+
+    // Writes in flight are counted as the client sends them, after a loss there should
+    // be fewer of them.
+    _mavlink_passthrough->intercept_outgoing_messages_async([loss](mavlink_message_t& message) {
+        if (!is_ftp(message)) {
+            return true;
+        }
+        const auto header = decode_header(message);
+        if (header.opcode != CMD_WRITE_FILE) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(loss->mutex);
+        if (!loss->sent.insert(header.offset).second) {
+            loss->resent = true;
+            return true;
+        }
+        if (!loss->resent) {
+            loss->max_in_flight_before_loss =
+                std::max(loss->max_in_flight_before_loss, loss->in_flight.size() + 1);
+        } else if (!loss->written_after_loss) {
+            loss->written_after_loss = true;
+            loss->in_flight_at_first_write_after_loss = loss->in_flight.size();
+        }
+        loss->in_flight.insert(header.offset);
+        return true;
+    });
+
+    auto result = upload(*_ftp_client, local_path, "/");
+    EXPECT_EQ(wait_for(result), Ftp::Result::Success);
+    EXPECT_TRUE(same_on_both_sides("upload.bin"));
+
+    std::lock_guard<std::mutex> lock(loss->mutex);
+    EXPECT_TRUE(loss->resent);
+    EXPECT_EQ(loss->max_in_flight_before_loss, 4);
+    // With the window of 4 halved, the next write only goes out once 2 are left in flight,
+    // rather than 3, the window then grows again by one.
+    ASSERT_TRUE(loss->written_after_loss);
+    EXPECT_LE(loss->in_flight_at_first_write_after_loss, 2);
+}
+
+TEST_F(FtpLoopback, ReportsBusyWithoutSessionsLeft)
+{
+    connect();
+
+    // The server has 4 sessions, which are all still open when the fifth download starts.
+    const std::vector<std::string> names{"0.bin", "1.bin", "2.bin", "3.bin", "4.bin"};
+    std::vector<std::future<Ftp::Result>> results;
+    for (unsigned i = 0; i < names.size(); ++i) {
+        server_file(names[i], 100000, 10 + i);
+    }
+    for (const auto& name : names) {
+        results.push_back(download(*_ftp_client, "/" + name, _client_dir));
+    }
+
+    unsigned succeeded = 0;
+    unsigned busy = 0;
+    std::string busy_name;
+    for (unsigned i = 0; i < names.size(); ++i) {
+        const auto result = wait_for(results[i]);
+        if (result == Ftp::Result::Success) {
+            ++succeeded;
+            EXPECT_TRUE(same_on_both_sides(names[i]));
+        } else if (result == Ftp::Result::Busy) {
+            ++busy;
+            busy_name = names[i];
+        }
+    }
+    EXPECT_EQ(succeeded, 4);
+    ASSERT_EQ(busy, 1);
+
+    // Once the others are done, there is a session again.
+    auto retried = download(*_ftp_client, "/" + busy_name, _client_dir);
+    EXPECT_EQ(wait_for(retried), Ftp::Result::Success);
+    EXPECT_TRUE(same_on_both_sides(busy_name));
+}
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "handle.h"
 #include "plugin_base.h"
 
 namespace mavsdk {
@@ -365,11 +366,32 @@ public:
 
     using MissionProgressCallback = std::function<void(MissionProgress)>;
 
+    /**
+     * @brief Handle type for subscribe_mission_progress.
+     */
+    using MissionProgressHandle = Handle<MissionProgress>;
+
     /**
      * @brief Subscribe to mission progress updates.
      */
     void subscribe_mission_progress(MissionProgressCallback callback);
 
+    /**
+     * @brief Subscribe to mission progress updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    MissionProgressHandle subscribe_mission_progress(
+        MissionProgressCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_mission_progress.
+     */
+    void unsubscribe_mission_progress(MissionProgressHandle handle);
+
     /**
      * @brief Poll for 'MissionProgress' (blocking).
      *
@@ -99,6 +99,17 @@ void Mission::subscribe_mission_progress(MissionProgressCallback callback)
     _impl->mission_progress_async(callback);
 }
 
+Mission::MissionProgressHandle Mission::subscribe_mission_progress(
+    MissionProgressCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_mission_progress(callback, queue_policy);
+}
+
+void Mission::unsubscribe_mission_progress(MissionProgressHandle handle)
+{
+    _impl->unsubscribe_mission_progress(handle);
+}
+
 Mission::MissionProgress Mission::mission_progress() const
 {
     return _impl->mission_progress();
@@ -782,8 +782,7 @@ void MissionImpl::set_current_mission_item_async(
 
 void MissionImpl::report_progress()
 {
-    const auto temp_callback = _mission_data.mission_progress_callback;
-    if (temp_callback == nullptr) {
+    if (_mission_data.mission_progress_subscriptions.empty()) {
         return;
     }
 
@@ -804,14 +803,11 @@ void MissionImpl::report_progress()
     }
 
     if (should_report) {
-        std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-        _parent->call_user_callback([temp_callback, current, total]() {
-            LogDebug() << "current: " << current << ", total: " << total;
-            Mission::MissionProgress mission_progress;
-            mission_progress.current = current;
-            mission_progress.total = total;
-            temp_callback(mission_progress);
-        });
+        LogDebug() << "current: " << current << ", total: " << total;
+        Mission::MissionProgress mission_progress;
+        mission_progress.current = current;
+        mission_progress.total = total;
+        _mission_data.mission_progress_subscriptions.queue(_queue_user_callback, mission_progress);
     }
 }
 
@@ -886,8 +882,18 @@ Mission::MissionProgress MissionImpl::mission_progress()
 
 void MissionImpl::mission_progress_async(Mission::MissionProgressCallback callback)
 {
-    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-    _mission_data.mission_progress_callback = callback;
+    _mission_data.mission_progress_subscriptions.set(callback);
+}
+
+Mission::MissionProgressHandle MissionImpl::subscribe_mission_progress(
+    const Mission::MissionProgressCallback& callback, QueuePolicy queue_policy)
+{
+    return _mission_data.mission_progress_subscriptions.subscribe(callback, queue_policy);
+}
+
+void MissionImpl::unsubscribe_mission_progress(Mission::MissionProgressHandle handle)
+{
+    _mission_data.mission_progress_subscriptions.unsubscribe(handle);
 }
 
 Mission::Result MissionImpl::convert_result(MAVLinkMissionTransfer::Result result)
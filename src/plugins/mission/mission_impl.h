@@ -6,6 +6,7 @@
 #include <memory>
 #include <mutex>
 
+#include "callback_list.h"
 #include "mavlink_include.h"
 #include "plugins/mission/mission.h"
 #include "plugin_impl_base.h"
@@ -63,6 +64,9 @@ public:
 
     Mission::MissionProgress mission_progress();
     void mission_progress_async(Mission::MissionProgressCallback callback);
+    Mission::MissionProgressHandle subscribe_mission_progress(
+        const Mission::MissionProgressCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_mission_progress(Mission::MissionProgressHandle handle);
 
     void import_qgroundcontrol_mission_async(
         std::string qgc_plan_path, const Mission::ImportQgroundcontrolMissionCallback callback);
@@ -144,7 +148,7 @@ private:
         int last_mission_item_to_upload{-1};
         Mission::ResultCallback result_callback{nullptr};
         Mission::DownloadMissionCallback download_mission_callback{nullptr};
-        Mission::MissionProgressCallback mission_progress_callback{nullptr};
+        CallbackList<Mission::MissionProgress> mission_progress_subscriptions{};
         int last_current_reported_mission_item{-1};
         int last_total_reported_mission_item{-1};
         std::weak_ptr<MAVLinkMissionTransfer::WorkItem> last_upload{};
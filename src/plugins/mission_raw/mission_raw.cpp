@@ -98,6 +98,17 @@ void MissionRaw::subscribe_mission_progress(MissionProgressCallback callback)
     _impl->mission_progress_async(callback);
 }
 
+MissionRaw::MissionProgressHandle MissionRaw::subscribe_mission_progress(
+    MissionProgressCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_mission_progress(callback, queue_policy);
+}
+
+void MissionRaw::unsubscribe_mission_progress(MissionProgressHandle handle)
+{
+    _impl->unsubscribe_mission_progress(handle);
+}
+
 MissionRaw::MissionProgress MissionRaw::mission_progress() const
 {
     return _impl->mission_progress();
@@ -108,6 +119,17 @@ void MissionRaw::subscribe_mission_changed(MissionChangedCallback callback)
     _impl->mission_changed_async(callback);
 }
 
+MissionRaw::MissionChangedHandle MissionRaw::subscribe_mission_changed(
+    MissionChangedCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_mission_changed(callback, queue_policy);
+}
+
+void MissionRaw::unsubscribe_mission_changed(MissionChangedHandle handle)
+{
+    _impl->unsubscribe_mission_changed(handle);
+}
+
 bool operator==(const MissionRaw::MissionProgress& lhs, const MissionRaw::MissionProgress& rhs)
 {
     return (rhs.current == lhs.current) && (rhs.total == lhs.total);
@@ -72,11 +72,7 @@ void MissionRawImpl::process_mission_ack(const mavlink_message_t& message)
 
     // We assume that if the vehicle sends an ACCEPTED ack might have received
     // a new mission. In that case we need to notify our user.
-    std::lock_guard<std::mutex> lock(_mission_changed.mutex);
-    if (_mission_changed.callback) {
-        auto temp_callback = _mission_changed.callback;
-        _parent->call_user_callback([temp_callback]() { temp_callback(true); });
-    }
+    _mission_changed_subscriptions.queue(_queue_user_callback, true);
 }
 
 void MissionRawImpl::process_mission_current(const mavlink_message_t& message)
@@ -419,7 +415,7 @@ void MissionRawImpl::report_progress_current()
 {
     std::lock_guard<std::mutex> lock(_mission_progress.mutex);
 
-    if (_mission_progress.callback == nullptr) {
+    if (_mission_progress.subscriptions.empty()) {
         return;
     }
 
@@ -436,16 +432,24 @@ void MissionRawImpl::report_progress_current()
     }
 
     if (should_report) {
-        const auto last = _mission_progress.last;
-        const auto temp_callback = _mission_progress.callback;
-        _parent->call_user_callback([temp_callback, last]() { temp_callback(last); });
+        _mission_progress.subscriptions.queue(_queue_user_callback, _mission_progress.last);
     }
 }
 
 void MissionRawImpl::mission_progress_async(MissionRaw::MissionProgressCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_mission_progress.mutex);
-    _mission_progress.callback = callback;
+    _mission_progress.subscriptions.set(callback);
+}
+
+MissionRaw::MissionProgressHandle MissionRawImpl::subscribe_mission_progress(
+    const MissionRaw::MissionProgressCallback& callback, QueuePolicy queue_policy)
+{
+    return _mission_progress.subscriptions.subscribe(callback, queue_policy);
+}
+
+void MissionRawImpl::unsubscribe_mission_progress(MissionRaw::MissionProgressHandle handle)
+{
+    _mission_progress.subscriptions.unsubscribe(handle);
 }
 
 MissionRaw::MissionProgress MissionRawImpl::mission_progress()
@@ -456,8 +460,18 @@ MissionRaw::MissionProgress MissionRawImpl::mission_progress()
 
 void MissionRawImpl::mission_changed_async(MissionRaw::MissionChangedCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_mission_changed.mutex);
-    _mission_changed.callback = callback;
+    _mission_changed_subscriptions.set(callback);
+}
+
+MissionRaw::MissionChangedHandle MissionRawImpl::subscribe_mission_changed(
+    const MissionRaw::MissionChangedCallback& callback, QueuePolicy queue_policy)
+{
+    return _mission_changed_subscriptions.subscribe(callback, queue_policy);
+}
+
+void MissionRawImpl::unsubscribe_mission_changed(MissionRaw::MissionChangedHandle handle)
+{
+    _mission_changed_subscriptions.unsubscribe(handle);
 }
 
 MissionRaw::Result MissionRawImpl::convert_result(MAVLinkMissionTransfer::Result result)
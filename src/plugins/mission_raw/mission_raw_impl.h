@@ -2,6 +2,7 @@
 
 #include <mutex>
 
+#include "callback_list.h"
 #include "mavlink_include.h"
 #include "plugins/mission_raw/mission_raw.h"
 #include "plugin_impl_base.h"
@@ -32,6 +33,9 @@ public:
     MissionRaw::Result cancel_mission_upload();
 
     void mission_changed_async(MissionRaw::MissionChangedCallback callback);
+    MissionRaw::MissionChangedHandle subscribe_mission_changed(
+        const MissionRaw::MissionChangedCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_mission_changed(MissionRaw::MissionChangedHandle handle);
 
     MissionRaw::Result start_mission();
     void start_mission_async(const MissionRaw::ResultCallback& callback);
@@ -48,6 +52,9 @@ public:
 
     MissionRaw::MissionProgress mission_progress();
     void mission_progress_async(MissionRaw::MissionProgressCallback callback);
+    MissionRaw::MissionProgressHandle subscribe_mission_progress(
+        const MissionRaw::MissionProgressCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_mission_progress(MissionRaw::MissionProgressHandle handle);
 
     MissionRawImpl(const MissionRawImpl&) = delete;
     const MissionRawImpl& operator=(const MissionRawImpl&) = delete;
@@ -85,13 +92,10 @@ private:
         std::mutex mutex{};
         MissionRaw::MissionProgress last{};
         MissionRaw::MissionProgress last_reported{};
-        MissionRaw::MissionProgressCallback callback{nullptr};
+        CallbackList<MissionRaw::MissionProgress> subscriptions{};
     } _mission_progress{};
 
-    struct {
-        std::mutex mutex{};
-        MissionRaw::MissionChangedCallback callback{nullptr};
-    } _mission_changed{};
+    CallbackList<bool> _mission_changed_subscriptions{};
 };
 
 } // namespace mavsdk
@@ -58,16 +58,17 @@ Param::AllParams ParamImpl::get_all_params()
 
     Param::AllParams res{};
 
-    for (auto const& parampair : tmp) {
-        if (parampair.second.is<float>()) {
+    // The store keeps the order the params arrived in, AllParams are sorted by name.
+    for (auto const* param : tmp.sorted_by_name()) {
+        if (param->value.is<float>()) {
             Param::FloatParam tmp_param;
-            tmp_param.name = parampair.first;
-            tmp_param.value = parampair.second.get<float>();
+            tmp_param.name = param->id.to_string();
+            tmp_param.value = param->value.get<float>();
             res.float_params.push_back(tmp_param);
-        } else if (parampair.second.is<int32_t>()) {
+        } else if (param->value.is<int32_t>()) {
             Param::IntParam tmp_param;
-            tmp_param.name = parampair.first;
-            tmp_param.value = parampair.second.get<int32_t>();
+            tmp_param.name = param->id.to_string();
+            tmp_param.value = param->value.get<int32_t>();
             res.int_params.push_back(tmp_param);
         }
     }
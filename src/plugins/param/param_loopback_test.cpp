@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "mavsdk.h"
+#include "mocks/fake_autopilot.h"
+#include "plugins/param/param.h"
+
+using namespace mavsdk;
+using namespace mavsdk::testing;
+
+namespace {
+
+constexpr uint16_t PARAM_COUNT = 300;
+
+std::string param_name(uint16_t index)
+{
+    char name[17] = {};
+    std::snprintf(name, sizeof(name), "TEST_PARAM_%03u", static_cast<unsigned>(index));
+    return name;
+}
+
+mavlink_message_t param_value(uint16_t index)
+{
+    mavlink_param_value_t param_value{};
+    param_value.param_value = static_cast<float>(index) / 2.0f;
+    param_value.param_count = PARAM_COUNT;
+    param_value.param_index = index;
+    param_value.param_type = MAV_PARAM_TYPE_REAL32;
+    const auto name = param_name(index);
+    std::memcpy(param_value.param_id, name.c_str(), name.size());
+
+    mavlink_message_t message;
+    mavlink_msg_param_value_encode(
+        FakeAutopilot::SYSID, MAV_COMP_ID_AUTOPILOT1, &message, &param_value);
+    return message;
+}
+
+// Every message on the way is lost with the same chance, apart from the request of the whole
+// list, which would be requested again otherwise.
+struct LossyParams {
+    std::mutex mutex{};
+    std::mt19937 random{42};
+    std::bernoulli_distribution lost{0.05};
+    unsigned list_requests{0};
+    unsigned read_requests{0};
+
+    bool is_lost()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lost(random);
+    }
+};
+
+} // namespace
+
+TEST(ParamLoopback, GetsAllParamsOverLossyLink)
+{
+    FakeAutopilot autopilot;
+    Mavsdk mavsdk;
+    auto system = autopilot.connect(mavsdk);
+    ASSERT_TRUE(system);
+
+    auto params = std::make_shared<LossyParams>();
+    autopilot.subscribe_message(
+        MAVLINK_MSG_ID_PARAM_REQUEST_LIST, [&autopilot, params](const mavlink_message_t&) {
+            {
+                std::lock_guard<std::mutex> lock(params->mutex);
+                ++params->list_requests;
+            }
+            for (uint16_t index = 0; index < PARAM_COUNT; ++index) {
+                if (!params->is_lost()) {
+                    autopilot.send(param_value(index));
+                }
+            }
+        });
+    autopilot.subscribe_message(
+        MAVLINK_MSG_ID_PARAM_REQUEST_READ,
+        [&autopilot, params](const mavlink_message_t& message) {
+            {
+                std::lock_guard<std::mutex> lock(params->mutex);
+                ++params->read_requests;
+            }
+            // Either the request or the answer can get lost.
+            const auto index = mavlink_msg_param_request_read_get_param_index(&message);
+            if (index < 0 || index >= PARAM_COUNT || params->is_lost() || params->is_lost()) {
+                return;
+            }
+            autopilot.send(param_value(static_cast<uint16_t>(index)));
+        });
+
+    Param param(system);
+    auto all_params = std::async(std::launch::async, [&param]() { return param.get_all_params(); });
+    ASSERT_EQ(all_params.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+
+    const auto result = all_params.get();
+    EXPECT_TRUE(result.int_params.empty());
+    ASSERT_EQ(result.float_params.size(), PARAM_COUNT);
+    for (const auto& float_param : result.float_params) {
+        ASSERT_EQ(float_param.name.substr(0, 11), "TEST_PARAM_");
+        const auto index = std::atoi(float_param.name.substr(11).c_str());
+        EXPECT_EQ(float_param.value, static_cast<float>(index) / 2.0f);
+    }
+
+    std::lock_guard<std::mutex> lock(params->mutex);
+    EXPECT_EQ(params->list_requests, 1u);
+    EXPECT_GT(params->read_requests, 0u);
+}
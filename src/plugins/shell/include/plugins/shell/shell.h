@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "handle.h"
 #include "plugin_base.h"
 
 namespace mavsdk {
@@ -96,6 +97,11 @@ public:
 
     using ReceiveCallback = std::function<void(std::string)>;
 
+    /**
+     * @brief Handle type for subscribe_receive.
+     */
+    using ReceiveHandle = Handle<std::string>;
+
     /**
      * @brief Receive feedback from a sent command line.
      *
@@ -104,6 +110,21 @@ public:
      */
     void subscribe_receive(ReceiveCallback callback);
 
+    /**
+     * @brief Receive feedback from a sent command line.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ReceiveHandle subscribe_receive(ReceiveCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_receive.
+     */
+    void unsubscribe_receive(ReceiveHandle handle);
+
     /**
      * @brief Copy constructor.
      */
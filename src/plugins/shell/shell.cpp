@@ -25,6 +25,16 @@ void Shell::subscribe_receive(ReceiveCallback callback)
     _impl->receive_async(callback);
 }
 
+Shell::ReceiveHandle Shell::subscribe_receive(ReceiveCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_receive(callback, queue_policy);
+}
+
+void Shell::unsubscribe_receive(ReceiveHandle handle)
+{
+    _impl->unsubscribe_receive(handle);
+}
+
 std::ostream& operator<<(std::ostream& str, Shell::Result const& result)
 {
     switch (result) {
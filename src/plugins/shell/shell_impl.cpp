@@ -55,8 +55,18 @@ Shell::Result ShellImpl::send(std::string command)
 
 void ShellImpl::receive_async(Shell::ReceiveCallback callback)
 {
-    std::lock_guard<std::mutex> lock(_receive.mutex);
-    _receive.callback = callback;
+    _receive_subscriptions.set(callback);
+}
+
+Shell::ReceiveHandle ShellImpl::subscribe_receive(
+    const Shell::ReceiveCallback& callback, QueuePolicy queue_policy)
+{
+    return _receive_subscriptions.subscribe(callback, queue_policy);
+}
+
+void ShellImpl::unsubscribe_receive(Shell::ReceiveHandle handle)
+{
+    _receive_subscriptions.unsubscribe(handle);
 }
 
 bool ShellImpl::send_command_message(std::string command)
@@ -81,12 +91,9 @@ bool ShellImpl::send_command_message(std::string command)
     }
 
     uint8_t flags = 0;
-    {
-        // We only ask for a reponse if we have subscribed to a response.
-        std::lock_guard<std::mutex> lock(_receive.mutex);
-        if (_receive.callback != nullptr) {
-            flags |= SERIAL_CONTROL_FLAG_RESPOND;
-        }
+    // We only ask for a reponse if we have subscribed to a response.
+    if (!_receive_subscriptions.empty()) {
+        flags |= SERIAL_CONTROL_FLAG_RESPOND;
     }
 
     uint8_t data[MAVLINK_MSG_SERIAL_CONTROL_FIELD_DATA_LEN]{};
@@ -128,11 +135,7 @@ void ShellImpl::process_shell_message(const mavlink_message_t& message)
         response.erase(index, 4);
     }
 
-    std::lock_guard<std::mutex> lock(_receive.mutex);
-    if (_receive.callback) {
-        const auto temp_callback = _receive.callback;
-        _parent->call_user_callback([temp_callback, response]() { temp_callback(response); });
-    }
+    _receive_subscriptions.queue(_queue_user_callback, response);
 }
 
 } // namespace mavsdk
@@ -3,6 +3,7 @@
 #include <mutex>
 
 #include "plugins/shell/shell.h"
+#include "callback_list.h"
 #include "mavlink_include.h"
 #include "plugin_impl_base.h"
 #include "system.h"
@@ -25,6 +26,9 @@ public:
 
     Shell::Result send(std::string command);
     void receive_async(Shell::ReceiveCallback callback);
+    Shell::ReceiveHandle subscribe_receive(
+        const Shell::ReceiveCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_receive(Shell::ReceiveHandle handle);
 
     ShellImpl(const ShellImpl&) = delete;
     ShellImpl& operator=(const ShellImpl&) = delete;
@@ -35,9 +39,6 @@ private:
 
     static constexpr uint16_t timeout_ms = 1000;
 
-    struct {
-        std::mutex mutex{};
-        Shell::ReceiveCallback callback{nullptr};
-    } _receive{};
+    CallbackList<std::string> _receive_subscriptions{};
 };
 } // namespace mavsdk
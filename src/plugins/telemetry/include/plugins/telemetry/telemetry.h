@@ -13,6 +13,8 @@
 #include <utility>
 #include <vector>
 
+#include "fixed_vector.h"
+#include "handle.h"
 #include "plugin_base.h"
 
 namespace mavsdk {
@@ -390,7 +392,7 @@ public:
     struct ActuatorControlTarget {
         int32_t group{0}; /**< @brief An actuator control group is e.g. 'attitude' for the core
                              flight controls, or 'gimbal' for a payload. */
-        std::vector<float>
+        FixedVector<float, 8>
             controls{}; /**< @brief Controls normed from -1 to 1, where 0 is neutral position. */
     };
 
@@ -415,7 +417,7 @@ public:
      */
     struct ActuatorOutputStatus {
         uint32_t active{0}; /**< @brief Active outputs */
-        std::vector<float> actuator{}; /**< @brief Servo/motor output values */
+        FixedVector<float, 32> actuator{}; /**< @brief Servo/motor output values */
     };
 
     /**
@@ -442,7 +444,7 @@ public:
      * Set first to NaN if unknown.
      */
     struct Covariance {
-        std::vector<float>
+        FixedVector<float, 21>
             covariance_matrix{}; /**< @brief Representation of a covariance matrix. */
     };
 
@@ -873,11 +875,31 @@ public:
 
     using PositionCallback = std::function<void(Position)>;
 
+    /**
+     * @brief Handle type for subscribe_position.
+     */
+    using PositionHandle = Handle<Position>;
+
     /**
      * @brief Subscribe to 'position' updates.
      */
     void subscribe_position(PositionCallback callback);
 
+    /**
+     * @brief Subscribe to 'position' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    PositionHandle subscribe_position(PositionCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_position.
+     */
+    void unsubscribe_position(PositionHandle handle);
+
     /**
      * @brief Poll for 'Position' (blocking).
      *
@@ -891,11 +913,31 @@ public:
 
     using HomeCallback = std::function<void(Position)>;
 
+    /**
+     * @brief Handle type for subscribe_home.
+     */
+    using HomeHandle = Handle<Position>;
+
     /**
      * @brief Subscribe to 'home position' updates.
      */
     void subscribe_home(HomeCallback callback);
 
+    /**
+     * @brief Subscribe to 'home position' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    HomeHandle subscribe_home(HomeCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_home.
+     */
+    void unsubscribe_home(HomeHandle handle);
+
     /**
      * @brief Poll for 'Position' (blocking).
      *
@@ -909,11 +951,31 @@ public:
 
     using InAirCallback = std::function<void(bool)>;
 
+    /**
+     * @brief Handle type for subscribe_in_air.
+     */
+    using InAirHandle = Handle<bool>;
+
     /**
      * @brief Subscribe to in-air updates.
      */
     void subscribe_in_air(InAirCallback callback);
 
+    /**
+     * @brief Subscribe to in-air updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    InAirHandle subscribe_in_air(InAirCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_in_air.
+     */
+    void unsubscribe_in_air(InAirHandle handle);
+
     /**
      * @brief Poll for 'bool' (blocking).
      *
@@ -927,11 +989,32 @@ public:
 
     using LandedStateCallback = std::function<void(LandedState)>;
 
+    /**
+     * @brief Handle type for subscribe_landed_state.
+     */
+    using LandedStateHandle = Handle<LandedState>;
+
     /**
      * @brief Subscribe to landed state updates
      */
     void subscribe_landed_state(LandedStateCallback callback);
 
+    /**
+     * @brief Subscribe to landed state updates
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    LandedStateHandle subscribe_landed_state(
+        LandedStateCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_landed_state.
+     */
+    void unsubscribe_landed_state(LandedStateHandle handle);
+
     /**
      * @brief Poll for 'LandedState' (blocking).
      *
@@ -945,11 +1028,31 @@ public:
 
     using ArmedCallback = std::function<void(bool)>;
 
+    /**
+     * @brief Handle type for subscribe_armed.
+     */
+    using ArmedHandle = Handle<bool>;
+
     /**
      * @brief Subscribe to armed updates.
      */
     void subscribe_armed(ArmedCallback callback);
 
+    /**
+     * @brief Subscribe to armed updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ArmedHandle subscribe_armed(ArmedCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_armed.
+     */
+    void unsubscribe_armed(ArmedHandle handle);
+
     /**
      * @brief Poll for 'bool' (blocking).
      *
@@ -963,11 +1066,32 @@ public:
 
     using AttitudeQuaternionCallback = std::function<void(Quaternion)>;
 
+    /**
+     * @brief Handle type for subscribe_attitude_quaternion.
+     */
+    using AttitudeQuaternionHandle = Handle<Quaternion>;
+
     /**
      * @brief Subscribe to 'attitude' updates (quaternion).
      */
     void subscribe_attitude_quaternion(AttitudeQuaternionCallback callback);
 
+    /**
+     * @brief Subscribe to 'attitude' updates (quaternion).
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    AttitudeQuaternionHandle subscribe_attitude_quaternion(
+        AttitudeQuaternionCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_attitude_quaternion.
+     */
+    void unsubscribe_attitude_quaternion(AttitudeQuaternionHandle handle);
+
     /**
      * @brief Poll for 'Quaternion' (blocking).
      *
@@ -981,11 +1105,32 @@ public:
 
     using AttitudeEulerCallback = std::function<void(EulerAngle)>;
 
+    /**
+     * @brief Handle type for subscribe_attitude_euler.
+     */
+    using AttitudeEulerHandle = Handle<EulerAngle>;
+
     /**
      * @brief Subscribe to 'attitude' updates (Euler).
      */
     void subscribe_attitude_euler(AttitudeEulerCallback callback);
 
+    /**
+     * @brief Subscribe to 'attitude' updates (Euler).
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    AttitudeEulerHandle subscribe_attitude_euler(
+        AttitudeEulerCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_attitude_euler.
+     */
+    void unsubscribe_attitude_euler(AttitudeEulerHandle handle);
+
     /**
      * @brief Poll for 'EulerAngle' (blocking).
      *
@@ -999,11 +1144,32 @@ public:
 
     using AttitudeAngularVelocityBodyCallback = std::function<void(AngularVelocityBody)>;
 
+    /**
+     * @brief Handle type for subscribe_attitude_angular_velocity_body.
+     */
+    using AttitudeAngularVelocityBodyHandle = Handle<AngularVelocityBody>;
+
     /**
      * @brief Subscribe to 'attitude' updates (angular velocity)
      */
     void subscribe_attitude_angular_velocity_body(AttitudeAngularVelocityBodyCallback callback);
 
+    /**
+     * @brief Subscribe to 'attitude' updates (angular velocity)
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    AttitudeAngularVelocityBodyHandle subscribe_attitude_angular_velocity_body(
+        AttitudeAngularVelocityBodyCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_attitude_angular_velocity_body.
+     */
+    void unsubscribe_attitude_angular_velocity_body(AttitudeAngularVelocityBodyHandle handle);
+
     /**
      * @brief Poll for 'AngularVelocityBody' (blocking).
      *
@@ -1017,11 +1183,32 @@ public:
 
     using CameraAttitudeQuaternionCallback = std::function<void(Quaternion)>;
 
+    /**
+     * @brief Handle type for subscribe_camera_attitude_quaternion.
+     */
+    using CameraAttitudeQuaternionHandle = Handle<Quaternion>;
+
     /**
      * @brief Subscribe to 'camera attitude' updates (quaternion).
      */
     void subscribe_camera_attitude_quaternion(CameraAttitudeQuaternionCallback callback);
 
+    /**
+     * @brief Subscribe to 'camera attitude' updates (quaternion).
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    CameraAttitudeQuaternionHandle subscribe_camera_attitude_quaternion(
+        CameraAttitudeQuaternionCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_camera_attitude_quaternion.
+     */
+    void unsubscribe_camera_attitude_quaternion(CameraAttitudeQuaternionHandle handle);
+
     /**
      * @brief Poll for 'Quaternion' (blocking).
      *
@@ -1035,11 +1222,32 @@ public:
 
     using CameraAttitudeEulerCallback = std::function<void(EulerAngle)>;
 
+    /**
+     * @brief Handle type for subscribe_camera_attitude_euler.
+     */
+    using CameraAttitudeEulerHandle = Handle<EulerAngle>;
+
     /**
      * @brief Subscribe to 'camera attitude' updates (Euler).
      */
     void subscribe_camera_attitude_euler(CameraAttitudeEulerCallback callback);
 
+    /**
+     * @brief Subscribe to 'camera attitude' updates (Euler).
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    CameraAttitudeEulerHandle subscribe_camera_attitude_euler(
+        CameraAttitudeEulerCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_camera_attitude_euler.
+     */
+    void unsubscribe_camera_attitude_euler(CameraAttitudeEulerHandle handle);
+
     /**
      * @brief Poll for 'EulerAngle' (blocking).
      *
@@ -1053,11 +1261,32 @@ public:
 
     using VelocityNedCallback = std::function<void(VelocityNed)>;
 
+    /**
+     * @brief Handle type for subscribe_velocity_ned.
+     */
+    using VelocityNedHandle = Handle<VelocityNed>;
+
     /**
      * @brief Subscribe to 'ground speed' updates (NED).
      */
     void subscribe_velocity_ned(VelocityNedCallback callback);
 
+    /**
+     * @brief Subscribe to 'ground speed' updates (NED).
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    VelocityNedHandle subscribe_velocity_ned(
+        VelocityNedCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_velocity_ned.
+     */
+    void unsubscribe_velocity_ned(VelocityNedHandle handle);
+
     /**
      * @brief Poll for 'VelocityNed' (blocking).
      *
@@ -1071,11 +1300,31 @@ public:
 
     using GpsInfoCallback = std::function<void(GpsInfo)>;
 
+    /**
+     * @brief Handle type for subscribe_gps_info.
+     */
+    using GpsInfoHandle = Handle<GpsInfo>;
+
     /**
      * @brief Subscribe to 'GPS info' updates.
      */
     void subscribe_gps_info(GpsInfoCallback callback);
 
+    /**
+     * @brief Subscribe to 'GPS info' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    GpsInfoHandle subscribe_gps_info(GpsInfoCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_gps_info.
+     */
+    void unsubscribe_gps_info(GpsInfoHandle handle);
+
     /**
      * @brief Poll for 'GpsInfo' (blocking).
      *
@@ -1089,11 +1338,31 @@ public:
 
     using BatteryCallback = std::function<void(Battery)>;
 
+    /**
+     * @brief Handle type for subscribe_battery.
+     */
+    using BatteryHandle = Handle<Battery>;
+
     /**
      * @brief Subscribe to 'battery' updates.
      */
     void subscribe_battery(BatteryCallback callback);
 
+    /**
+     * @brief Subscribe to 'battery' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    BatteryHandle subscribe_battery(BatteryCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_battery.
+     */
+    void unsubscribe_battery(BatteryHandle handle);
+
     /**
      * @brief Poll for 'Battery' (blocking).
      *
@@ -1107,11 +1376,31 @@ public:
 
     using FlightModeCallback = std::function<void(FlightMode)>;
 
+    /**
+     * @brief Handle type for subscribe_flight_mode.
+     */
+    using FlightModeHandle = Handle<FlightMode>;
+
     /**
      * @brief Subscribe to 'flight mode' updates.
      */
     void subscribe_flight_mode(FlightModeCallback callback);
 
+    /**
+     * @brief Subscribe to 'flight mode' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    FlightModeHandle subscribe_flight_mode(FlightModeCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_flight_mode.
+     */
+    void unsubscribe_flight_mode(FlightModeHandle handle);
+
     /**
      * @brief Poll for 'FlightMode' (blocking).
      *
@@ -1125,11 +1414,31 @@ public:
 
     using HealthCallback = std::function<void(Health)>;
 
+    /**
+     * @brief Handle type for subscribe_health.
+     */
+    using HealthHandle = Handle<Health>;
+
     /**
      * @brief Subscribe to 'health' updates.
      */
     void subscribe_health(HealthCallback callback);
 
+    /**
+     * @brief Subscribe to 'health' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    HealthHandle subscribe_health(HealthCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_health.
+     */
+    void unsubscribe_health(HealthHandle handle);
+
     /**
      * @brief Poll for 'Health' (blocking).
      *
@@ -1143,11 +1452,31 @@ public:
 
     using RcStatusCallback = std::function<void(RcStatus)>;
 
+    /**
+     * @brief Handle type for subscribe_rc_status.
+     */
+    using RcStatusHandle = Handle<RcStatus>;
+
     /**
      * @brief Subscribe to 'RC status' updates.
      */
     void subscribe_rc_status(RcStatusCallback callback);
 
+    /**
+     * @brief Subscribe to 'RC status' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    RcStatusHandle subscribe_rc_status(RcStatusCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_rc_status.
+     */
+    void unsubscribe_rc_status(RcStatusHandle handle);
+
     /**
      * @brief Poll for 'RcStatus' (blocking).
      *
@@ -1161,11 +1490,31 @@ public:
 
     using StatusTextCallback = std::function<void(StatusText)>;
 
+    /**
+     * @brief Handle type for subscribe_status_text.
+     */
+    using StatusTextHandle = Handle<StatusText>;
+
     /**
      * @brief Subscribe to 'status text' updates.
      */
     void subscribe_status_text(StatusTextCallback callback);
 
+    /**
+     * @brief Subscribe to 'status text' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    StatusTextHandle subscribe_status_text(StatusTextCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_status_text.
+     */
+    void unsubscribe_status_text(StatusTextHandle handle);
+
     /**
      * @brief Poll for 'StatusText' (blocking).
      *
@@ -1179,11 +1528,32 @@ public:
 
     using ActuatorControlTargetCallback = std::function<void(ActuatorControlTarget)>;
 
+    /**
+     * @brief Handle type for subscribe_actuator_control_target.
+     */
+    using ActuatorControlTargetHandle = Handle<ActuatorControlTarget>;
+
     /**
      * @brief Subscribe to 'actuator control target' updates.
      */
     void subscribe_actuator_control_target(ActuatorControlTargetCallback callback);
 
+    /**
+     * @brief Subscribe to 'actuator control target' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ActuatorControlTargetHandle subscribe_actuator_control_target(
+        ActuatorControlTargetCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_actuator_control_target.
+     */
+    void unsubscribe_actuator_control_target(ActuatorControlTargetHandle handle);
+
     /**
      * @brief Poll for 'ActuatorControlTarget' (blocking).
      *
@@ -1197,11 +1567,32 @@ public:
 
     using ActuatorOutputStatusCallback = std::function<void(ActuatorOutputStatus)>;
 
+    /**
+     * @brief Handle type for subscribe_actuator_output_status.
+     */
+    using ActuatorOutputStatusHandle = Handle<ActuatorOutputStatus>;
+
     /**
      * @brief Subscribe to 'actuator output status' updates.
      */
     void subscribe_actuator_output_status(ActuatorOutputStatusCallback callback);
 
+    /**
+     * @brief Subscribe to 'actuator output status' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ActuatorOutputStatusHandle subscribe_actuator_output_status(
+        ActuatorOutputStatusCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_actuator_output_status.
+     */
+    void unsubscribe_actuator_output_status(ActuatorOutputStatusHandle handle);
+
     /**
      * @brief Poll for 'ActuatorOutputStatus' (blocking).
      *
@@ -1215,11 +1606,31 @@ public:
 
     using OdometryCallback = std::function<void(Odometry)>;
 
+    /**
+     * @brief Handle type for subscribe_odometry.
+     */
+    using OdometryHandle = Handle<Odometry>;
+
     /**
      * @brief Subscribe to 'odometry' updates.
      */
     void subscribe_odometry(OdometryCallback callback);
 
+    /**
+     * @brief Subscribe to 'odometry' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    OdometryHandle subscribe_odometry(OdometryCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_odometry.
+     */
+    void unsubscribe_odometry(OdometryHandle handle);
+
     /**
      * @brief Poll for 'Odometry' (blocking).
      *
@@ -1233,11 +1644,32 @@ public:
 
     using PositionVelocityNedCallback = std::function<void(PositionVelocityNed)>;
 
+    /**
+     * @brief Handle type for subscribe_position_velocity_ned.
+     */
+    using PositionVelocityNedHandle = Handle<PositionVelocityNed>;
+
     /**
      * @brief Subscribe to 'position velocity' updates.
      */
     void subscribe_position_velocity_ned(PositionVelocityNedCallback callback);
 
+    /**
+     * @brief Subscribe to 'position velocity' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    PositionVelocityNedHandle subscribe_position_velocity_ned(
+        PositionVelocityNedCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_position_velocity_ned.
+     */
+    void unsubscribe_position_velocity_ned(PositionVelocityNedHandle handle);
+
     /**
      * @brief Poll for 'PositionVelocityNed' (blocking).
      *
@@ -1251,11 +1683,32 @@ public:
 
     using GroundTruthCallback = std::function<void(GroundTruth)>;
 
+    /**
+     * @brief Handle type for subscribe_ground_truth.
+     */
+    using GroundTruthHandle = Handle<GroundTruth>;
+
     /**
      * @brief Subscribe to 'ground truth' updates.
      */
     void subscribe_ground_truth(GroundTruthCallback callback);
 
+    /**
+     * @brief Subscribe to 'ground truth' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    GroundTruthHandle subscribe_ground_truth(
+        GroundTruthCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_ground_truth.
+     */
+    void unsubscribe_ground_truth(GroundTruthHandle handle);
+
     /**
      * @brief Poll for 'GroundTruth' (blocking).
      *
@@ -1269,11 +1722,32 @@ public:
 
     using FixedwingMetricsCallback = std::function<void(FixedwingMetrics)>;
 
+    /**
+     * @brief Handle type for subscribe_fixedwing_metrics.
+     */
+    using FixedwingMetricsHandle = Handle<FixedwingMetrics>;
+
     /**
      * @brief Subscribe to 'fixedwing metrics' updates.
      */
     void subscribe_fixedwing_metrics(FixedwingMetricsCallback callback);
 
+    /**
+     * @brief Subscribe to 'fixedwing metrics' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    FixedwingMetricsHandle subscribe_fixedwing_metrics(
+        FixedwingMetricsCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_fixedwing_metrics.
+     */
+    void unsubscribe_fixedwing_metrics(FixedwingMetricsHandle handle);
+
     /**
      * @brief Poll for 'FixedwingMetrics' (blocking).
      *
@@ -1287,11 +1761,31 @@ public:
 
     using ImuCallback = std::function<void(Imu)>;
 
+    /**
+     * @brief Handle type for subscribe_imu.
+     */
+    using ImuHandle = Handle<Imu>;
+
     /**
      * @brief Subscribe to 'IMU' updates.
      */
     void subscribe_imu(ImuCallback callback);
 
+    /**
+     * @brief Subscribe to 'IMU' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    ImuHandle subscribe_imu(ImuCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_imu.
+     */
+    void unsubscribe_imu(ImuHandle handle);
+
     /**
      * @brief Poll for 'Imu' (blocking).
      *
@@ -1305,11 +1799,32 @@ public:
 
     using HealthAllOkCallback = std::function<void(bool)>;
 
+    /**
+     * @brief Handle type for subscribe_health_all_ok.
+     */
+    using HealthAllOkHandle = Handle<bool>;
+
     /**
      * @brief Subscribe to 'HealthAllOk' updates.
      */
     void subscribe_health_all_ok(HealthAllOkCallback callback);
 
+    /**
+     * @brief Subscribe to 'HealthAllOk' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    HealthAllOkHandle subscribe_health_all_ok(
+        HealthAllOkCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_health_all_ok.
+     */
+    void unsubscribe_health_all_ok(HealthAllOkHandle handle);
+
     /**
      * @brief Poll for 'bool' (blocking).
      *
@@ -1323,11 +1838,32 @@ public:
 
     using UnixEpochTimeCallback = std::function<void(uint64_t)>;
 
+    /**
+     * @brief Handle type for subscribe_unix_epoch_time.
+     */
+    using UnixEpochTimeHandle = Handle<uint64_t>;
+
     /**
      * @brief Subscribe to 'unix epoch time' updates.
      */
     void subscribe_unix_epoch_time(UnixEpochTimeCallback callback);
 
+    /**
+     * @brief Subscribe to 'unix epoch time' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    UnixEpochTimeHandle subscribe_unix_epoch_time(
+        UnixEpochTimeCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_unix_epoch_time.
+     */
+    void unsubscribe_unix_epoch_time(UnixEpochTimeHandle handle);
+
     /**
      * @brief Poll for 'uint64_t' (blocking).
      *
@@ -1341,11 +1877,32 @@ public:
 
     using DistanceSensorCallback = std::function<void(DistanceSensor)>;
 
+    /**
+     * @brief Handle type for subscribe_distance_sensor.
+     */
+    using DistanceSensorHandle = Handle<DistanceSensor>;
+
     /**
      * @brief Subscribe to 'Distance Sensor' updates.
      */
     void subscribe_distance_sensor(DistanceSensorCallback callback);
 
+    /**
+     * @brief Subscribe to 'Distance Sensor' updates.
+     *
+     * Unlike the overload without handle, this adds a subscriber next to any others,
+     * queued using the given queue policy.
+     *
+     * @return Handle to unsubscribe with.
+     */
+    DistanceSensorHandle subscribe_distance_sensor(
+        DistanceSensorCallback callback, QueuePolicy queue_policy);
+
+    /**
+     * @brief Unsubscribe using a handle returned by subscribe_distance_sensor.
+     */
+    void unsubscribe_distance_sensor(DistanceSensorHandle handle);
+
     /**
      * @brief Poll for 'DistanceSensor' (blocking).
      *
@@ -1705,6 +2262,9 @@ public:
 private:
     /** @private Underlying implementation, set at instantiation */
     std::unique_ptr<TelemetryImpl> _impl;
+
+    /** @private Additions to the API written by hand, see telemetry_extension.h */
+    friend class TelemetryExtension;
 };
 
 } // namespace mavsdk
\ No newline at end of file
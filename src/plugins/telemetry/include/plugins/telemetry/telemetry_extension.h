@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "plugins/telemetry/telemetry.h"
+
+namespace mavsdk {
+
+class TelemetryImpl;
+
+/**
+ * @brief Additions to the Telemetry API which are not part of the proto, so they are only
+ * available in C++ and not through mavsdk_server.
+ */
+class TelemetryExtension {
+public:
+    /**
+     * @brief Constructor. Uses the implementation of an existing Telemetry plugin.
+     *
+     * The extension is typically created as shown below:
+     *
+     *     ```cpp
+     *     auto telemetry_extension = TelemetryExtension(telemetry);
+     *     ```
+     *
+     * @param telemetry The plugin to extend, which needs to outlive the extension.
+     */
+    explicit TelemetryExtension(const Telemetry& telemetry);
+
+    /**
+     * @brief Rates of several updates, which are set at once.
+     *
+     * Rates which are NaN are left as they are.
+     */
+    struct Rates {
+        double position_velocity_ned_hz{
+            double(NAN)}; /**< @brief Rate of 'position velocity' updates */
+        double position_hz{double(NAN)}; /**< @brief Rate of 'position' updates */
+        double home_hz{double(NAN)}; /**< @brief Rate of 'home position' updates */
+        double landed_state_hz{double(NAN)}; /**< @brief Rate of 'in-air' and 'landed state'
+                                                updates */
+        double attitude_hz{double(NAN)}; /**< @brief Rate of 'attitude' updates */
+        double camera_attitude_hz{double(NAN)}; /**< @brief Rate of 'camera attitude' updates */
+        double velocity_ned_hz{double(NAN)}; /**< @brief Rate of 'ground speed' updates */
+        double imu_hz{double(NAN)}; /**< @brief Rate of 'IMU' updates */
+        double fixedwing_metrics_hz{
+            double(NAN)}; /**< @brief Rate of 'fixedwing metrics' updates */
+        double ground_truth_hz{double(NAN)}; /**< @brief Rate of 'ground truth' updates */
+        double gps_info_hz{double(NAN)}; /**< @brief Rate of 'GPS' updates */
+        double battery_hz{double(NAN)}; /**< @brief Rate of 'battery' updates */
+        double rc_status_hz{double(NAN)}; /**< @brief Rate of 'RC status' updates */
+        double actuator_control_target_hz{
+            double(NAN)}; /**< @brief Rate of 'actuator control target' updates */
+        double actuator_output_status_hz{
+            double(NAN)}; /**< @brief Rate of 'actuator output status' updates */
+        double odometry_hz{double(NAN)}; /**< @brief Rate of 'odometry' updates */
+        double distance_sensor_hz{double(NAN)}; /**< @brief Rate of 'Distance Sensor' updates */
+        double unix_epoch_time_hz{double(NAN)}; /**< @brief Rate of 'unix epoch time' updates */
+    };
+
+    /**
+     * @brief Set the rates of several updates at once.
+     *
+     * Unlike calling the set_rate functions one after the other, this doesn't wait for one
+     * rate to be acknowledged before requesting the next one.
+     *
+     * This function is non-blocking. See 'set_rates' for the blocking counterpart.
+     */
+    void set_rates_async(const Rates& rates, const Telemetry::ResultCallback callback);
+
+    /**
+     * @brief Set the rates of several updates at once.
+     *
+     * This function is blocking. See 'set_rates_async' for the non-blocking counterpart.
+     *
+     * @return Result of request, the first one which failed if any.
+     */
+    Telemetry::Result set_rates(const Rates& rates) const;
+
+    /**
+     * @brief State of the vehicle at one instant.
+     */
+    struct Snapshot {
+        Telemetry::Position position{}; /**< @brief Position */
+        Telemetry::Position home{}; /**< @brief Home position */
+        Telemetry::PositionVelocityNed
+            position_velocity_ned{}; /**< @brief Position and velocity NED */
+        Telemetry::VelocityNed velocity_ned{}; /**< @brief Velocity NED */
+        Telemetry::Quaternion attitude_quaternion{}; /**< @brief Attitude as quaternion */
+        Telemetry::AngularVelocityBody
+            attitude_angular_velocity_body{}; /**< @brief Angular velocity in body frame */
+        Telemetry::EulerAngle camera_attitude_euler{}; /**< @brief Camera attitude as Euler angle */
+        Telemetry::Imu imu{}; /**< @brief IMU */
+        Telemetry::GroundTruth ground_truth{}; /**< @brief Ground truth */
+        Telemetry::FixedwingMetrics fixedwing_metrics{}; /**< @brief Fixed-wing metrics */
+        Telemetry::GpsInfo gps_info{}; /**< @brief GPS information */
+        Telemetry::Battery battery{}; /**< @brief Battery */
+        Telemetry::Health health{}; /**< @brief Health */
+        Telemetry::RcStatus rc_status{}; /**< @brief RC status */
+        Telemetry::DistanceSensor distance_sensor{}; /**< @brief Distance sensor */
+        Telemetry::LandedState landed_state{
+            Telemetry::LandedState::Unknown}; /**< @brief Landed state */
+        bool in_air{false}; /**< @brief In-air state */
+        bool armed{false}; /**< @brief Armed state */
+        uint64_t unix_epoch_time_us{0}; /**< @brief UNIX epoch time in microseconds */
+    };
+
+    /**
+     * @brief Poll for the latest state of all telemetry at once (non-blocking).
+     *
+     * Unlike polling one value after the other, all values are taken at the same instant.
+     *
+     * @return State of the vehicle.
+     */
+    Snapshot snapshot() const;
+
+private:
+    TelemetryImpl& _impl;
+};
+
+} // namespace mavsdk
@@ -50,6 +50,17 @@ void Telemetry::subscribe_position(PositionCallback callback)
     _impl->position_async(callback);
 }
 
+Telemetry::PositionHandle Telemetry::subscribe_position(
+    PositionCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_position(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_position(PositionHandle handle)
+{
+    _impl->unsubscribe_position(handle);
+}
+
 Telemetry::Position Telemetry::position() const
 {
     return _impl->position();
@@ -60,6 +71,16 @@ void Telemetry::subscribe_home(HomeCallback callback)
     _impl->home_async(callback);
 }
 
+Telemetry::HomeHandle Telemetry::subscribe_home(HomeCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_home(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_home(HomeHandle handle)
+{
+    _impl->unsubscribe_home(handle);
+}
+
 Telemetry::Position Telemetry::home() const
 {
     return _impl->home();
@@ -70,6 +91,16 @@ void Telemetry::subscribe_in_air(InAirCallback callback)
     _impl->in_air_async(callback);
 }
 
+Telemetry::InAirHandle Telemetry::subscribe_in_air(InAirCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_in_air(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_in_air(InAirHandle handle)
+{
+    _impl->unsubscribe_in_air(handle);
+}
+
 bool Telemetry::in_air() const
 {
     return _impl->in_air();
@@ -80,6 +111,17 @@ void Telemetry::subscribe_landed_state(LandedStateCallback callback)
     _impl->landed_state_async(callback);
 }
 
+Telemetry::LandedStateHandle Telemetry::subscribe_landed_state(
+    LandedStateCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_landed_state(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_landed_state(LandedStateHandle handle)
+{
+    _impl->unsubscribe_landed_state(handle);
+}
+
 Telemetry::LandedState Telemetry::landed_state() const
 {
     return _impl->landed_state();
@@ -90,6 +132,16 @@ void Telemetry::subscribe_armed(ArmedCallback callback)
     _impl->armed_async(callback);
 }
 
+Telemetry::ArmedHandle Telemetry::subscribe_armed(ArmedCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_armed(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_armed(ArmedHandle handle)
+{
+    _impl->unsubscribe_armed(handle);
+}
+
 bool Telemetry::armed() const
 {
     return _impl->armed();
@@ -100,6 +152,17 @@ void Telemetry::subscribe_attitude_quaternion(AttitudeQuaternionCallback callbac
     _impl->attitude_quaternion_async(callback);
 }
 
+Telemetry::AttitudeQuaternionHandle Telemetry::subscribe_attitude_quaternion(
+    AttitudeQuaternionCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_attitude_quaternion(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_attitude_quaternion(AttitudeQuaternionHandle handle)
+{
+    _impl->unsubscribe_attitude_quaternion(handle);
+}
+
 Telemetry::Quaternion Telemetry::attitude_quaternion() const
 {
     return _impl->attitude_quaternion();
@@ -110,6 +173,17 @@ void Telemetry::subscribe_attitude_euler(AttitudeEulerCallback callback)
     _impl->attitude_euler_async(callback);
 }
 
+Telemetry::AttitudeEulerHandle Telemetry::subscribe_attitude_euler(
+    AttitudeEulerCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_attitude_euler(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_attitude_euler(AttitudeEulerHandle handle)
+{
+    _impl->unsubscribe_attitude_euler(handle);
+}
+
 Telemetry::EulerAngle Telemetry::attitude_euler() const
 {
     return _impl->attitude_euler();
@@ -121,6 +195,17 @@ void Telemetry::subscribe_attitude_angular_velocity_body(
     _impl->attitude_angular_velocity_body_async(callback);
 }
 
+Telemetry::AttitudeAngularVelocityBodyHandle Telemetry::subscribe_attitude_angular_velocity_body(
+    AttitudeAngularVelocityBodyCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_attitude_angular_velocity_body(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_attitude_angular_velocity_body(AttitudeAngularVelocityBodyHandle handle)
+{
+    _impl->unsubscribe_attitude_angular_velocity_body(handle);
+}
+
 Telemetry::AngularVelocityBody Telemetry::attitude_angular_velocity_body() const
 {
     return _impl->attitude_angular_velocity_body();
@@ -131,6 +216,17 @@ void Telemetry::subscribe_camera_attitude_quaternion(CameraAttitudeQuaternionCal
     _impl->camera_attitude_quaternion_async(callback);
 }
 
+Telemetry::CameraAttitudeQuaternionHandle Telemetry::subscribe_camera_attitude_quaternion(
+    CameraAttitudeQuaternionCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_camera_attitude_quaternion(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_camera_attitude_quaternion(CameraAttitudeQuaternionHandle handle)
+{
+    _impl->unsubscribe_camera_attitude_quaternion(handle);
+}
+
 Telemetry::Quaternion Telemetry::camera_attitude_quaternion() const
 {
     return _impl->camera_attitude_quaternion();
@@ -141,6 +237,17 @@ void Telemetry::subscribe_camera_attitude_euler(CameraAttitudeEulerCallback call
     _impl->camera_attitude_euler_async(callback);
 }
 
+Telemetry::CameraAttitudeEulerHandle Telemetry::subscribe_camera_attitude_euler(
+    CameraAttitudeEulerCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_camera_attitude_euler(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_camera_attitude_euler(CameraAttitudeEulerHandle handle)
+{
+    _impl->unsubscribe_camera_attitude_euler(handle);
+}
+
 Telemetry::EulerAngle Telemetry::camera_attitude_euler() const
 {
     return _impl->camera_attitude_euler();
@@ -151,6 +258,17 @@ void Telemetry::subscribe_velocity_ned(VelocityNedCallback callback)
     _impl->velocity_ned_async(callback);
 }
 
+Telemetry::VelocityNedHandle Telemetry::subscribe_velocity_ned(
+    VelocityNedCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_velocity_ned(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_velocity_ned(VelocityNedHandle handle)
+{
+    _impl->unsubscribe_velocity_ned(handle);
+}
+
 Telemetry::VelocityNed Telemetry::velocity_ned() const
 {
     return _impl->velocity_ned();
@@ -161,6 +279,17 @@ void Telemetry::subscribe_gps_info(GpsInfoCallback callback)
     _impl->gps_info_async(callback);
 }
 
+Telemetry::GpsInfoHandle Telemetry::subscribe_gps_info(
+    GpsInfoCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_gps_info(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_gps_info(GpsInfoHandle handle)
+{
+    _impl->unsubscribe_gps_info(handle);
+}
+
 Telemetry::GpsInfo Telemetry::gps_info() const
 {
     return _impl->gps_info();
@@ -171,6 +300,17 @@ void Telemetry::subscribe_battery(BatteryCallback callback)
     _impl->battery_async(callback);
 }
 
+Telemetry::BatteryHandle Telemetry::subscribe_battery(
+    BatteryCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_battery(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_battery(BatteryHandle handle)
+{
+    _impl->unsubscribe_battery(handle);
+}
+
 Telemetry::Battery Telemetry::battery() const
 {
     return _impl->battery();
@@ -181,6 +321,17 @@ void Telemetry::subscribe_flight_mode(FlightModeCallback callback)
     _impl->flight_mode_async(callback);
 }
 
+Telemetry::FlightModeHandle Telemetry::subscribe_flight_mode(
+    FlightModeCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_flight_mode(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_flight_mode(FlightModeHandle handle)
+{
+    _impl->unsubscribe_flight_mode(handle);
+}
+
 Telemetry::FlightMode Telemetry::flight_mode() const
 {
     return _impl->flight_mode();
@@ -191,6 +342,17 @@ void Telemetry::subscribe_health(HealthCallback callback)
     _impl->health_async(callback);
 }
 
+Telemetry::HealthHandle Telemetry::subscribe_health(
+    HealthCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_health(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_health(HealthHandle handle)
+{
+    _impl->unsubscribe_health(handle);
+}
+
 Telemetry::Health Telemetry::health() const
 {
     return _impl->health();
@@ -201,6 +363,17 @@ void Telemetry::subscribe_rc_status(RcStatusCallback callback)
     _impl->rc_status_async(callback);
 }
 
+Telemetry::RcStatusHandle Telemetry::subscribe_rc_status(
+    RcStatusCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_rc_status(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_rc_status(RcStatusHandle handle)
+{
+    _impl->unsubscribe_rc_status(handle);
+}
+
 Telemetry::RcStatus Telemetry::rc_status() const
 {
     return _impl->rc_status();
@@ -211,6 +384,17 @@ void Telemetry::subscribe_status_text(StatusTextCallback callback)
     _impl->status_text_async(callback);
 }
 
+Telemetry::StatusTextHandle Telemetry::subscribe_status_text(
+    StatusTextCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_status_text(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_status_text(StatusTextHandle handle)
+{
+    _impl->unsubscribe_status_text(handle);
+}
+
 Telemetry::StatusText Telemetry::status_text() const
 {
     return _impl->status_text();
@@ -221,6 +405,17 @@ void Telemetry::subscribe_actuator_control_target(ActuatorControlTargetCallback
     _impl->actuator_control_target_async(callback);
 }
 
+Telemetry::ActuatorControlTargetHandle Telemetry::subscribe_actuator_control_target(
+    ActuatorControlTargetCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_actuator_control_target(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_actuator_control_target(ActuatorControlTargetHandle handle)
+{
+    _impl->unsubscribe_actuator_control_target(handle);
+}
+
 Telemetry::ActuatorControlTarget Telemetry::actuator_control_target() const
 {
     return _impl->actuator_control_target();
@@ -231,6 +426,17 @@ void Telemetry::subscribe_actuator_output_status(ActuatorOutputStatusCallback ca
     _impl->actuator_output_status_async(callback);
 }
 
+Telemetry::ActuatorOutputStatusHandle Telemetry::subscribe_actuator_output_status(
+    ActuatorOutputStatusCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_actuator_output_status(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_actuator_output_status(ActuatorOutputStatusHandle handle)
+{
+    _impl->unsubscribe_actuator_output_status(handle);
+}
+
 Telemetry::ActuatorOutputStatus Telemetry::actuator_output_status() const
 {
     return _impl->actuator_output_status();
@@ -241,6 +447,17 @@ void Telemetry::subscribe_odometry(OdometryCallback callback)
     _impl->odometry_async(callback);
 }
 
+Telemetry::OdometryHandle Telemetry::subscribe_odometry(
+    OdometryCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_odometry(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_odometry(OdometryHandle handle)
+{
+    _impl->unsubscribe_odometry(handle);
+}
+
 Telemetry::Odometry Telemetry::odometry() const
 {
     return _impl->odometry();
@@ -251,6 +468,17 @@ void Telemetry::subscribe_position_velocity_ned(PositionVelocityNedCallback call
     _impl->position_velocity_ned_async(callback);
 }
 
+Telemetry::PositionVelocityNedHandle Telemetry::subscribe_position_velocity_ned(
+    PositionVelocityNedCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_position_velocity_ned(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_position_velocity_ned(PositionVelocityNedHandle handle)
+{
+    _impl->unsubscribe_position_velocity_ned(handle);
+}
+
 Telemetry::PositionVelocityNed Telemetry::position_velocity_ned() const
 {
     return _impl->position_velocity_ned();
@@ -261,6 +489,17 @@ void Telemetry::subscribe_ground_truth(GroundTruthCallback callback)
     _impl->ground_truth_async(callback);
 }
 
+Telemetry::GroundTruthHandle Telemetry::subscribe_ground_truth(
+    GroundTruthCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_ground_truth(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_ground_truth(GroundTruthHandle handle)
+{
+    _impl->unsubscribe_ground_truth(handle);
+}
+
 Telemetry::GroundTruth Telemetry::ground_truth() const
 {
     return _impl->ground_truth();
@@ -271,6 +510,17 @@ void Telemetry::subscribe_fixedwing_metrics(FixedwingMetricsCallback callback)
     _impl->fixedwing_metrics_async(callback);
 }
 
+Telemetry::FixedwingMetricsHandle Telemetry::subscribe_fixedwing_metrics(
+    FixedwingMetricsCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_fixedwing_metrics(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_fixedwing_metrics(FixedwingMetricsHandle handle)
+{
+    _impl->unsubscribe_fixedwing_metrics(handle);
+}
+
 Telemetry::FixedwingMetrics Telemetry::fixedwing_metrics() const
 {
     return _impl->fixedwing_metrics();
@@ -281,6 +531,16 @@ void Telemetry::subscribe_imu(ImuCallback callback)
     _impl->imu_async(callback);
 }
 
+Telemetry::ImuHandle Telemetry::subscribe_imu(ImuCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_imu(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_imu(ImuHandle handle)
+{
+    _impl->unsubscribe_imu(handle);
+}
+
 Telemetry::Imu Telemetry::imu() const
 {
     return _impl->imu();
@@ -291,6 +551,17 @@ void Telemetry::subscribe_health_all_ok(HealthAllOkCallback callback)
     _impl->health_all_ok_async(callback);
 }
 
+Telemetry::HealthAllOkHandle Telemetry::subscribe_health_all_ok(
+    HealthAllOkCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_health_all_ok(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_health_all_ok(HealthAllOkHandle handle)
+{
+    _impl->unsubscribe_health_all_ok(handle);
+}
+
 bool Telemetry::health_all_ok() const
 {
     return _impl->health_all_ok();
@@ -301,6 +572,17 @@ void Telemetry::subscribe_unix_epoch_time(UnixEpochTimeCallback callback)
     _impl->unix_epoch_time_async(callback);
 }
 
+Telemetry::UnixEpochTimeHandle Telemetry::subscribe_unix_epoch_time(
+    UnixEpochTimeCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_unix_epoch_time(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_unix_epoch_time(UnixEpochTimeHandle handle)
+{
+    _impl->unsubscribe_unix_epoch_time(handle);
+}
+
 uint64_t Telemetry::unix_epoch_time() const
 {
     return _impl->unix_epoch_time();
@@ -311,6 +593,17 @@ void Telemetry::subscribe_distance_sensor(DistanceSensorCallback callback)
     _impl->distance_sensor_async(callback);
 }
 
+Telemetry::DistanceSensorHandle Telemetry::subscribe_distance_sensor(
+    DistanceSensorCallback callback, QueuePolicy queue_policy)
+{
+    return _impl->subscribe_distance_sensor(callback, queue_policy);
+}
+
+void Telemetry::unsubscribe_distance_sensor(DistanceSensorHandle handle)
+{
+    _impl->unsubscribe_distance_sensor(handle);
+}
+
 Telemetry::DistanceSensor Telemetry::distance_sensor() const
 {
     return _impl->distance_sensor();
@@ -0,0 +1,24 @@
+#include "plugins/telemetry/telemetry_extension.h"
+#include "telemetry_impl.h"
+
+namespace mavsdk {
+
+TelemetryExtension::TelemetryExtension(const Telemetry& telemetry) : _impl(*telemetry._impl) {}
+
+void TelemetryExtension::set_rates_async(
+    const Rates& rates, const Telemetry::ResultCallback callback)
+{
+    _impl.set_rates_async(rates, callback);
+}
+
+Telemetry::Result TelemetryExtension::set_rates(const Rates& rates) const
+{
+    return _impl.set_rates(rates);
+}
+
+TelemetryExtension::Snapshot TelemetryExtension::snapshot() const
+{
+    return _impl.snapshot();
+}
+
+} // namespace mavsdk
@@ -487,6 +487,63 @@ void TelemetryImpl::set_rate_distance_sensor_async(
         std::bind(&TelemetryImpl::command_result_callback, std::placeholders::_1, callback));
 }
 
+Telemetry::Result TelemetryImpl::set_rates(const TelemetryExtension::Rates& rates)
+{
+    return telemetry_result_from_command_result(_parent->set_msg_rates(message_rates(rates)));
+}
+
+void TelemetryImpl::set_rates_async(
+    const TelemetryExtension::Rates& rates, Telemetry::ResultCallback callback)
+{
+    _parent->set_msg_rates_async(
+        message_rates(rates),
+        std::bind(&TelemetryImpl::command_result_callback, std::placeholders::_1, callback));
+}
+
+std::vector<std::pair<uint16_t, double>>
+TelemetryImpl::message_rates(const TelemetryExtension::Rates& rates)
+{
+    std::vector<std::pair<uint16_t, double>> message_rates;
+
+    const auto add = [&message_rates](uint16_t message_id, double rate_hz) {
+        if (!std::isnan(rate_hz)) {
+            message_rates.emplace_back(message_id, rate_hz);
+        }
+    };
+
+    add(MAVLINK_MSG_ID_LOCAL_POSITION_NED, rates.position_velocity_ned_hz);
+
+    // Position and velocity both come from GLOBAL_POSITION_INT, like in set_rate_position
+    // and set_rate_velocity_ned.
+    if (!std::isnan(rates.position_hz) || !std::isnan(rates.velocity_ned_hz)) {
+        if (!std::isnan(rates.position_hz)) {
+            _position_rate_hz = rates.position_hz;
+        }
+        if (!std::isnan(rates.velocity_ned_hz)) {
+            _velocity_ned_rate_hz = rates.velocity_ned_hz;
+        }
+        add(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, std::max(_position_rate_hz, _velocity_ned_rate_hz));
+    }
+
+    add(MAVLINK_MSG_ID_HOME_POSITION, rates.home_hz);
+    add(MAVLINK_MSG_ID_EXTENDED_SYS_STATE, rates.landed_state_hz);
+    add(MAVLINK_MSG_ID_ATTITUDE_QUATERNION, rates.attitude_hz);
+    add(MAVLINK_MSG_ID_MOUNT_ORIENTATION, rates.camera_attitude_hz);
+    add(MAVLINK_MSG_ID_HIGHRES_IMU, rates.imu_hz);
+    add(MAVLINK_MSG_ID_VFR_HUD, rates.fixedwing_metrics_hz);
+    add(MAVLINK_MSG_ID_HIL_STATE_QUATERNION, rates.ground_truth_hz);
+    add(MAVLINK_MSG_ID_GPS_RAW_INT, rates.gps_info_hz);
+    add(MAVLINK_MSG_ID_SYS_STATUS, rates.battery_hz);
+    add(MAVLINK_MSG_ID_RC_CHANNELS, rates.rc_status_hz);
+    add(MAVLINK_MSG_ID_ACTUATOR_CONTROL_TARGET, rates.actuator_control_target_hz);
+    add(MAVLINK_MSG_ID_ACTUATOR_OUTPUT_STATUS, rates.actuator_output_status_hz);
+    add(MAVLINK_MSG_ID_ODOMETRY, rates.odometry_hz);
+    add(MAVLINK_MSG_ID_DISTANCE_SENSOR, rates.distance_sensor_hz);
+    add(MAVLINK_MSG_ID_UTM_GLOBAL_POSITION, rates.unix_epoch_time_hz);
+
+    return message_rates;
+}
+
 Telemetry::Result
 TelemetryImpl::telemetry_result_from_command_result(MavlinkCommandSender::Result command_result)
 {
@@ -531,12 +588,7 @@ void TelemetryImpl::process_position_velocity_ned(const mavlink_message_t& messa
 
     set_position_velocity_ned(position_velocity);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_position_velocity_ned_subscription) {
-        auto callback = _position_velocity_ned_subscription;
-        auto arg = position_velocity_ned();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _position_velocity_ned_subscriptions.queue(_queue_user_callback, position_velocity_ned());
 
     set_health_local_position(true);
 }
@@ -563,18 +615,9 @@ void TelemetryImpl::process_global_position_int(const mavlink_message_t& message
         set_velocity_ned(velocity);
     }
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_position_subscription) {
-        auto callback = _position_subscription;
-        auto arg = position();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _position_subscriptions.queue(_queue_user_callback, position());
 
-    if (_velocity_ned_subscription) {
-        auto callback = _velocity_ned_subscription;
-        auto arg = velocity_ned();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _velocity_ned_subscriptions.queue(_queue_user_callback, velocity_ned());
 }
 
 void TelemetryImpl::process_home_position(const mavlink_message_t& message)
@@ -591,12 +634,7 @@ void TelemetryImpl::process_home_position(const mavlink_message_t& message)
 
     set_health_home_position(true);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_home_position_subscription) {
-        auto callback = _home_position_subscription;
-        auto arg = home();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _home_subscriptions.queue(_queue_user_callback, home());
 }
 
 void TelemetryImpl::process_attitude(const mavlink_message_t& message)
@@ -618,24 +656,12 @@ void TelemetryImpl::process_attitude(const mavlink_message_t& message)
     auto quaternion = mavsdk::to_quaternion_from_euler_angle(euler_angle);
     set_attitude_quaternion(quaternion);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_attitude_quaternion_angle_subscription) {
-        auto callback = _attitude_quaternion_angle_subscription;
-        auto arg = attitude_quaternion();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_quaternion_subscriptions.queue(_queue_user_callback, attitude_quaternion());
 
-    if (_attitude_euler_angle_subscription) {
-        auto callback = _attitude_euler_angle_subscription;
-        auto arg = attitude_euler();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_euler_subscriptions.queue(_queue_user_callback, attitude_euler());
 
-    if (_attitude_angular_velocity_body_subscription) {
-        auto callback = _attitude_angular_velocity_body_subscription;
-        auto arg = attitude_angular_velocity_body();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_angular_velocity_body_subscriptions.queue(
+        _queue_user_callback, attitude_angular_velocity_body());
 }
 
 void TelemetryImpl::process_attitude_quaternion(const mavlink_message_t& message)
@@ -658,24 +684,12 @@ void TelemetryImpl::process_attitude_quaternion(const mavlink_message_t& message
 
     set_attitude_angular_velocity_body(angular_velocity_body);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_attitude_quaternion_angle_subscription) {
-        auto callback = _attitude_quaternion_angle_subscription;
-        auto arg = attitude_quaternion();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_quaternion_subscriptions.queue(_queue_user_callback, attitude_quaternion());
 
-    if (_attitude_euler_angle_subscription) {
-        auto callback = _attitude_euler_angle_subscription;
-        auto arg = attitude_euler();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_euler_subscriptions.queue(_queue_user_callback, attitude_euler());
 
-    if (_attitude_angular_velocity_body_subscription) {
-        auto callback = _attitude_angular_velocity_body_subscription;
-        auto arg = attitude_angular_velocity_body();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _attitude_angular_velocity_body_subscriptions.queue(
+        _queue_user_callback, attitude_angular_velocity_body());
 }
 
 void TelemetryImpl::process_mount_orientation(const mavlink_message_t& message)
@@ -691,18 +705,10 @@ void TelemetryImpl::process_mount_orientation(const mavlink_message_t& message)
 
     set_camera_attitude_euler_angle(euler_angle);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_camera_attitude_quaternion_subscription) {
-        auto callback = _camera_attitude_quaternion_subscription;
-        auto arg = camera_attitude_quaternion();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _camera_attitude_quaternion_subscriptions.queue(
+        _queue_user_callback, camera_attitude_quaternion());
 
-    if (_camera_attitude_euler_angle_subscription) {
-        auto callback = _camera_attitude_euler_angle_subscription;
-        auto arg = camera_attitude_euler();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _camera_attitude_euler_subscriptions.queue(_queue_user_callback, camera_attitude_euler());
 }
 
 void TelemetryImpl::process_gimbal_device_attitude_status(const mavlink_message_t& message)
@@ -723,21 +729,24 @@ void TelemetryImpl::process_gimbal_device_attitude_status(const mavlink_message_
 
     set_camera_attitude_euler_angle(euler_angle);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_camera_attitude_quaternion_subscription) {
-        auto callback = _camera_attitude_quaternion_subscription;
-        auto arg = camera_attitude_quaternion();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _camera_attitude_quaternion_subscriptions.queue(
+        _queue_user_callback, camera_attitude_quaternion());
 
-    if (_camera_attitude_euler_angle_subscription) {
-        auto callback = _camera_attitude_euler_angle_subscription;
-        auto arg = camera_attitude_euler();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _camera_attitude_euler_subscriptions.queue(_queue_user_callback, camera_attitude_euler());
 }
 
 void TelemetryImpl::process_imu_reading_ned(const mavlink_message_t& message)
+{
+    if (_imu_subscriptions.empty()) {
+        _imu_message.store(message);
+        return;
+    }
+
+    _imu_message.decode(message);
+    _imu_subscriptions.queue(_queue_user_callback, imu());
+}
+
+void TelemetryImpl::decode_imu(const mavlink_message_t& message)
 {
     mavlink_highres_imu_t highres_imu;
     mavlink_msg_highres_imu_decode(&message, &highres_imu);
@@ -754,16 +763,30 @@ void TelemetryImpl::process_imu_reading_ned(const mavlink_message_t& message)
     new_imu.temperature_degc = highres_imu.temperature;
 
     set_imu_reading_ned(new_imu);
+}
+
+void TelemetryImpl::process_gps_raw_int(const mavlink_message_t& message)
+{
+    // TODO: This is just an interim hack, we will have to look at
+    //       estimator flags in order to decide if the position
+    //       estimate is good enough.
+    const bool gps_ok =
+        ((mavlink_msg_gps_raw_int_get_fix_type(&message) >= 3) &&
+         (mavlink_msg_gps_raw_int_get_satellites_visible(&message) >= 8));
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_imu_reading_ned_subscription) {
-        auto callback = _imu_reading_ned_subscription;
-        auto arg = imu();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
+    set_health_global_position(gps_ok);
+
+    if (_gps_info_subscriptions.empty()) {
+        _gps_info_message.store(message);
+    } else {
+        _gps_info_message.decode(message);
+        _gps_info_subscriptions.queue(_queue_user_callback, gps_info());
     }
+
+    _parent->refresh_timeout_handler(_gps_raw_timeout_cookie);
 }
 
-void TelemetryImpl::process_gps_raw_int(const mavlink_message_t& message)
+void TelemetryImpl::decode_gps_info(const mavlink_message_t& message)
 {
     mavlink_gps_raw_int_t gps_raw_int;
     mavlink_msg_gps_raw_int_decode(&message, &gps_raw_int);
@@ -802,27 +825,20 @@ void TelemetryImpl::process_gps_raw_int(const mavlink_message_t& message)
     new_gps_info.num_satellites = gps_raw_int.satellites_visible;
     new_gps_info.fix_type = fix_type;
     set_gps_info(new_gps_info);
+}
 
-    // TODO: This is just an interim hack, we will have to look at
-    //       estimator flags in order to decide if the position
-    //       estimate is good enough.
-    const bool gps_ok = ((gps_raw_int.fix_type >= 3) && (gps_raw_int.satellites_visible >= 8));
-
-    set_health_global_position(gps_ok);
-
-    {
-        std::lock_guard<std::mutex> lock(_subscription_mutex);
-        if (_gps_info_subscription) {
-            auto callback = _gps_info_subscription;
-            auto arg = gps_info();
-            _parent->call_user_callback([callback, arg]() { callback(arg); });
-        }
+void TelemetryImpl::process_ground_truth(const mavlink_message_t& message)
+{
+    if (_ground_truth_subscriptions.empty()) {
+        _ground_truth_message.store(message);
+        return;
     }
 
-    _parent->refresh_timeout_handler(_gps_raw_timeout_cookie);
+    _ground_truth_message.decode(message);
+    _ground_truth_subscriptions.queue(_queue_user_callback, ground_truth());
 }
 
-void TelemetryImpl::process_ground_truth(const mavlink_message_t& message)
+void TelemetryImpl::decode_ground_truth(const mavlink_message_t& message)
 {
     mavlink_hil_state_quaternion_t hil_state_quaternion;
     mavlink_msg_hil_state_quaternion_decode(&message, &hil_state_quaternion);
@@ -833,13 +849,6 @@ void TelemetryImpl::process_ground_truth(const mavlink_message_t& message)
     new_ground_truth.absolute_altitude_m = hil_state_quaternion.alt * 1e-3f;
 
     set_ground_truth(new_ground_truth);
-
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_ground_truth_subscription) {
-        auto callback = _ground_truth_subscription;
-        auto arg = ground_truth();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
 }
 
 void TelemetryImpl::process_extended_sys_state(const mavlink_message_t& message)
@@ -852,12 +861,7 @@ void TelemetryImpl::process_extended_sys_state(const mavlink_message_t& message)
         set_landed_state(landed_state);
     }
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_landed_state_subscription) {
-        auto callback = _landed_state_subscription;
-        auto arg = landed_state();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _landed_state_subscriptions.queue(_queue_user_callback, landed_state());
 
     if (extended_sys_state.landed_state == MAV_LANDED_STATE_IN_AIR ||
         extended_sys_state.landed_state == MAV_LANDED_STATE_TAKEOFF ||
@@ -868,13 +872,20 @@ void TelemetryImpl::process_extended_sys_state(const mavlink_message_t& message)
     }
     // If landed_state is undefined, we use what we have received last.
 
-    if (_in_air_subscription) {
-        auto callback = _in_air_subscription;
-        auto arg = in_air();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _in_air_subscriptions.queue(_queue_user_callback, in_air());
 }
 void TelemetryImpl::process_fixedwing_metrics(const mavlink_message_t& message)
+{
+    if (_fixedwing_metrics_subscriptions.empty()) {
+        _fixedwing_metrics_message.store(message);
+        return;
+    }
+
+    _fixedwing_metrics_message.decode(message);
+    _fixedwing_metrics_subscriptions.queue(_queue_user_callback, fixedwing_metrics());
+}
+
+void TelemetryImpl::decode_fixedwing_metrics(const mavlink_message_t& message)
 {
     mavlink_vfr_hud_t vfr_hud;
     mavlink_msg_vfr_hud_decode(&message, &vfr_hud);
@@ -885,16 +896,20 @@ void TelemetryImpl::process_fixedwing_metrics(const mavlink_message_t& message)
     new_fixedwing_metrics.climb_rate_m_s = vfr_hud.climb;
 
     set_fixedwing_metrics(new_fixedwing_metrics);
+}
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_fixedwing_metrics_subscription) {
-        auto callback = _fixedwing_metrics_subscription;
-        auto arg = fixedwing_metrics();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
+void TelemetryImpl::process_sys_status(const mavlink_message_t& message)
+{
+    if (_battery_subscriptions.empty()) {
+        _battery_message.store(message);
+        return;
     }
+
+    _battery_message.decode(message);
+    _battery_subscriptions.queue(_queue_user_callback, battery());
 }
 
-void TelemetryImpl::process_sys_status(const mavlink_message_t& message)
+void TelemetryImpl::decode_battery(const mavlink_message_t& message)
 {
     mavlink_sys_status_t sys_status;
     mavlink_msg_sys_status_decode(&message, &sys_status);
@@ -905,13 +920,6 @@ void TelemetryImpl::process_sys_status(const mavlink_message_t& message)
     new_battery.remaining_percent = sys_status.battery_remaining * 1e-2f;
 
     set_battery(new_battery);
-
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_battery_subscription) {
-        auto callback = _battery_subscription;
-        auto arg = battery();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
 }
 
 void TelemetryImpl::process_heartbeat(const mavlink_message_t& message)
@@ -925,32 +933,16 @@ void TelemetryImpl::process_heartbeat(const mavlink_message_t& message)
 
     set_armed(((heartbeat.base_mode & MAV_MODE_FLAG_SAFETY_ARMED) ? true : false));
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_armed_subscription) {
-        auto callback = _armed_subscription;
-        auto arg = armed();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _armed_subscriptions.queue(_queue_user_callback, armed());
 
-    if (_flight_mode_subscription) {
-        auto callback = _flight_mode_subscription;
-        // The flight mode is already parsed in SystemImpl, so we can take it
-        // from there.  This assumes that SystemImpl gets called first because
-        // it's earlier in the callback list.
-        auto arg = telemetry_flight_mode_from_flight_mode(_parent->get_flight_mode());
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    // The flight mode is already parsed in SystemImpl, so we can take it
+    // from there.  This assumes that SystemImpl gets called first because
+    // it's earlier in the callback list.
+    _flight_mode_subscriptions.queue(
+        _queue_user_callback, telemetry_flight_mode_from_flight_mode(_parent->get_flight_mode()));
 
-    if (_health_subscription) {
-        auto callback = _health_subscription;
-        auto arg = health();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
-    if (_health_all_ok_subscription) {
-        auto callback = _health_all_ok_subscription;
-        auto arg = health_all_ok();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _health_subscriptions.queue(_queue_user_callback, health());
+    _health_all_ok_subscriptions.queue(_queue_user_callback, health_all_ok());
 }
 
 void TelemetryImpl::process_statustext(const mavlink_message_t& message)
@@ -1002,10 +994,7 @@ void TelemetryImpl::process_statustext(const mavlink_message_t& message)
 
     set_status_text(new_status_text);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_status_text_subscription) {
-        _status_text_subscription(status_text());
-    }
+    _status_text_subscriptions.queue(_queue_user_callback, status_text());
 }
 
 void TelemetryImpl::process_rc_channels(const mavlink_message_t& message)
@@ -1016,12 +1005,7 @@ void TelemetryImpl::process_rc_channels(const mavlink_message_t& message)
     bool rc_ok = (rc_channels.chancount > 0);
     set_rc_status(rc_ok, rc_channels.rssi);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_rc_status_subscription) {
-        auto callback = _rc_status_subscription;
-        auto arg = rc_status();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _rc_status_subscriptions.queue(_queue_user_callback, rc_status());
 
     _parent->refresh_timeout_handler(_rc_channels_timeout_cookie);
 }
@@ -1033,65 +1017,79 @@ void TelemetryImpl::process_unix_epoch_time(const mavlink_message_t& message)
 
     set_unix_epoch_time_us(utm_global_position.time);
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_unix_epoch_time_subscription) {
-        auto callback = _unix_epoch_time_subscription;
-        auto arg = unix_epoch_time();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
+    _unix_epoch_time_subscriptions.queue(_queue_user_callback, unix_epoch_time());
 
     _parent->refresh_timeout_handler(_unix_epoch_timeout_cookie);
 }
 
 void TelemetryImpl::process_actuator_control_target(const mavlink_message_t& message)
+{
+    if (_actuator_control_target_subscriptions.empty()) {
+        _actuator_control_target_message.store(message);
+        return;
+    }
+
+    _actuator_control_target_message.decode(message);
+    _actuator_control_target_subscriptions.queue(_queue_user_callback, actuator_control_target());
+}
+
+void TelemetryImpl::decode_actuator_control_target(const mavlink_message_t& message)
 {
     mavlink_set_actuator_control_target_t target;
     mavlink_msg_set_actuator_control_target_decode(&message, &target);
 
-    uint32_t group = target.group_mlx;
-    std::vector<float> controls;
+    Telemetry::ActuatorControlTarget actuator_control_target{};
+    actuator_control_target.group = target.group_mlx;
 
     const unsigned control_size = sizeof(target.controls) / sizeof(target.controls[0]);
     // Can't use std::copy because target is packed.
     for (std::size_t i = 0; i < control_size; ++i) {
-        controls.push_back(target.controls[i]);
+        actuator_control_target.controls.push_back(target.controls[i]);
     }
 
-    set_actuator_control_target(group, controls);
+    set_actuator_control_target(actuator_control_target);
+}
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_actuator_control_target_subscription) {
-        auto callback = _actuator_control_target_subscription;
-        auto arg = actuator_control_target();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
+void TelemetryImpl::process_actuator_output_status(const mavlink_message_t& message)
+{
+    if (_actuator_output_status_subscriptions.empty()) {
+        _actuator_output_status_message.store(message);
+        return;
     }
+
+    _actuator_output_status_message.decode(message);
+    _actuator_output_status_subscriptions.queue(_queue_user_callback, actuator_output_status());
 }
 
-void TelemetryImpl::process_actuator_output_status(const mavlink_message_t& message)
+void TelemetryImpl::decode_actuator_output_status(const mavlink_message_t& message)
 {
     mavlink_actuator_output_status_t status;
     mavlink_msg_actuator_output_status_decode(&message, &status);
 
-    uint32_t active = status.active;
-    std::vector<float> actuators;
+    Telemetry::ActuatorOutputStatus actuator_output_status{};
+    actuator_output_status.active = status.active;
 
     const unsigned actuators_size = sizeof(status.actuator) / sizeof(status.actuator[0]);
     // Can't use std::copy because status is packed.
     for (std::size_t i = 0; i < actuators_size; ++i) {
-        actuators.push_back(status.actuator[i]);
+        actuator_output_status.actuator.push_back(status.actuator[i]);
     }
 
-    set_actuator_output_status(active, actuators);
+    set_actuator_output_status(actuator_output_status);
+}
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_actuator_output_status_subscription) {
-        auto callback = _actuator_output_status_subscription;
-        auto arg = actuator_output_status();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
+void TelemetryImpl::process_odometry(const mavlink_message_t& message)
+{
+    if (_odometry_subscriptions.empty()) {
+        _odometry_message.store(message);
+        return;
     }
+
+    _odometry_message.decode(message);
+    _odometry_subscriptions.queue(_queue_user_callback, odometry());
 }
 
-void TelemetryImpl::process_odometry(const mavlink_message_t& message)
+void TelemetryImpl::decode_odometry(const mavlink_message_t& message)
 {
     mavlink_odometry_t odometry_msg;
     mavlink_msg_odometry_decode(&message, &odometry_msg);
@@ -1135,16 +1133,20 @@ void TelemetryImpl::process_odometry(const mavlink_message_t& message)
     }
 
     set_odometry(odometry_struct);
+}
 
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_odometry_subscription) {
-        auto callback = _odometry_subscription;
-        auto arg = odometry();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
+void TelemetryImpl::process_distance_sensor(const mavlink_message_t& message)
+{
+    if (_distance_sensor_subscriptions.empty()) {
+        _distance_sensor_message.store(message);
+        return;
     }
+
+    _distance_sensor_message.decode(message);
+    _distance_sensor_subscriptions.queue(_queue_user_callback, distance_sensor());
 }
 
-void TelemetryImpl::process_distance_sensor(const mavlink_message_t& message)
+void TelemetryImpl::decode_distance_sensor(const mavlink_message_t& message)
 {
     mavlink_distance_sensor_t distance_sensor_msg;
     mavlink_msg_distance_sensor_decode(&message, &distance_sensor_msg);
@@ -1156,13 +1158,6 @@ void TelemetryImpl::process_distance_sensor(const mavlink_message_t& message)
     distance_sensor_struct.current_distance_m = distance_sensor_msg.current_distance;
 
     set_distance_sensor(distance_sensor_struct);
-
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    if (_distance_sensor_subscription) {
-        auto callback = _distance_sensor_subscription;
-        auto arg = distance_sensor();
-        _parent->call_user_callback([callback, arg]() { callback(arg); });
-    }
 }
 
 Telemetry::LandedState
@@ -1306,53 +1301,47 @@ void TelemetryImpl::receive_unix_epoch_timeout()
 
 Telemetry::PositionVelocityNed TelemetryImpl::position_velocity_ned() const
 {
-    std::lock_guard<std::mutex> lock(_position_velocity_ned_mutex);
-    return _position_velocity_ned;
+    return _state.load(&TelemetryExtension::Snapshot::position_velocity_ned);
 }
 
 void TelemetryImpl::set_position_velocity_ned(Telemetry::PositionVelocityNed position_velocity_ned)
 {
-    std::lock_guard<std::mutex> lock(_position_velocity_ned_mutex);
-    _position_velocity_ned = position_velocity_ned;
+    _state.store(&TelemetryExtension::Snapshot::position_velocity_ned, position_velocity_ned);
 }
 
 Telemetry::Position TelemetryImpl::position() const
 {
-    std::lock_guard<std::mutex> lock(_position_mutex);
-    return _position;
+    return _state.load(&TelemetryExtension::Snapshot::position);
 }
 
 void TelemetryImpl::set_position(Telemetry::Position position)
 {
-    std::lock_guard<std::mutex> lock(_position_mutex);
-    _position = position;
+    _state.store(&TelemetryExtension::Snapshot::position, position);
 }
 
 Telemetry::Position TelemetryImpl::home() const
 {
-    std::lock_guard<std::mutex> lock(_home_position_mutex);
-    return _home_position;
+    return _state.load(&TelemetryExtension::Snapshot::home);
 }
 
 void TelemetryImpl::set_home_position(Telemetry::Position home_position)
 {
-    std::lock_guard<std::mutex> lock(_home_position_mutex);
-    _home_position = home_position;
+    _state.store(&TelemetryExtension::Snapshot::home, home_position);
 }
 
 bool TelemetryImpl::armed() const
 {
-    return _armed;
+    return _state.load(&TelemetryExtension::Snapshot::armed);
 }
 
 bool TelemetryImpl::in_air() const
 {
-    return _in_air;
+    return _state.load(&TelemetryExtension::Snapshot::in_air);
 }
 
 void TelemetryImpl::set_in_air(bool in_air_new)
 {
-    _in_air = in_air_new;
+    _state.store(&TelemetryExtension::Snapshot::in_air, in_air_new);
 }
 
 void TelemetryImpl::set_status_text(Telemetry::StatusText status_text)
@@ -1369,133 +1358,114 @@ Telemetry::StatusText TelemetryImpl::status_text() const
 
 void TelemetryImpl::set_armed(bool armed_new)
 {
-    _armed = armed_new;
+    _state.store(&TelemetryExtension::Snapshot::armed, armed_new);
 }
 
 Telemetry::Quaternion TelemetryImpl::attitude_quaternion() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    return _attitude_quaternion;
+    return _state.load(&TelemetryExtension::Snapshot::attitude_quaternion);
 }
 
 Telemetry::AngularVelocityBody TelemetryImpl::attitude_angular_velocity_body() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_angular_velocity_body_mutex);
-    return _attitude_angular_velocity_body;
+    return _state.load(&TelemetryExtension::Snapshot::attitude_angular_velocity_body);
 }
 
 Telemetry::GroundTruth TelemetryImpl::ground_truth() const
 {
-    std::lock_guard<std::mutex> lock(_ground_truth_mutex);
-    return _ground_truth;
+    _ground_truth_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::ground_truth);
 }
 
 Telemetry::FixedwingMetrics TelemetryImpl::fixedwing_metrics() const
 {
-    std::lock_guard<std::mutex> lock(_fixedwing_metrics_mutex);
-    return _fixedwing_metrics;
+    _fixedwing_metrics_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::fixedwing_metrics);
 }
 
 Telemetry::EulerAngle TelemetryImpl::attitude_euler() const
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    Telemetry::EulerAngle euler = to_euler_angle_from_quaternion(_attitude_quaternion);
-
-    return euler;
+    return to_euler_angle_from_quaternion(attitude_quaternion());
 }
 
 void TelemetryImpl::set_attitude_quaternion(Telemetry::Quaternion quaternion)
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    _attitude_quaternion = quaternion;
+    _state.store(&TelemetryExtension::Snapshot::attitude_quaternion, quaternion);
 }
 
 void TelemetryImpl::set_attitude_angular_velocity_body(
     Telemetry::AngularVelocityBody angular_velocity_body)
 {
-    std::lock_guard<std::mutex> lock(_attitude_quaternion_mutex);
-    _attitude_angular_velocity_body = angular_velocity_body;
+    _state.store(
+        &TelemetryExtension::Snapshot::attitude_angular_velocity_body, angular_velocity_body);
 }
 
 void TelemetryImpl::set_ground_truth(Telemetry::GroundTruth ground_truth)
 {
-    std::lock_guard<std::mutex> lock(_ground_truth_mutex);
-    _ground_truth = ground_truth;
+    _state.store(&TelemetryExtension::Snapshot::ground_truth, ground_truth);
 }
 
 void TelemetryImpl::set_fixedwing_metrics(Telemetry::FixedwingMetrics fixedwing_metrics)
 {
-    std::lock_guard<std::mutex> lock(_fixedwing_metrics_mutex);
-    _fixedwing_metrics = fixedwing_metrics;
+    _state.store(&TelemetryExtension::Snapshot::fixedwing_metrics, fixedwing_metrics);
 }
 
 Telemetry::Quaternion TelemetryImpl::camera_attitude_quaternion() const
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-    Telemetry::Quaternion quaternion = to_quaternion_from_euler_angle(_camera_attitude_euler_angle);
-
-    return quaternion;
+    return to_quaternion_from_euler_angle(camera_attitude_euler());
 }
 
 Telemetry::EulerAngle TelemetryImpl::camera_attitude_euler() const
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-
-    return _camera_attitude_euler_angle;
+    return _state.load(&TelemetryExtension::Snapshot::camera_attitude_euler);
 }
 
 void TelemetryImpl::set_camera_attitude_euler_angle(Telemetry::EulerAngle euler_angle)
 {
-    std::lock_guard<std::mutex> lock(_camera_attitude_euler_angle_mutex);
-    _camera_attitude_euler_angle = euler_angle;
+    _state.store(&TelemetryExtension::Snapshot::camera_attitude_euler, euler_angle);
 }
 
 Telemetry::VelocityNed TelemetryImpl::velocity_ned() const
 {
-    std::lock_guard<std::mutex> lock(_velocity_ned_mutex);
-    return _velocity_ned;
+    return _state.load(&TelemetryExtension::Snapshot::velocity_ned);
 }
 
 void TelemetryImpl::set_velocity_ned(Telemetry::VelocityNed velocity_ned)
 {
-    std::lock_guard<std::mutex> lock(_velocity_ned_mutex);
-    _velocity_ned = velocity_ned;
+    _state.store(&TelemetryExtension::Snapshot::velocity_ned, velocity_ned);
 }
 
 Telemetry::Imu TelemetryImpl::imu() const
 {
-    std::lock_guard<std::mutex> lock(_imu_reading_ned_mutex);
-    return _imu_reading_ned;
+    _imu_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::imu);
 }
 
 void TelemetryImpl::set_imu_reading_ned(Telemetry::Imu imu_reading_ned)
 {
-    std::lock_guard<std::mutex> lock(_imu_reading_ned_mutex);
-    _imu_reading_ned = imu_reading_ned;
+    _state.store(&TelemetryExtension::Snapshot::imu, imu_reading_ned);
 }
 
 Telemetry::GpsInfo TelemetryImpl::gps_info() const
 {
-    std::lock_guard<std::mutex> lock(_gps_info_mutex);
-    return _gps_info;
+    _gps_info_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::gps_info);
 }
 
 void TelemetryImpl::set_gps_info(Telemetry::GpsInfo gps_info)
 {
-    std::lock_guard<std::mutex> lock(_gps_info_mutex);
-    _gps_info = gps_info;
+    _state.store(&TelemetryExtension::Snapshot::gps_info, gps_info);
 }
 
 Telemetry::Battery TelemetryImpl::battery() const
 {
-    std::lock_guard<std::mutex> lock(_battery_mutex);
-    return _battery;
+    _battery_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::battery);
 }
 
 void TelemetryImpl::set_battery(Telemetry::Battery battery)
 {
-    std::lock_guard<std::mutex> lock(_battery_mutex);
-    _battery = battery;
+    _state.store(&TelemetryExtension::Snapshot::battery, battery);
 }
 
 Telemetry::FlightMode TelemetryImpl::flight_mode() const
@@ -1505,17 +1475,16 @@ Telemetry::FlightMode TelemetryImpl::flight_mode() const
 
 Telemetry::Health TelemetryImpl::health() const
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    return _health;
+    return _state.load(&TelemetryExtension::Snapshot::health);
 }
 
 bool TelemetryImpl::health_all_ok() const
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    if (_health.is_gyrometer_calibration_ok && _health.is_accelerometer_calibration_ok &&
-        _health.is_magnetometer_calibration_ok && _health.is_level_calibration_ok &&
-        _health.is_local_position_ok && _health.is_global_position_ok &&
-        _health.is_home_position_ok) {
+    const auto health = _state.load(&TelemetryExtension::Snapshot::health);
+    if (health.is_gyrometer_calibration_ok && health.is_accelerometer_calibration_ok &&
+        health.is_magnetometer_calibration_ok && health.is_level_calibration_ok &&
+        health.is_local_position_ok && health.is_global_position_ok &&
+        health.is_home_position_ok) {
         return true;
     } else {
         return false;
@@ -1524,303 +1493,584 @@ bool TelemetryImpl::health_all_ok() const
 
 Telemetry::RcStatus TelemetryImpl::rc_status() const
 {
-    std::lock_guard<std::mutex> lock(_rc_status_mutex);
-    return _rc_status;
+    return _state.load(&TelemetryExtension::Snapshot::rc_status);
 }
 
 uint64_t TelemetryImpl::unix_epoch_time() const
 {
-    std::lock_guard<std::mutex> lock(_unix_epoch_time_mutex);
-    return _unix_epoch_time_us;
+    return _state.load(&TelemetryExtension::Snapshot::unix_epoch_time_us);
+}
+
+TelemetryExtension::Snapshot TelemetryImpl::snapshot() const
+{
+    _imu_message.decode_pending();
+    _gps_info_message.decode_pending();
+    _ground_truth_message.decode_pending();
+    _fixedwing_metrics_message.decode_pending();
+    _battery_message.decode_pending();
+    _distance_sensor_message.decode_pending();
+    return _state.load();
 }
 
 Telemetry::ActuatorControlTarget TelemetryImpl::actuator_control_target() const
 {
-    std::lock_guard<std::mutex> lock(_actuator_control_target_mutex);
-    return _actuator_control_target;
+    _actuator_control_target_message.decode_pending();
+    return _actuator_control_target.load();
 }
 
 Telemetry::ActuatorOutputStatus TelemetryImpl::actuator_output_status() const
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    return _actuator_output_status;
+    _actuator_output_status_message.decode_pending();
+    return _actuator_output_status.load();
 }
 
 Telemetry::Odometry TelemetryImpl::odometry() const
 {
-    std::lock_guard<std::mutex> lock(_odometry_mutex);
-    return _odometry;
+    _odometry_message.decode_pending();
+    return _odometry.load();
 }
 
 Telemetry::DistanceSensor TelemetryImpl::distance_sensor() const
 {
-    std::lock_guard<std::mutex> lock(_distance_sensor_mutex);
-    return _distance_sensor;
+    _distance_sensor_message.decode_pending();
+    return _state.load(&TelemetryExtension::Snapshot::distance_sensor);
 }
 
 void TelemetryImpl::set_health_local_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_local_position_ok = ok;
+    _state.update(&TelemetryExtension::Snapshot::health, [ok](Telemetry::Health& health) {
+        health.is_local_position_ok = ok;
+    });
 }
 
 void TelemetryImpl::set_health_global_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_global_position_ok = ok;
+    _state.update(&TelemetryExtension::Snapshot::health, [ok](Telemetry::Health& health) {
+        health.is_global_position_ok = ok;
+    });
 }
 
 void TelemetryImpl::set_health_home_position(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_home_position_ok = ok;
+    _state.update(&TelemetryExtension::Snapshot::health, [ok](Telemetry::Health& health) {
+        health.is_home_position_ok = ok;
+    });
 }
 
 void TelemetryImpl::set_health_gyrometer_calibration(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_gyrometer_calibration_ok = (ok || _hitl_enabled);
+    _state.update(&TelemetryExtension::Snapshot::health, [this, ok](Telemetry::Health& health) {
+        health.is_gyrometer_calibration_ok = (ok || _hitl_enabled);
+    });
 }
 
 void TelemetryImpl::set_health_accelerometer_calibration(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_accelerometer_calibration_ok = (ok || _hitl_enabled);
+    _state.update(&TelemetryExtension::Snapshot::health, [this, ok](Telemetry::Health& health) {
+        health.is_accelerometer_calibration_ok = (ok || _hitl_enabled);
+    });
 }
 
 void TelemetryImpl::set_health_magnetometer_calibration(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_magnetometer_calibration_ok = (ok || _hitl_enabled);
+    _state.update(&TelemetryExtension::Snapshot::health, [this, ok](Telemetry::Health& health) {
+        health.is_magnetometer_calibration_ok = (ok || _hitl_enabled);
+    });
 }
 
 void TelemetryImpl::set_health_level_calibration(bool ok)
 {
-    std::lock_guard<std::mutex> lock(_health_mutex);
-    _health.is_level_calibration_ok = (ok || _hitl_enabled);
+    _state.update(&TelemetryExtension::Snapshot::health, [this, ok](Telemetry::Health& health) {
+        health.is_level_calibration_ok = (ok || _hitl_enabled);
+    });
 }
 
 Telemetry::LandedState TelemetryImpl::landed_state() const
 {
-    std::lock_guard<std::mutex> lock(_landed_state_mutex);
-    return _landed_state;
+    return _state.load(&TelemetryExtension::Snapshot::landed_state);
 }
 
 void TelemetryImpl::set_landed_state(Telemetry::LandedState landed_state)
 {
-    std::lock_guard<std::mutex> lock(_landed_state_mutex);
-    _landed_state = landed_state;
+    _state.store(&TelemetryExtension::Snapshot::landed_state, landed_state);
 }
 
 void TelemetryImpl::set_rc_status(bool available, float signal_strength_percent)
 {
-    std::lock_guard<std::mutex> lock(_rc_status_mutex);
-
-    if (available) {
-        _rc_status.was_available_once = true;
-        _rc_status.signal_strength_percent = signal_strength_percent;
-    } else {
-        _rc_status.signal_strength_percent = 0.0f;
-    }
+    _state.update(&TelemetryExtension::Snapshot::rc_status, [&](Telemetry::RcStatus& rc_status) {
+        if (available) {
+            rc_status.was_available_once = true;
+            rc_status.signal_strength_percent = signal_strength_percent;
+        } else {
+            rc_status.signal_strength_percent = 0.0f;
+        }
 
-    _rc_status.is_available = available;
+        rc_status.is_available = available;
+    });
 }
 
 void TelemetryImpl::set_unix_epoch_time_us(uint64_t time_us)
 {
-    std::lock_guard<std::mutex> lock(_unix_epoch_time_mutex);
-    _unix_epoch_time_us = time_us;
+    _state.store(&TelemetryExtension::Snapshot::unix_epoch_time_us, time_us);
 }
 
-void TelemetryImpl::set_actuator_control_target(uint8_t group, const std::vector<float>& controls)
+void TelemetryImpl::set_actuator_control_target(const Telemetry::ActuatorControlTarget& target)
 {
-    std::lock_guard<std::mutex> lock(_actuator_control_target_mutex);
-    _actuator_control_target.group = group;
-    _actuator_control_target.controls = controls;
+    _actuator_control_target.store(target);
 }
 
-void TelemetryImpl::set_actuator_output_status(uint32_t active, const std::vector<float>& actuators)
+void TelemetryImpl::set_actuator_output_status(const Telemetry::ActuatorOutputStatus& status)
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    _actuator_output_status.active = active;
-    _actuator_output_status.actuator = actuators;
+    _actuator_output_status.store(status);
 }
 
-void TelemetryImpl::set_odometry(Telemetry::Odometry& odometry)
+void TelemetryImpl::set_odometry(const Telemetry::Odometry& odometry)
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    _odometry = odometry;
+    _odometry.store(odometry);
 }
 
 void TelemetryImpl::set_distance_sensor(Telemetry::DistanceSensor& distance_sensor)
 {
-    std::lock_guard<std::mutex> lock(_actuator_output_status_mutex);
-    _distance_sensor = distance_sensor;
+    _state.store(&TelemetryExtension::Snapshot::distance_sensor, distance_sensor);
 }
 
 void TelemetryImpl::position_velocity_ned_async(Telemetry::PositionVelocityNedCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _position_velocity_ned_subscription = callback;
+    _position_velocity_ned_subscriptions.set(callback);
+}
+
+Telemetry::PositionVelocityNedHandle TelemetryImpl::subscribe_position_velocity_ned(
+    const Telemetry::PositionVelocityNedCallback& callback, QueuePolicy queue_policy)
+{
+    return _position_velocity_ned_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_position_velocity_ned(Telemetry::PositionVelocityNedHandle handle)
+{
+    _position_velocity_ned_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::position_async(Telemetry::PositionCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _position_subscription = callback;
+    _position_subscriptions.set(callback);
+}
+
+Telemetry::PositionHandle TelemetryImpl::subscribe_position(
+    const Telemetry::PositionCallback& callback, QueuePolicy queue_policy)
+{
+    return _position_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_position(Telemetry::PositionHandle handle)
+{
+    _position_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::home_async(Telemetry::PositionCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _home_position_subscription = callback;
+    _home_subscriptions.set(callback);
+}
+
+Telemetry::HomeHandle TelemetryImpl::subscribe_home(
+    const Telemetry::PositionCallback& callback, QueuePolicy queue_policy)
+{
+    return _home_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_home(Telemetry::HomeHandle handle)
+{
+    _home_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::in_air_async(Telemetry::InAirCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _in_air_subscription = callback;
+    _in_air_subscriptions.set(callback);
+}
+
+Telemetry::InAirHandle TelemetryImpl::subscribe_in_air(
+    const Telemetry::InAirCallback& callback, QueuePolicy queue_policy)
+{
+    return _in_air_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_in_air(Telemetry::InAirHandle handle)
+{
+    _in_air_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::status_text_async(Telemetry::StatusTextCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _status_text_subscription = callback;
+    _status_text_subscriptions.set(callback);
+}
+
+Telemetry::StatusTextHandle TelemetryImpl::subscribe_status_text(
+    const Telemetry::StatusTextCallback& callback, QueuePolicy queue_policy)
+{
+    return _status_text_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_status_text(Telemetry::StatusTextHandle handle)
+{
+    _status_text_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::armed_async(Telemetry::ArmedCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _armed_subscription = callback;
+    _armed_subscriptions.set(callback);
+}
+
+Telemetry::ArmedHandle TelemetryImpl::subscribe_armed(
+    const Telemetry::ArmedCallback& callback, QueuePolicy queue_policy)
+{
+    return _armed_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_armed(Telemetry::ArmedHandle handle)
+{
+    _armed_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::attitude_quaternion_async(Telemetry::AttitudeQuaternionCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _attitude_quaternion_angle_subscription = callback;
+    _attitude_quaternion_subscriptions.set(callback);
+}
+
+Telemetry::AttitudeQuaternionHandle TelemetryImpl::subscribe_attitude_quaternion(
+    const Telemetry::AttitudeQuaternionCallback& callback, QueuePolicy queue_policy)
+{
+    return _attitude_quaternion_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_attitude_quaternion(Telemetry::AttitudeQuaternionHandle handle)
+{
+    _attitude_quaternion_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::attitude_euler_async(Telemetry::AttitudeEulerCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _attitude_euler_angle_subscription = callback;
+    _attitude_euler_subscriptions.set(callback);
+}
+
+Telemetry::AttitudeEulerHandle TelemetryImpl::subscribe_attitude_euler(
+    const Telemetry::AttitudeEulerCallback& callback, QueuePolicy queue_policy)
+{
+    return _attitude_euler_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_attitude_euler(Telemetry::AttitudeEulerHandle handle)
+{
+    _attitude_euler_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::attitude_angular_velocity_body_async(
     Telemetry::AttitudeAngularVelocityBodyCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _attitude_angular_velocity_body_subscription = callback;
+    _attitude_angular_velocity_body_subscriptions.set(callback);
+}
+
+Telemetry::AttitudeAngularVelocityBodyHandle
+TelemetryImpl::subscribe_attitude_angular_velocity_body(
+    const Telemetry::AttitudeAngularVelocityBodyCallback& callback, QueuePolicy queue_policy)
+{
+    return _attitude_angular_velocity_body_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_attitude_angular_velocity_body(
+    Telemetry::AttitudeAngularVelocityBodyHandle handle)
+{
+    _attitude_angular_velocity_body_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::fixedwing_metrics_async(Telemetry::FixedwingMetricsCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _fixedwing_metrics_subscription = callback;
+    _fixedwing_metrics_subscriptions.set(callback);
+}
+
+Telemetry::FixedwingMetricsHandle TelemetryImpl::subscribe_fixedwing_metrics(
+    const Telemetry::FixedwingMetricsCallback& callback, QueuePolicy queue_policy)
+{
+    return _fixedwing_metrics_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_fixedwing_metrics(Telemetry::FixedwingMetricsHandle handle)
+{
+    _fixedwing_metrics_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::ground_truth_async(Telemetry::GroundTruthCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _ground_truth_subscription = callback;
+    _ground_truth_subscriptions.set(callback);
+}
+
+Telemetry::GroundTruthHandle TelemetryImpl::subscribe_ground_truth(
+    const Telemetry::GroundTruthCallback& callback, QueuePolicy queue_policy)
+{
+    return _ground_truth_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_ground_truth(Telemetry::GroundTruthHandle handle)
+{
+    _ground_truth_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::camera_attitude_quaternion_async(
     Telemetry::AttitudeQuaternionCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _camera_attitude_quaternion_subscription = callback;
+    _camera_attitude_quaternion_subscriptions.set(callback);
+}
+
+Telemetry::CameraAttitudeQuaternionHandle TelemetryImpl::subscribe_camera_attitude_quaternion(
+    const Telemetry::AttitudeQuaternionCallback& callback, QueuePolicy queue_policy)
+{
+    return _camera_attitude_quaternion_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_camera_attitude_quaternion(
+    Telemetry::CameraAttitudeQuaternionHandle handle)
+{
+    _camera_attitude_quaternion_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::camera_attitude_euler_async(Telemetry::AttitudeEulerCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _camera_attitude_euler_angle_subscription = callback;
+    _camera_attitude_euler_subscriptions.set(callback);
+}
+
+Telemetry::CameraAttitudeEulerHandle TelemetryImpl::subscribe_camera_attitude_euler(
+    const Telemetry::AttitudeEulerCallback& callback, QueuePolicy queue_policy)
+{
+    return _camera_attitude_euler_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_camera_attitude_euler(Telemetry::CameraAttitudeEulerHandle handle)
+{
+    _camera_attitude_euler_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::velocity_ned_async(Telemetry::VelocityNedCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _velocity_ned_subscription = callback;
+    _velocity_ned_subscriptions.set(callback);
+}
+
+Telemetry::VelocityNedHandle TelemetryImpl::subscribe_velocity_ned(
+    const Telemetry::VelocityNedCallback& callback, QueuePolicy queue_policy)
+{
+    return _velocity_ned_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_velocity_ned(Telemetry::VelocityNedHandle handle)
+{
+    _velocity_ned_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::imu_async(Telemetry::ImuCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _imu_reading_ned_subscription = callback;
+    _imu_subscriptions.set(callback);
+}
+
+Telemetry::ImuHandle TelemetryImpl::subscribe_imu(
+    const Telemetry::ImuCallback& callback, QueuePolicy queue_policy)
+{
+    return _imu_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_imu(Telemetry::ImuHandle handle)
+{
+    _imu_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::gps_info_async(Telemetry::GpsInfoCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _gps_info_subscription = callback;
+    _gps_info_subscriptions.set(callback);
+}
+
+Telemetry::GpsInfoHandle TelemetryImpl::subscribe_gps_info(
+    const Telemetry::GpsInfoCallback& callback, QueuePolicy queue_policy)
+{
+    return _gps_info_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_gps_info(Telemetry::GpsInfoHandle handle)
+{
+    _gps_info_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::battery_async(Telemetry::BatteryCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _battery_subscription = callback;
+    _battery_subscriptions.set(callback);
+}
+
+Telemetry::BatteryHandle TelemetryImpl::subscribe_battery(
+    const Telemetry::BatteryCallback& callback, QueuePolicy queue_policy)
+{
+    return _battery_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_battery(Telemetry::BatteryHandle handle)
+{
+    _battery_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::flight_mode_async(Telemetry::FlightModeCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _flight_mode_subscription = callback;
+    _flight_mode_subscriptions.set(callback);
+}
+
+Telemetry::FlightModeHandle TelemetryImpl::subscribe_flight_mode(
+    const Telemetry::FlightModeCallback& callback, QueuePolicy queue_policy)
+{
+    return _flight_mode_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_flight_mode(Telemetry::FlightModeHandle handle)
+{
+    _flight_mode_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::health_async(Telemetry::HealthCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _health_subscription = callback;
+    _health_subscriptions.set(callback);
+}
+
+Telemetry::HealthHandle TelemetryImpl::subscribe_health(
+    const Telemetry::HealthCallback& callback, QueuePolicy queue_policy)
+{
+    return _health_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_health(Telemetry::HealthHandle handle)
+{
+    _health_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::health_all_ok_async(Telemetry::HealthAllOkCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _health_all_ok_subscription = callback;
+    _health_all_ok_subscriptions.set(callback);
+}
+
+Telemetry::HealthAllOkHandle TelemetryImpl::subscribe_health_all_ok(
+    const Telemetry::HealthAllOkCallback& callback, QueuePolicy queue_policy)
+{
+    return _health_all_ok_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_health_all_ok(Telemetry::HealthAllOkHandle handle)
+{
+    _health_all_ok_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::landed_state_async(Telemetry::LandedStateCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _landed_state_subscription = callback;
+    _landed_state_subscriptions.set(callback);
+}
+
+Telemetry::LandedStateHandle TelemetryImpl::subscribe_landed_state(
+    const Telemetry::LandedStateCallback& callback, QueuePolicy queue_policy)
+{
+    return _landed_state_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_landed_state(Telemetry::LandedStateHandle handle)
+{
+    _landed_state_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::rc_status_async(Telemetry::RcStatusCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _rc_status_subscription = callback;
+    _rc_status_subscriptions.set(callback);
+}
+
+Telemetry::RcStatusHandle TelemetryImpl::subscribe_rc_status(
+    const Telemetry::RcStatusCallback& callback, QueuePolicy queue_policy)
+{
+    return _rc_status_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_rc_status(Telemetry::RcStatusHandle handle)
+{
+    _rc_status_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::unix_epoch_time_async(Telemetry::UnixEpochTimeCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _unix_epoch_time_subscription = callback;
+    _unix_epoch_time_subscriptions.set(callback);
+}
+
+Telemetry::UnixEpochTimeHandle TelemetryImpl::subscribe_unix_epoch_time(
+    const Telemetry::UnixEpochTimeCallback& callback, QueuePolicy queue_policy)
+{
+    return _unix_epoch_time_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_unix_epoch_time(Telemetry::UnixEpochTimeHandle handle)
+{
+    _unix_epoch_time_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::actuator_control_target_async(
     Telemetry::ActuatorControlTargetCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _actuator_control_target_subscription = callback;
+    _actuator_control_target_subscriptions.set(callback);
+}
+
+Telemetry::ActuatorControlTargetHandle TelemetryImpl::subscribe_actuator_control_target(
+    const Telemetry::ActuatorControlTargetCallback& callback, QueuePolicy queue_policy)
+{
+    return _actuator_control_target_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_actuator_control_target(
+    Telemetry::ActuatorControlTargetHandle handle)
+{
+    _actuator_control_target_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::actuator_output_status_async(Telemetry::ActuatorOutputStatusCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _actuator_output_status_subscription = callback;
+    _actuator_output_status_subscriptions.set(callback);
+}
+
+Telemetry::ActuatorOutputStatusHandle TelemetryImpl::subscribe_actuator_output_status(
+    const Telemetry::ActuatorOutputStatusCallback& callback, QueuePolicy queue_policy)
+{
+    return _actuator_output_status_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_actuator_output_status(Telemetry::ActuatorOutputStatusHandle handle)
+{
+    _actuator_output_status_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::odometry_async(Telemetry::OdometryCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _odometry_subscription = callback;
+    _odometry_subscriptions.set(callback);
+}
+
+Telemetry::OdometryHandle TelemetryImpl::subscribe_odometry(
+    const Telemetry::OdometryCallback& callback, QueuePolicy queue_policy)
+{
+    return _odometry_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_odometry(Telemetry::OdometryHandle handle)
+{
+    _odometry_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::distance_sensor_async(Telemetry::DistanceSensorCallback& callback)
 {
-    std::lock_guard<std::mutex> lock(_subscription_mutex);
-    _distance_sensor_subscription = callback;
+    _distance_sensor_subscriptions.set(callback);
+}
+
+Telemetry::DistanceSensorHandle TelemetryImpl::subscribe_distance_sensor(
+    const Telemetry::DistanceSensorCallback& callback, QueuePolicy queue_policy)
+{
+    return _distance_sensor_subscriptions.subscribe(callback, queue_policy);
+}
+
+void TelemetryImpl::unsubscribe_distance_sensor(Telemetry::DistanceSensorHandle handle)
+{
+    _distance_sensor_subscriptions.unsubscribe(handle);
 }
 
 void TelemetryImpl::get_gps_global_origin_async(
@@ -4,8 +4,12 @@
 #include <mutex>
 
 #include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry/telemetry_extension.h"
+#include "callback_list.h"
+#include "lazy_message.h"
 #include "mavlink_include.h"
 #include "plugin_impl_base.h"
+#include "seqlock.h"
 #include "system.h"
 
 // Since not all vehicles support/require level calibration, this
@@ -46,6 +50,7 @@ public:
     Telemetry::Result set_rate_actuator_output_status(double rate_hz);
     Telemetry::Result set_rate_odometry(double rate_hz);
     Telemetry::Result set_rate_distance_sensor(double rate_hz);
+    Telemetry::Result set_rates(const TelemetryExtension::Rates& rates);
     Telemetry::Result set_rate_unix_epoch_time(double rate_hz);
 
     void set_rate_position_velocity_ned_async(double rate_hz, Telemetry::ResultCallback callback);
@@ -66,6 +71,8 @@ public:
     void set_rate_actuator_output_status_async(double rate_hz, Telemetry::ResultCallback callback);
     void set_rate_odometry_async(double rate_hz, Telemetry::ResultCallback callback);
     void set_rate_distance_sensor_async(double rate_hz, Telemetry::ResultCallback callback);
+    void set_rates_async(
+        const TelemetryExtension::Rates& rates, Telemetry::ResultCallback callback);
     void set_rate_unix_epoch_time_async(double rate_hz, Telemetry::ResultCallback callback);
 
     void get_gps_global_origin_async(const Telemetry::GetGpsGlobalOriginCallback callback);
@@ -98,6 +105,7 @@ public:
     Telemetry::Odometry odometry() const;
     Telemetry::DistanceSensor distance_sensor() const;
     uint64_t unix_epoch_time() const;
+    TelemetryExtension::Snapshot snapshot() const;
 
     void position_velocity_ned_async(Telemetry::PositionVelocityNedCallback& callback);
     void position_async(Telemetry::PositionCallback& callback);
@@ -128,6 +136,89 @@ public:
     void odometry_async(Telemetry::OdometryCallback& callback);
     void distance_sensor_async(Telemetry::DistanceSensorCallback& callback);
 
+    Telemetry::PositionVelocityNedHandle subscribe_position_velocity_ned(
+        const Telemetry::PositionVelocityNedCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_position_velocity_ned(Telemetry::PositionVelocityNedHandle handle);
+    Telemetry::PositionHandle subscribe_position(
+        const Telemetry::PositionCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_position(Telemetry::PositionHandle handle);
+    Telemetry::HomeHandle subscribe_home(
+        const Telemetry::PositionCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_home(Telemetry::HomeHandle handle);
+    Telemetry::InAirHandle subscribe_in_air(
+        const Telemetry::InAirCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_in_air(Telemetry::InAirHandle handle);
+    Telemetry::StatusTextHandle subscribe_status_text(
+        const Telemetry::StatusTextCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_status_text(Telemetry::StatusTextHandle handle);
+    Telemetry::ArmedHandle subscribe_armed(
+        const Telemetry::ArmedCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_armed(Telemetry::ArmedHandle handle);
+    Telemetry::AttitudeQuaternionHandle subscribe_attitude_quaternion(
+        const Telemetry::AttitudeQuaternionCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_attitude_quaternion(Telemetry::AttitudeQuaternionHandle handle);
+    Telemetry::AttitudeEulerHandle subscribe_attitude_euler(
+        const Telemetry::AttitudeEulerCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_attitude_euler(Telemetry::AttitudeEulerHandle handle);
+    Telemetry::AttitudeAngularVelocityBodyHandle subscribe_attitude_angular_velocity_body(
+        const Telemetry::AttitudeAngularVelocityBodyCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_attitude_angular_velocity_body(
+        Telemetry::AttitudeAngularVelocityBodyHandle handle);
+    Telemetry::FixedwingMetricsHandle subscribe_fixedwing_metrics(
+        const Telemetry::FixedwingMetricsCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_fixedwing_metrics(Telemetry::FixedwingMetricsHandle handle);
+    Telemetry::GroundTruthHandle subscribe_ground_truth(
+        const Telemetry::GroundTruthCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_ground_truth(Telemetry::GroundTruthHandle handle);
+    Telemetry::CameraAttitudeQuaternionHandle subscribe_camera_attitude_quaternion(
+        const Telemetry::AttitudeQuaternionCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_camera_attitude_quaternion(Telemetry::CameraAttitudeQuaternionHandle handle);
+    Telemetry::CameraAttitudeEulerHandle subscribe_camera_attitude_euler(
+        const Telemetry::AttitudeEulerCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_camera_attitude_euler(Telemetry::CameraAttitudeEulerHandle handle);
+    Telemetry::VelocityNedHandle subscribe_velocity_ned(
+        const Telemetry::VelocityNedCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_velocity_ned(Telemetry::VelocityNedHandle handle);
+    Telemetry::ImuHandle subscribe_imu(
+        const Telemetry::ImuCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_imu(Telemetry::ImuHandle handle);
+    Telemetry::GpsInfoHandle subscribe_gps_info(
+        const Telemetry::GpsInfoCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_gps_info(Telemetry::GpsInfoHandle handle);
+    Telemetry::BatteryHandle subscribe_battery(
+        const Telemetry::BatteryCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_battery(Telemetry::BatteryHandle handle);
+    Telemetry::FlightModeHandle subscribe_flight_mode(
+        const Telemetry::FlightModeCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_flight_mode(Telemetry::FlightModeHandle handle);
+    Telemetry::HealthHandle subscribe_health(
+        const Telemetry::HealthCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_health(Telemetry::HealthHandle handle);
+    Telemetry::HealthAllOkHandle subscribe_health_all_ok(
+        const Telemetry::HealthAllOkCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_health_all_ok(Telemetry::HealthAllOkHandle handle);
+    Telemetry::LandedStateHandle subscribe_landed_state(
+        const Telemetry::LandedStateCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_landed_state(Telemetry::LandedStateHandle handle);
+    Telemetry::RcStatusHandle subscribe_rc_status(
+        const Telemetry::RcStatusCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_rc_status(Telemetry::RcStatusHandle handle);
+    Telemetry::UnixEpochTimeHandle subscribe_unix_epoch_time(
+        const Telemetry::UnixEpochTimeCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_unix_epoch_time(Telemetry::UnixEpochTimeHandle handle);
+    Telemetry::ActuatorControlTargetHandle subscribe_actuator_control_target(
+        const Telemetry::ActuatorControlTargetCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_actuator_control_target(Telemetry::ActuatorControlTargetHandle handle);
+    Telemetry::ActuatorOutputStatusHandle subscribe_actuator_output_status(
+        const Telemetry::ActuatorOutputStatusCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_actuator_output_status(Telemetry::ActuatorOutputStatusHandle handle);
+    Telemetry::OdometryHandle subscribe_odometry(
+        const Telemetry::OdometryCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_odometry(Telemetry::OdometryHandle handle);
+    Telemetry::DistanceSensorHandle subscribe_distance_sensor(
+        const Telemetry::DistanceSensorCallback& callback, QueuePolicy queue_policy);
+    void unsubscribe_distance_sensor(Telemetry::DistanceSensorHandle handle);
+
     TelemetryImpl(const TelemetryImpl&) = delete;
     TelemetryImpl& operator=(const TelemetryImpl&) = delete;
 
@@ -157,9 +248,9 @@ private:
     void set_health_level_calibration(bool ok);
     void set_rc_status(bool available, float signal_strength_percent);
     void set_unix_epoch_time_us(uint64_t time_us);
-    void set_actuator_control_target(uint8_t group, const std::vector<float>& controls);
-    void set_actuator_output_status(uint32_t active, const std::vector<float>& actuators);
-    void set_odometry(Telemetry::Odometry& odometry);
+    void set_actuator_control_target(const Telemetry::ActuatorControlTarget& target);
+    void set_actuator_output_status(const Telemetry::ActuatorOutputStatus& status);
+    void set_odometry(const Telemetry::Odometry& odometry);
     void set_distance_sensor(Telemetry::DistanceSensor& distance_sensor);
 
     void process_position_velocity_ned(const mavlink_message_t& message);
@@ -183,6 +274,17 @@ private:
     void process_actuator_output_status(const mavlink_message_t& message);
     void process_odometry(const mavlink_message_t& message);
     void process_distance_sensor(const mavlink_message_t& message);
+
+    void decode_imu(const mavlink_message_t& message);
+    void decode_gps_info(const mavlink_message_t& message);
+    void decode_ground_truth(const mavlink_message_t& message);
+    void decode_fixedwing_metrics(const mavlink_message_t& message);
+    void decode_battery(const mavlink_message_t& message);
+    void decode_actuator_control_target(const mavlink_message_t& message);
+    void decode_actuator_output_status(const mavlink_message_t& message);
+    void decode_odometry(const mavlink_message_t& message);
+    void decode_distance_sensor(const mavlink_message_t& message);
+
     void receive_param_cal_gyro(MAVLinkParameters::Result result, int value);
     void receive_param_cal_accel(MAVLinkParameters::Result result, int value);
     void receive_param_cal_mag(MAVLinkParameters::Result result, int value);
@@ -203,112 +305,77 @@ private:
     static void command_result_callback(
         MavlinkCommandSender::Result command_result, const Telemetry::ResultCallback& callback);
 
+    std::vector<std::pair<uint16_t, double>> message_rates(const TelemetryExtension::Rates& rates);
+
     static Telemetry::LandedState to_landed_state(mavlink_extended_sys_state_t extended_sys_state);
 
     static Telemetry::FlightMode
     telemetry_flight_mode_from_flight_mode(SystemImpl::FlightMode flight_mode);
 
-    // Make all fields thread-safe using mutexs
-    // The mutexs are mutable so that the lock can get aqcuired in
-    // methods marked const.
-    mutable std::mutex _position_mutex{};
-    Telemetry::Position _position{};
-
-    mutable std::mutex _position_velocity_ned_mutex{};
-    Telemetry::PositionVelocityNed _position_velocity_ned{};
+    // Everything which can be copied without locking is kept together, so that
+    // polling it doesn't hold up receiving, and so that it can be taken at once.
+    Seqlock<TelemetryExtension::Snapshot> _state{};
 
-    mutable std::mutex _home_position_mutex{};
-    Telemetry::Position _home_position{};
-
-    // If possible, just use atomic instead of a mutex.
-    std::atomic_bool _in_air{false};
-    std::atomic_bool _armed{false};
+    // Their variable-length fields are kept inline, so these can be copied without locking
+    // as well. They are just not part of the snapshot.
+    Seqlock<Telemetry::ActuatorControlTarget> _actuator_control_target{};
+    Seqlock<Telemetry::ActuatorOutputStatus> _actuator_output_status{};
+    Seqlock<Telemetry::Odometry> _odometry{};
 
+    // Make the remaining fields thread-safe using mutexs
+    // The mutexs are mutable so that the lock can get aqcuired in
+    // methods marked const.
     mutable std::mutex _status_text_mutex{};
     Telemetry::StatusText _status_text{};
 
-    mutable std::mutex _attitude_quaternion_mutex{};
-    Telemetry::Quaternion _attitude_quaternion{};
-
-    mutable std::mutex _camera_attitude_euler_angle_mutex{};
-    Telemetry::EulerAngle _camera_attitude_euler_angle{};
-
-    mutable std::mutex _attitude_angular_velocity_body_mutex{};
-    Telemetry::AngularVelocityBody _attitude_angular_velocity_body{};
-
-    mutable std::mutex _ground_truth_mutex{};
-    Telemetry::GroundTruth _ground_truth{};
-
-    mutable std::mutex _fixedwing_metrics_mutex{};
-    Telemetry::FixedwingMetrics _fixedwing_metrics{};
-
-    mutable std::mutex _velocity_ned_mutex{};
-    Telemetry::VelocityNed _velocity_ned{};
-
-    mutable std::mutex _imu_reading_ned_mutex{};
-    Telemetry::Imu _imu_reading_ned{};
-
-    mutable std::mutex _gps_info_mutex{};
-    Telemetry::GpsInfo _gps_info{};
-
-    mutable std::mutex _battery_mutex{};
-    Telemetry::Battery _battery{};
-
-    mutable std::mutex _health_mutex{};
-    Telemetry::Health _health{};
-
-    mutable std::mutex _landed_state_mutex{};
-    Telemetry::LandedState _landed_state{Telemetry::LandedState::Unknown};
-
-    mutable std::mutex _rc_status_mutex{};
-    Telemetry::RcStatus _rc_status{};
-
-    mutable std::mutex _unix_epoch_time_mutex{};
-    uint64_t _unix_epoch_time_us{};
-
-    mutable std::mutex _actuator_control_target_mutex{};
-    Telemetry::ActuatorControlTarget _actuator_control_target{};
-
-    mutable std::mutex _actuator_output_status_mutex{};
-    Telemetry::ActuatorOutputStatus _actuator_output_status{};
-
-    mutable std::mutex _odometry_mutex{};
-    Telemetry::Odometry _odometry{};
-
-    mutable std::mutex _distance_sensor_mutex{};
-    Telemetry::DistanceSensor _distance_sensor{};
-
     std::atomic<bool> _hitl_enabled{false};
 
-    std::mutex _subscription_mutex{};
-    Telemetry::PositionVelocityNedCallback _position_velocity_ned_subscription{nullptr};
-    Telemetry::PositionCallback _position_subscription{nullptr};
-    Telemetry::PositionCallback _home_position_subscription{nullptr};
-    Telemetry::InAirCallback _in_air_subscription{nullptr};
-    Telemetry::StatusTextCallback _status_text_subscription{nullptr};
-    Telemetry::ArmedCallback _armed_subscription{nullptr};
-    Telemetry::AttitudeQuaternionCallback _attitude_quaternion_angle_subscription{nullptr};
-    Telemetry::AttitudeAngularVelocityBodyCallback _attitude_angular_velocity_body_subscription{
-        nullptr};
-    Telemetry::GroundTruthCallback _ground_truth_subscription{nullptr};
-    Telemetry::FixedwingMetricsCallback _fixedwing_metrics_subscription{nullptr};
-    Telemetry::AttitudeEulerCallback _attitude_euler_angle_subscription{nullptr};
-    Telemetry::AttitudeQuaternionCallback _camera_attitude_quaternion_subscription{nullptr};
-    Telemetry::AttitudeEulerCallback _camera_attitude_euler_angle_subscription{nullptr};
-    Telemetry::VelocityNedCallback _velocity_ned_subscription{nullptr};
-    Telemetry::ImuCallback _imu_reading_ned_subscription{nullptr};
-    Telemetry::GpsInfoCallback _gps_info_subscription{nullptr};
-    Telemetry::BatteryCallback _battery_subscription{nullptr};
-    Telemetry::FlightModeCallback _flight_mode_subscription{nullptr};
-    Telemetry::HealthCallback _health_subscription{nullptr};
-    Telemetry::HealthAllOkCallback _health_all_ok_subscription{nullptr};
-    Telemetry::LandedStateCallback _landed_state_subscription{nullptr};
-    Telemetry::RcStatusCallback _rc_status_subscription{nullptr};
-    Telemetry::UnixEpochTimeCallback _unix_epoch_time_subscription{nullptr};
-    Telemetry::ActuatorControlTargetCallback _actuator_control_target_subscription{nullptr};
-    Telemetry::ActuatorOutputStatusCallback _actuator_output_status_subscription{nullptr};
-    Telemetry::OdometryCallback _odometry_subscription{nullptr};
-    Telemetry::DistanceSensorCallback _distance_sensor_subscription{nullptr};
+    // Messages which nobody is subscribed to are only decoded once their values are asked for.
+    LazyMessage _imu_message{[this](const mavlink_message_t& message) { decode_imu(message); }};
+    LazyMessage _gps_info_message{
+        [this](const mavlink_message_t& message) { decode_gps_info(message); }};
+    LazyMessage _ground_truth_message{
+        [this](const mavlink_message_t& message) { decode_ground_truth(message); }};
+    LazyMessage _fixedwing_metrics_message{
+        [this](const mavlink_message_t& message) { decode_fixedwing_metrics(message); }};
+    LazyMessage _battery_message{
+        [this](const mavlink_message_t& message) { decode_battery(message); }};
+    LazyMessage _actuator_control_target_message{
+        [this](const mavlink_message_t& message) { decode_actuator_control_target(message); }};
+    LazyMessage _actuator_output_status_message{
+        [this](const mavlink_message_t& message) { decode_actuator_output_status(message); }};
+    LazyMessage _odometry_message{
+        [this](const mavlink_message_t& message) { decode_odometry(message); }};
+    LazyMessage _distance_sensor_message{
+        [this](const mavlink_message_t& message) { decode_distance_sensor(message); }};
+
+    CallbackList<Telemetry::PositionVelocityNed> _position_velocity_ned_subscriptions{};
+    CallbackList<Telemetry::Position> _position_subscriptions{};
+    CallbackList<Telemetry::Position> _home_subscriptions{};
+    CallbackList<bool> _in_air_subscriptions{};
+    CallbackList<Telemetry::StatusText> _status_text_subscriptions{};
+    CallbackList<bool> _armed_subscriptions{};
+    CallbackList<Telemetry::Quaternion> _attitude_quaternion_subscriptions{};
+    CallbackList<Telemetry::EulerAngle> _attitude_euler_subscriptions{};
+    CallbackList<Telemetry::AngularVelocityBody> _attitude_angular_velocity_body_subscriptions{};
+    CallbackList<Telemetry::FixedwingMetrics> _fixedwing_metrics_subscriptions{};
+    CallbackList<Telemetry::GroundTruth> _ground_truth_subscriptions{};
+    CallbackList<Telemetry::Quaternion> _camera_attitude_quaternion_subscriptions{};
+    CallbackList<Telemetry::EulerAngle> _camera_attitude_euler_subscriptions{};
+    CallbackList<Telemetry::VelocityNed> _velocity_ned_subscriptions{};
+    CallbackList<Telemetry::Imu> _imu_subscriptions{};
+    CallbackList<Telemetry::GpsInfo> _gps_info_subscriptions{};
+    CallbackList<Telemetry::Battery> _battery_subscriptions{};
+    CallbackList<Telemetry::FlightMode> _flight_mode_subscriptions{};
+    CallbackList<Telemetry::Health> _health_subscriptions{};
+    CallbackList<bool> _health_all_ok_subscriptions{};
+    CallbackList<Telemetry::LandedState> _landed_state_subscriptions{};
+    CallbackList<Telemetry::RcStatus> _rc_status_subscriptions{};
+    CallbackList<uint64_t> _unix_epoch_time_subscriptions{};
+    CallbackList<Telemetry::ActuatorControlTarget> _actuator_control_target_subscriptions{};
+    CallbackList<Telemetry::ActuatorOutputStatus> _actuator_output_status_subscriptions{};
+    CallbackList<Telemetry::Odometry> _odometry_subscriptions{};
+    CallbackList<Telemetry::DistanceSensor> _distance_sensor_subscriptions{};
 
     // The velocity (former ground speed) and position are coupled to the same message, therefore,
     // we just use the faster between the two.
@@ -0,0 +1,170 @@
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <gtest/gtest.h>
+
+#include "mavsdk.h"
+#include "mocks/fake_autopilot.h"
+#include "plugins/telemetry/telemetry.h"
+#include "plugins/telemetry/telemetry_extension.h"
+
+using namespace mavsdk;
+using namespace mavsdk::testing;
+
+namespace {
+
+// How often SET_MESSAGE_INTERVAL arrived for each message, counting the current one.
+struct Requests {
+    std::mutex mutex{};
+    std::map<uint16_t, unsigned> count{};
+
+    unsigned add(const mavlink_message_t& command_long)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ++count[static_cast<uint16_t>(mavlink_msg_command_long_get_param1(&command_long))];
+    }
+
+    unsigned of(uint16_t message_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count[message_id];
+    }
+};
+
+bool is_set_message_interval(const mavlink_message_t& command_long)
+{
+    return mavlink_msg_command_long_get_command(&command_long) == MAV_CMD_SET_MESSAGE_INTERVAL;
+}
+
+void ack(
+    FakeAutopilot& autopilot,
+    const mavlink_message_t& command_long,
+    MAV_RESULT result,
+    std::chrono::milliseconds delay = {})
+{
+    autopilot.send(
+        FakeAutopilot::command_ack(command_long, MAV_COMP_ID_AUTOPILOT1, result), delay);
+}
+
+} // namespace
+
+TEST(TelemetryRates, KeepsDenialWhenBatchIsSentAgain)
+{
+    FakeAutopilot autopilot;
+    Mavsdk mavsdk;
+    auto system = autopilot.connect(mavsdk);
+    ASSERT_TRUE(system);
+
+    // The ack for the IMU is lost the first time, so the whole batch is sent again. The
+    // battery is denied the first time only, which mustn't be forgotten by then.
+    auto requests = std::make_shared<Requests>();
+    autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG, [&autopilot, requests](const mavlink_message_t& message) {
+            if (!is_set_message_interval(message)) {
+                return;
+            }
+            const auto message_id =
+                static_cast<uint16_t>(mavlink_msg_command_long_get_param1(&message));
+            const auto times = requests->add(message);
+            if (message_id == MAVLINK_MSG_ID_HIGHRES_IMU && times == 1) {
+                return;
+            }
+            const bool denied = message_id == MAVLINK_MSG_ID_SYS_STATUS && times == 1;
+            ack(autopilot, message, denied ? MAV_RESULT_DENIED : MAV_RESULT_ACCEPTED);
+        });
+
+    Telemetry telemetry(system);
+    TelemetryExtension::Rates rates;
+    rates.attitude_hz = 10.0;
+    rates.imu_hz = 20.0;
+    rates.battery_hz = 1.0;
+
+    EXPECT_EQ(TelemetryExtension(telemetry).set_rates(rates), Telemetry::Result::CommandDenied);
+    EXPECT_EQ(requests->of(MAVLINK_MSG_ID_HIGHRES_IMU), 2u);
+}
+
+TEST(TelemetryRates, DiscountsAcksOfCommandsSentAgain)
+{
+    FakeAutopilot autopilot;
+    Mavsdk mavsdk;
+    auto system = autopilot.connect(mavsdk);
+    ASSERT_TRUE(system);
+
+    // The ack for the IMU is lost the first time and it is denied the second time. The
+    // attitude and battery get acked once more in between, which mustn't complete the batch.
+    auto requests = std::make_shared<Requests>();
+    autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG, [&autopilot, requests](const mavlink_message_t& message) {
+            if (!is_set_message_interval(message)) {
+                return;
+            }
+            const auto message_id =
+                static_cast<uint16_t>(mavlink_msg_command_long_get_param1(&message));
+            const auto times = requests->add(message);
+            if (message_id != MAVLINK_MSG_ID_HIGHRES_IMU) {
+                ack(autopilot, message, MAV_RESULT_ACCEPTED);
+            } else if (times == 2) {
+                ack(autopilot, message, MAV_RESULT_DENIED);
+            }
+        });
+
+    Telemetry telemetry(system);
+    TelemetryExtension::Rates rates;
+    rates.attitude_hz = 10.0;
+    rates.imu_hz = 20.0;
+    rates.battery_hz = 1.0;
+
+    EXPECT_EQ(TelemetryExtension(telemetry).set_rates(rates), Telemetry::Result::CommandDenied);
+    EXPECT_EQ(requests->of(MAVLINK_MSG_ID_HIGHRES_IMU), 2u);
+}
+
+TEST(TelemetryRates, TakesOneRoundTripForAllRates)
+{
+    FakeAutopilot autopilot;
+    Mavsdk mavsdk;
+    auto system = autopilot.connect(mavsdk);
+    ASSERT_TRUE(system);
+
+    // Every ack takes as long, so setting the rates one after the other would take
+    // that long for each of them. It stays below the shortest timeout there is.
+    const auto delay = std::chrono::milliseconds(30);
+    auto requests = std::make_shared<Requests>();
+    autopilot.subscribe_message(
+        MAVLINK_MSG_ID_COMMAND_LONG,
+        [&autopilot, requests, delay](const mavlink_message_t& message) {
+            if (is_set_message_interval(message)) {
+                requests->add(message);
+                ack(autopilot, message, MAV_RESULT_ACCEPTED, delay);
+            }
+        });
+
+    Telemetry telemetry(system);
+    TelemetryExtension::Rates rates;
+    rates.position_velocity_ned_hz = 10.0;
+    rates.position_hz = 10.0;
+    rates.home_hz = 1.0;
+    rates.landed_state_hz = 1.0;
+    rates.attitude_hz = 10.0;
+    rates.imu_hz = 20.0;
+    rates.gps_info_hz = 1.0;
+    rates.battery_hz = 1.0;
+    rates.rc_status_hz = 1.0;
+    rates.odometry_hz = 10.0;
+    const unsigned streams = 10;
+
+    const auto started = std::chrono::steady_clock::now();
+    EXPECT_EQ(TelemetryExtension(telemetry).set_rates(rates), Telemetry::Result::Success);
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    std::lock_guard<std::mutex> lock(requests->mutex);
+    unsigned requested = 0;
+    for (const auto& count : requests->count) {
+        EXPECT_EQ(count.second, 1u);
+        requested += count.second;
+    }
+    EXPECT_EQ(requested, streams);
+    EXPECT_GE(elapsed, delay);
+    EXPECT_LT(elapsed, streams * delay / 2);
+}